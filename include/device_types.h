@@ -4,7 +4,10 @@
 
 
 enum HARDWARE_DEVICE_TYPE {
-    IMU
+    IMU,
+    ENERGY,
+    ENVIRONMENT,
+    ANALOG_MUX
 };
 
-#endif
\ No newline at end of file
+#endif
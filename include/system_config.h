@@ -25,15 +25,15 @@ namespace overseer{
                 struct DISPLAY_CONFIG
                 {
                     //uint16_t const model = ST7796S;
-                    uint8_t const TFT_MISO = 50;
-                    uint8_t const TFT_MOSI = 51;
-                    uint8_t const TFT_SCLK = 52;
+                    static constexpr uint8_t TFT_MISO = 50;
+                    static constexpr uint8_t TFT_MOSI = 51;
+                    static constexpr uint8_t TFT_SCLK = 52;
 
-                    uint8_t const TFT_CS = A5;
-                    uint8_t const TFT_DC = A3;
-                    uint8_t const TFT_RST = A4;
+                    static constexpr uint8_t TFT_CS = A5;
+                    static constexpr uint8_t TFT_DC = A3;
+                    static constexpr uint8_t TFT_RST = A4;
 
-                    uint8_t const TFT_LED = -1;                            
+                    static constexpr uint8_t TFT_LED = -1;                            
                 };            
                 DISPLAY_CONFIG display_config;
             };        
@@ -45,9 +45,9 @@ namespace overseer{
                 unsigned long update_interval = 500;
                 unsigned long last_update_time = 0;
                 MPU6000* mpu = nullptr;   
-                struct PINS {
-                    uint8_t sda = 1; 
-                    uint8_t scl = 2;            
+                struct PINS {                   // board wiring, compile-time constants
+                    static constexpr uint8_t sda = 1;
+                    static constexpr uint8_t scl = 2;
                 };
                 struct FILTER_CONFIG {
                     float smoothing_alpha = 0.1f;           // EMA alpha
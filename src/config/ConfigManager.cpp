@@ -1,4 +1,5 @@
 #include <config/ConfigManager.h>
+#include <device/report/FastFormat.h>
 namespace config {
 ConfigManager::ConfigManager(fs::FS &fs, const String &filePath)
     : _fs(fs), _filePath(filePath) {
@@ -125,7 +126,9 @@ bool ConfigManager::setBool(const char* section, const char* key, bool value) {
 }
 
 bool ConfigManager::setFloat(const char* section, const char* key, float value) {
-    _ini.SetValue(section, key, String(value, 6).c_str());
+    char text[32];
+    overseer::device::report::format::formatFloat(text, sizeof(text), value, 6);
+    _ini.SetValue(section, key, text);
     return save();
 }
 
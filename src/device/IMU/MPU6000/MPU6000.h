@@ -3,7 +3,16 @@
 #include <math.h>
 #include <Arduino.h>
 #include <ArduinoLog.h>
+#include <device_types.h>
+#include <config/ConfigManager.h>
 #include "MPUData.h"
+#include "MPUFusion.h"
+#include "MPUVibration.h"
+#include "device/report/ChangePublisher.h"
+#include "device/report/FastFormat.h"
+#include "device/bus/I2CBus.h"
+#include "device/capture/TriggerCapture.h"
+#include "device/stats/WindowMax.h"
 
 #ifdef ARDUINO
 
@@ -14,7 +23,6 @@
 
 #endif
 
-#include <deque>
 #include <map>
 #include <vector>
 #include <algorithm>
@@ -26,13 +34,27 @@ namespace overseer::device::imu {
         private:
             bool initialized = false;
             MPU6050 mpu;
+            uint8_t sda_pin;
+            uint8_t scl_pin;
+
+            // Shared bus (optional): motion reads go through it as one 14-byte burst,
+            // I2Cdev calls run under its Lock
+            static constexpr uint8_t I2C_ADDRESS = 0x68;
+            static constexpr uint8_t REG_ACCEL_XOUT_H = 0x3B;   // accel, temp, gyro: 14 bytes
+            bus::I2CBus* i2c_bus = nullptr;
+            uint8_t i2c_client = 0xFF;
+            bool readMotion(int16_t* ax, int16_t* ay, int16_t* az, int16_t* gx, int16_t* gy, int16_t* gz);
             MPUData _data;            
             void configureHardware();  // Wire, I2C, etc.
-            std::deque<std::pair<unsigned long, float>> gx_history;
-            std::deque<std::pair<unsigned long, float>> gy_history;
-            std::deque<std::pair<unsigned long, float>> gz_history;
-            //Comment, maybe... attempt to limit the size.            
-            const std::vector<unsigned long> g_windows = {1, 5, 10, 15, 30, 45, 60, 300, 600, 900, 1800}; // Declare historical windows (in seconds).
+            bool testConnection();     // one WHO_AM_I read under the bus Lock
+            // Windowed max of |G| per axis (channels x, y, z); engine, labels and map
+            // entries are built for the configured set only ([mpu6000] windows=1,10,60)
+            std::vector<unsigned long> g_windows = {1, 5, 10, 15, 30, 45, 60, 300, 600, 900, 1800}; // seconds
+            std::vector<String> g_window_labels;     // "1s", "5s", ...
+            stats::WindowMax g_window_max;
+            void configureWindows();
+            ::config::ConfigManager* config = nullptr;
+            const char* config_section = "mpu6000";
 
             // Internal helpers to track max values
             void updateMax(float &max_val, float &dir_val, float new_val);            
@@ -43,18 +65,73 @@ namespace overseer::device::imu {
 
             float samples_per_second = 0.0f;
 
+            // Scale factors matching configureHardware() (ACCEL_FS_2, GYRO_FS_250)
+            static constexpr float ACCEL_LSB_PER_G = 16384.0f;
+            static constexpr float GYRO_LSB_PER_DPS = 131.0f;
+
+            // Attitude fusion (complementary or madgwick, see MPUFusion.h)
+            fusion::AttitudeFilter attitude;
+            unsigned long last_fusion_time_us = 0;
+
+            // Vibration spectrum from the accelerometer FIFO (see MPUVibration.h)
+            vibration::VibrationAnalyzer<MPU_VIBRATION_FFT_SIZE> vibration;
+            bool vibration_enabled = false;
+            void drainFifo();
+            void publishVibration();
+
+            // Optional windowed quantiles of |G| per axis; summaries refreshed at most once per second
+            stats::QuantileWindows g_quantiles[3];
+            bool quantiles_enabled = false;
+            bool quantiles_published = false;
+            unsigned long last_quantile_refresh_ms = 0;
+            void updateQuantiles(unsigned long now);
+
+            // Publish-on-change reporting (printMPUChanges)
+            report::ChangePublisher reporter;
+
+            // Optional pre/post-trigger capture of |G| (vector magnitude) per update
+            capture::TriggerCapture g_capture;
+
             // Configuration parameters for smoothing and spike rejection
             float smoothing_alpha = 0.1f;
             float spike_threshold = 0.3f;
         public:
+            static constexpr HARDWARE_DEVICE_TYPE DEVICE_TYPE = IMU;
+
             MPU6000(uint8_t sda_pin = 20, uint8_t scl_pin = 21);
             bool isInitialized();              //Getter
+            bool attachBus(bus::I2CBus& bus);  // before begin(); the bus then owns Wire setup
+            void attachConfig(::config::ConfigManager& cfg, const char* section = "mpu6000");   // read in begin()
+            bool setWindows(const std::vector<unsigned long>& windows_sec);
+            const std::vector<unsigned long>& getWindows() const { return g_windows; }
             bool begin();                      // Initialize hardware
             void update();                     // Update readings & max G windows
             void setData(const MPUData& newData);  // Inject external data (stub/testing)
-            MPUData getData() const;    // Retrieve current sensor data            
+            void setData(MPUData&& newData);
+            const MPUData& getData() const;        // Live view of current sensor data, valid until the next update()
+            const MPUSample& getSample() const { return _data; }     // hot values only, no maps to copy
+            template <typename Fn>
+            void visitData(Fn&& fn) const { visitFields(_data, fn); }
+            float getPitch() const { return _data.pitch_deg; }
+            float getRoll() const { return _data.roll_deg; }
+            float getYaw() const { return _data.yaw_deg; }
             void smoothAndFilterMPUData(MPUData& data);
             void printMPUData(const MPUData& data);
+            report::PublishResult printMPUChanges(unsigned long now);     // sparse record, keyframe on interval
+            report::ChangePublisher& getReporter() { return reporter; }
+            void setFusionGain(float gain);    // complementary: gyro weight, madgwick: beta
+            float getFusionGain() const;
+            void enableQuantiles(const std::vector<unsigned long>& tiers_sec = {60, 300, 1800});
+            void disableQuantiles();
+            const stats::QuantileWindows& getQuantiles(uint8_t axis) const { return g_quantiles[axis < 3 ? axis : 2]; }
+            bool enableCapture(const capture::TriggerConfig& trigger, uint16_t pre = 128, uint16_t post = 384, uint8_t slots = 2);
+            void disableCapture() { g_capture = capture::TriggerCapture(); }
+            void fireCapture() { g_capture.fire(); }
+            capture::TriggerCapture& getCapture() { return g_capture; }
+            bool enableVibrationAnalysis(const vibration::VibrationConfig& config = vibration::VibrationConfig());
+            void disableVibrationAnalysis();
+            bool isVibrationEnabled() const { return vibration_enabled; }
+            const vibration::VibrationSpectrum& getVibrationSpectrum() const { return vibration.getSpectrum(); }
             
     };
 
@@ -4,19 +4,58 @@ using namespace overseer::device::imu::data;
 
 namespace overseer::device::imu {
 
-    MPU6000::MPU6000(uint8_t sda_pin, uint8_t scl_pin) {}
+    static_assert(vibration::MAX_BANDS <= sizeof(MPUData::vibration_band_rms) / sizeof(float),
+                  "MPUData band array too small");
+    static_assert(vibration::MAX_PEAKS <= sizeof(MPUData::vibration_peak_hz) / sizeof(float),
+                  "MPUData peak array too small");
+
+    MPU6000::MPU6000(uint8_t sda_pin, uint8_t scl_pin) : sda_pin(sda_pin), scl_pin(scl_pin) {
+        configureWindows();
+
+        // Steady-state noise floor of the defaults (ACCEL_FS_2, GYRO_FS_250, alpha 0.1)
+        reporter.setDefaultDeadband(0.02f);             // G
+        static const char* const angles[] = {"pitch_deg", "roll_deg", "yaw_deg", "pitch_deg_smooth", "roll_deg_smooth"};
+        for (const char* name : angles) reporter.setDeadband(name, 0.5f);
+        static const char* const rates[] = {"rate_x_dps", "rate_y_dps", "rate_z_dps"};
+        for (const char* name : rates) reporter.setDeadband(name, 1.0f);
+        reporter.setDeadband("vibration_peak_hz", 2.0f);
+        reporter.setDeadband("samples_per_second", 5.0f);
+    }
+
+    bool MPU6000::attachBus(bus::I2CBus& bus) {
+        uint8_t client = bus.addClient("mpu6000", I2C_ADDRESS);
+        if (client == 0xFF) {
+            Log.warning("MPU6000: I2C bus has no free client slot, using Wire directly" CR);
+            return false;
+        }
+        i2c_bus = &bus;
+        i2c_client = client;
+        return true;
+    }
 
     bool MPU6000::begin() {
         Serial.println("MPU6000::INIT - Start");
-        Wire.begin();
+        if (!i2c_bus) {
+            Wire.begin(sda_pin, scl_pin);
+        }
+        if (config) {
+            stats::parseWindowList(config->getString(config_section, "windows", ""), g_windows);
+            // Reporting: [mpu6000] report_keyframe_s=60, report_deadband=0.02, deadband_<field>=...
+            report::loadConfig(reporter, *config, config_section, _data);
+        }
+        configureWindows();
         delay(300);
-        mpu.initialize();
-        //mpu.setFullScaleAccelRange(MPU6050_ACCEL_FS_2);  // or _4, _8, _16
-        //mpu.setFullScaleGyroRange(MPU6050_GYRO_FS_250);
-        configureHardware();
+        // Lock per transaction, never across the delays, so other bus clients keep running
+        {
+            bus::I2CBus::Lock lock(i2c_bus, i2c_client);
+            mpu.initialize();
+            //mpu.setFullScaleAccelRange(MPU6050_ACCEL_FS_2);  // or _4, _8, _16
+            //mpu.setFullScaleGyroRange(MPU6050_GYRO_FS_250);
+            configureHardware();
+        }
         #if MPU_RUN_DEVICE_TEST_CONNECT 
             unsigned long start = millis();
-            while (!mpu.testConnection()) {
+            while (!testConnection()) {
                 if (millis() - start > 5000) {
                     Serial.println("MPU not responding...");
                     return false;
@@ -34,6 +73,11 @@ namespace overseer::device::imu {
         return true;
     }
 
+    bool MPU6000::testConnection() {
+        bus::I2CBus::Lock lock(i2c_bus, i2c_client);
+        return mpu.testConnection();
+    }
+
     void MPU6000::configureHardware() {        
         mpu.setFullScaleGyroRange(MPU6050_GYRO_FS_250);
         mpu.setFullScaleAccelRange(MPU6050_ACCEL_FS_2); // or _4, _8, _16
@@ -45,21 +89,36 @@ namespace overseer::device::imu {
     }
 
     void MPU6000::printMPUData(const MPUData& data) {
+        report::LineBuffer<96> line;
         Serial.println("=== IMU DATA REPORT ===");
-        Serial.printf("Pitch: %.2f deg, Roll: %.2f deg\n", data.pitch_deg, data.roll_deg);
+        line.append("Pitch: ").appendFloat(data.pitch_deg, 2).append(" deg, Roll: ").appendFloat(data.roll_deg, 2)
+            .append(" deg, Yaw: ").appendFloat(data.yaw_deg, 2).append(" deg");
+        Serial.println(line.c_str());
+        line.clear();
+        line.append("Rate: x=").appendFloat(data.rate_x_dps, 2).append(", y=").appendFloat(data.rate_y_dps, 2)
+            .append(", z=").appendFloat(data.rate_z_dps, 2).append(" deg/s");
+        Serial.println(line.c_str());
         //Serial.printf("Raw G:    gx=%.3f, gy=%.3f, gz=%.3f\n", data.gx, data.gy, data.gz);
         //Serial.printf("Smooth G: gx=%.3f, gy=%.3f, gz=%.3f\n", data.gx_smooth, data.gy_smooth, data.gz_smooth);
 
         //Serial.printf("Lifetime Max G: gx=%.3f, gy=%.3f, gz=%.3f\n", data.max_gx, data.max_gy, data.max_gz);
         float max_gforce = std::max(data.gx, std::max(data.gy, data.gz));
 
-        Serial.printf("Lifetime Max G: %.3f\n", max_gforce);
+        line.clear();
+        line.append("Lifetime Max G: ").appendFloat(max_gforce);
+        Serial.println(line.c_str());
         Serial.println("----- Stats -----");
-        Serial.printf("Total Samples: Total=%llu, Dropped=%llu, Samples/sec=%.2f\n\n",
-                    data.total_samples, data.dropped_samples, data.samples_per_second);
+        line.clear();
+        line.append("Total Samples: Total=").appendUnsigned(data.total_samples)
+            .append(", Dropped=").appendUnsigned(data.dropped_samples)
+            .append(", Samples/sec=").appendFloat(data.samples_per_second, 2);
+        Serial.println(line.c_str());
+        Serial.println("");
         
         Serial.println("----- Variables -----");
-        Serial.printf("smoothing_alpha: %F, spike_threshold: %F\n", smoothing_alpha, spike_threshold);
+        line.clear();
+        line.append("smoothing_alpha: ").appendFloat(smoothing_alpha, 6).append(", spike_threshold: ").appendFloat(spike_threshold, 6);
+        Serial.println(line.c_str());
         /*
         Serial.println("--- Rolling Max G Windows ---");
         using pair_type = decltype(data.max_g_windows_x)::value_type;
@@ -85,6 +144,10 @@ namespace overseer::device::imu {
         Serial.println("===========================");
     }
 
+    report::PublishResult MPU6000::printMPUChanges(unsigned long now) {
+        return report::printChanges(reporter, _data, "IMU", now, Serial);
+    }
+
     /*
     void MPU6000::printMPUData(const mpu6000::data::MPUData& data) {
         Serial.println(F( "=== MPU6050 Sensor Data ===" ));
@@ -175,37 +238,65 @@ namespace overseer::device::imu {
         d.max_gy = std::max(d.max_gy, abs(d.gy_smooth));
         d.max_gz = std::max(d.max_gz, abs(d.gz_smooth));
         
-        // Append to historical deque
+        // Windowed max: one compare per axis per sample; the maps are refreshed when
+        // the engine folds (every tick), with entries overwritten in place
         unsigned long now = millis();
-        gx_history.push_back({now, abs(d.gx_smooth)});
-        gy_history.push_back({now, abs(d.gy_smooth)});
-        gz_history.push_back({now, abs(d.gz_smooth)});
-        
-        // Clear old samples outside the largest window
-        auto cutoff = now - g_windows.back() * 1000;
-        auto clean = [cutoff](std::deque<std::pair<unsigned long, float>>& deque) {
-            while (!deque.empty() && deque.front().first < cutoff) deque.pop_front();
-        };
-        clean(gx_history); clean(gy_history); clean(gz_history);
-        
-        // Compute per-window max
-        d.max_g_windows_x.clear();
-        d.max_g_windows_y.clear();
-        d.max_g_windows_z.clear();
-
-        for (auto window_sec : g_windows) {
-            unsigned long window_start = now - window_sec * 1000;
-            float max_x = 0.0f, max_y = 0.0f, max_z = 0.0f;
-
-            for (const auto& entry : gx_history) if (entry.first >= window_start) max_x = std::max(max_x, entry.second);
-            for (const auto& entry : gy_history) if (entry.first >= window_start) max_y = std::max(max_y, entry.second);
-            for (const auto& entry : gz_history) if (entry.first >= window_start) max_z = std::max(max_z, entry.second);
-
-            String label = String(window_sec) + "s";
-            d.max_g_windows_x[label] = max_x;
-            d.max_g_windows_y[label] = max_y;
-            d.max_g_windows_z[label] = max_z;
-        }            
+        g_window_max.add(0, d.gx_smooth);
+        g_window_max.add(1, d.gy_smooth);
+        g_window_max.add(2, d.gz_smooth);
+        if (g_window_max.advance(now)) {
+            for (size_t w = 0; w < g_window_labels.size(); w++) {
+                const String& label = g_window_labels[w];
+                d.max_g_windows_x[label] = g_window_max.get(0, w);
+                d.max_g_windows_y[label] = g_window_max.get(1, w);
+                d.max_g_windows_z[label] = g_window_max.get(2, w);
+            }
+        }
+    }
+
+    void MPU6000::configureWindows() {
+        g_window_max.configure(g_windows, 3);
+        g_window_labels.clear();
+        g_window_labels.reserve(g_windows.size());
+        for (unsigned long window_sec : g_windows) g_window_labels.push_back(String(window_sec) + "s");
+        _data.max_g_windows_x.clear();
+        _data.max_g_windows_y.clear();
+        _data.max_g_windows_z.clear();
+        for (const String& label : g_window_labels) {
+            _data.max_g_windows_x[label] = 0.0f;
+            _data.max_g_windows_y[label] = 0.0f;
+            _data.max_g_windows_z[label] = 0.0f;
+        }
+    }
+
+    bool MPU6000::setWindows(const std::vector<unsigned long>& windows_sec) {
+        if (windows_sec.empty()) return false;
+        g_windows = windows_sec;
+        std::sort(g_windows.begin(), g_windows.end());
+        g_windows.erase(std::unique(g_windows.begin(), g_windows.end()), g_windows.end());
+        configureWindows();
+        return true;
+    }
+
+    void MPU6000::attachConfig(::config::ConfigManager& cfg, const char* section) {
+        config = &cfg;
+        config_section = section;
+    }
+
+    bool MPU6000::readMotion(int16_t* ax, int16_t* ay, int16_t* az, int16_t* gx, int16_t* gy, int16_t* gz) {
+        if (!i2c_bus) {
+            mpu.getMotion6(ax, ay, az, gx, gy, gz);
+            return true;
+        }
+        uint8_t raw[14];        // big-endian: accel xyz, temperature, gyro xyz
+        if (!i2c_bus->read(i2c_client, REG_ACCEL_XOUT_H, raw, sizeof(raw))) return false;
+        *ax = (int16_t)((raw[0] << 8) | raw[1]);
+        *ay = (int16_t)((raw[2] << 8) | raw[3]);
+        *az = (int16_t)((raw[4] << 8) | raw[5]);
+        *gx = (int16_t)((raw[8] << 8) | raw[9]);
+        *gy = (int16_t)((raw[10] << 8) | raw[11]);
+        *gz = (int16_t)((raw[12] << 8) | raw[13]);
+        return true;
     }
 
     void MPU6000::update() {
@@ -215,14 +306,31 @@ namespace overseer::device::imu {
         int16_t ax, ay, az;
         int16_t gx_raw, gy_raw, gz_raw;
         
-        mpu.getMotion6(&ax, &ay, &az, &gx_raw, &gy_raw, &gz_raw);
+        if (!readMotion(&ax, &ay, &az, &gx_raw, &gy_raw, &gz_raw)) {
+            bad_i2c_read++;
+            return;
+        }
 
-        _data.gx = gx_raw / 16384.0f;
-        _data.gy = gy_raw / 16384.0f;
-        _data.gz = gz_raw / 16384.0f;
+        // Accelerometer -> G, gyro -> deg/s
+        _data.gx = ax / ACCEL_LSB_PER_G;
+        _data.gy = ay / ACCEL_LSB_PER_G;
+        _data.gz = az / ACCEL_LSB_PER_G;
+        _data.rate_x_dps = gx_raw / GYRO_LSB_PER_DPS;
+        _data.rate_y_dps = gy_raw / GYRO_LSB_PER_DPS;
+        _data.rate_z_dps = gz_raw / GYRO_LSB_PER_DPS;
+        if (g_capture.isConfigured()) {
+            g_capture.push(micros(), sqrtf(_data.gx * _data.gx + _data.gy * _data.gy + _data.gz * _data.gz));
+        }
 
-        _data.pitch_deg = atan2(ax, sqrt(ay * ay + az * az)) * 180.0f / PI;
-        _data.roll_deg  = atan2(ay, sqrt(ax * ax + az * az)) * 180.0f / PI;
+        // Fuse accel + gyro into attitude
+        unsigned long now_us = micros();
+        float dt = (last_fusion_time_us > 0) ? (now_us - last_fusion_time_us) * 1e-6f : 0.0f;
+        last_fusion_time_us = now_us;
+        attitude.update(_data.gx, _data.gy, _data.gz,
+                        _data.rate_x_dps, _data.rate_y_dps, _data.rate_z_dps, dt);
+        _data.pitch_deg = attitude.getPitch();
+        _data.roll_deg  = attitude.getRoll();
+        _data.yaw_deg   = attitude.getYaw();
 
 
         if (fabs(_data.gx) > fabs(_data.max_gx)) _data.max_gx = _data.gx;
@@ -248,13 +356,146 @@ namespace overseer::device::imu {
         _data.total_samples = total_samples;
         _data.dropped_samples = dropped_samples;
         _data.samples_per_second = samples_per_second;
+
+        if (quantiles_enabled) updateQuantiles(now);
+
+        // The FIFO keeps sampling on its own; a full block is transformed here at most once per update()
+        if (vibration_enabled) {
+            drainFifo();
+            if (vibration.process()) publishVibration();
+        }
+    }
+
+    void MPU6000::enableQuantiles(const std::vector<unsigned long>& tiers_sec) {
+        // 2^-10 G (~1 mG) resolves well below the sensor noise floor
+        for (stats::QuantileWindows& q : g_quantiles) q.configure(tiers_sec, -10);
+        quantiles_enabled = true;
+        quantiles_published = false;
+    }
+
+    void MPU6000::disableQuantiles() {
+        for (stats::QuantileWindows& q : g_quantiles) q.configure({});
+        quantiles_enabled = false;
+        _data.g_quantiles_x.clear();
+        _data.g_quantiles_y.clear();
+        _data.g_quantiles_z.clear();
+    }
+
+    void MPU6000::updateQuantiles(unsigned long now) {
+        g_quantiles[0].add(_data.gx);
+        g_quantiles[1].add(_data.gy);
+        g_quantiles[2].add(_data.gz);
+        for (stats::QuantileWindows& q : g_quantiles) q.advance(now);
+
+        if (quantiles_published && now - last_quantile_refresh_ms < 1000) return;
+        std::map<String, stats::QuantileSummary>* targets[3] = {&_data.g_quantiles_x, &_data.g_quantiles_y, &_data.g_quantiles_z};
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            for (size_t t = 0; t < g_quantiles[axis].getTierCount(); t++) {
+                (*targets[axis])[String(g_quantiles[axis].getTierSeconds(t)) + "s"] = g_quantiles[axis].summary(t);
+            }
+        }
+        quantiles_published = true;
+        last_quantile_refresh_ms = now;
+    }
+
+    bool MPU6000::enableCapture(const capture::TriggerConfig& trigger, uint16_t pre, uint16_t post, uint8_t slots) {
+        if (!g_capture.configure(pre, post, slots)) return false;
+        g_capture.setTrigger(trigger);
+        Log.notice("MPU6000: Trigger capture on |G|, %d pre / %d post samples, %d slots" CR, pre, post, slots);
+        return true;
+    }
+
+    bool MPU6000::enableVibrationAnalysis(const vibration::VibrationConfig& config) {
+        if (!initialized) return false;
+        if (config.sample_rate_hz < 4.0f || config.sample_rate_hz > 1000.0f) {
+            Log.warning("MPU6000: Vibration sample rate %.1f Hz out of range (4-1000)" CR, config.sample_rate_hz);
+            return false;
+        }
+
+        // With the DLPF on the sample rate is 1 kHz / (1 + divider)
+        uint8_t divider = (uint8_t)(lroundf(1000.0f / config.sample_rate_hz) - 1);
+        vibration::VibrationConfig applied = config;
+        applied.sample_rate_hz = 1000.0f / (1 + divider);
+        vibration.configure(applied);
+
+        {
+            bus::I2CBus::Lock lock(i2c_bus, i2c_client);
+            mpu.setDLPFMode(MPU6050_DLPF_BW_188);
+            mpu.setRate(divider);
+            mpu.resetFIFO();
+            mpu.setAccelFIFOEnabled(true);
+            mpu.setFIFOEnabled(true);
+        }
+        vibration_enabled = true;
+
+        Log.notice("MPU6000: Vibration analysis on, %.1f Hz, %d-point FFT" CR,
+                   applied.sample_rate_hz, MPU_VIBRATION_FFT_SIZE);
+        return true;
+    }
+
+    void MPU6000::disableVibrationAnalysis() {
+        bus::I2CBus::Lock lock(i2c_bus, i2c_client);
+        mpu.setFIFOEnabled(false);
+        mpu.setAccelFIFOEnabled(false);
+        vibration_enabled = false;
+    }
+
+    void MPU6000::drainFifo() {
+        // 1 KB FIFO holds ~170 ms of accel frames at 1 kHz; past that samples are lost
+        bus::I2CBus::Lock lock(i2c_bus, i2c_client);
+        uint16_t count = mpu.getFIFOCount();
+        if (count >= 1024) {
+            mpu.resetFIFO();
+            dropped_samples++;
+            return;
+        }
+
+        const uint8_t FRAME_BYTES = 6;      // ax, ay, az big-endian
+        const uint8_t axis_offset = (uint8_t)vibration.getConfig().axis * 2;
+        uint8_t buffer[FRAME_BYTES * 8];
+        while (count >= FRAME_BYTES) {
+            uint8_t frames = count / FRAME_BYTES > 8 ? 8 : count / FRAME_BYTES;
+            mpu.getFIFOBytes(buffer, frames * FRAME_BYTES);
+            for (uint8_t f = 0; f < frames; f++) {
+                const uint8_t* frame = &buffer[f * FRAME_BYTES + axis_offset];
+                int16_t raw = (int16_t)((frame[0] << 8) | frame[1]);
+                vibration.push(raw / ACCEL_LSB_PER_G);
+            }
+            count -= frames * FRAME_BYTES;
+        }
+    }
+
+    void MPU6000::publishVibration() {
+        const vibration::VibrationSpectrum& s = vibration.getSpectrum();
+        _data.vibration_rms = s.rms;
+        _data.vibration_band_count = s.band_count;
+        for (uint8_t b = 0; b < s.band_count; b++) _data.vibration_band_rms[b] = s.band_rms[b];
+        _data.vibration_peak_count = s.peak_count;
+        for (uint8_t p = 0; p < vibration::MAX_PEAKS; p++) {
+            _data.vibration_peak_hz[p] = s.peak_hz[p];
+            _data.vibration_peak_g[p] = s.peak_g[p];
+        }
+        _data.vibration_blocks = vibration.getBlockCount();
+        _data.vibration_overruns = vibration.getOverruns();
+    }
+
+    void MPU6000::setFusionGain(float gain) {
+        attitude.setGain(gain);
+    }
+
+    float MPU6000::getFusionGain() const {
+        return attitude.getGain();
     }
 
     void MPU6000::setData(const MPUData& newData) {
         _data = newData;
     }
 
-    MPUData MPU6000::getData() const {
+    void MPU6000::setData(MPUData&& newData) {
+        _data = std::move(newData);
+    }
+
+    const MPUData& MPU6000::getData() const {
         return _data;
     }
 
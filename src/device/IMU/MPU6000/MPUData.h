@@ -1,6 +1,7 @@
 #pragma once
 #include <map>
 #include <String>
+#include "device/stats/QuantileSketch.h"
 //#include <Arduino.h>
 
 namespace overseer::device::imu {
@@ -24,21 +25,23 @@ namespace overseer::device::imu {
         unsigned long last_reset = 0;  // millis()
     };
     */
-    struct MPUData {
-        
-        uint64_t total_samples = 0;
-        uint64_t dropped_samples = 0;
-        float samples_per_second = 0.0f;
-
-        //Vector3f max_g;
-        //std::map<String, Vector3f> max_g_windows;
-        // Current orientation and acceleration
+    // Hot block: the values every update() rewrites, packed at offset 0 of
+    // MPUData so one sample touches three 32-byte lines on ESP32 instead of
+    // spreading across the struct. MPU6000::getSample() copies just this part.
+    struct alignas(32) MPUSample {
+        // Current orientation (fused accel + gyro) and acceleration
         float pitch_deg = 0.0f;
         float roll_deg = 0.0f;
-        float gx = 0.0f;
+        float yaw_deg = 0.0f;           // gyro-integrated, drifts without a magnetometer
+        float gx = 0.0f;                // accelerometer, in G
         float gy = 0.0f;
         float gz = 0.0f;
 
+        // Angular rate (deg/s)
+        float rate_x_dps = 0.0f;
+        float rate_y_dps = 0.0f;
+        float rate_z_dps = 0.0f;
+
         // Smoothed versions
         float pitch_deg_smooth = 0.0f;
         float roll_deg_smooth = 0.0f;
@@ -46,21 +49,46 @@ namespace overseer::device::imu {
         float gy_smooth = 0.0f;
         float gz_smooth = 0.0f;
 
+        // Lifetime max G-forces
+        float max_gx = 0.0f;
+        float max_gy = 0.0f;
+        float max_gz = 0.0f;
+    };
+    static_assert(sizeof(MPUSample) == 3 * 32, "MPUSample must stay within three 32-byte cache lines");
+    static_assert(alignof(MPUSample) == 32, "MPUSample must start on a cache line");
+
+    // Cold block: counters (per sample, next line), then spectrum, windows and
+    // quantiles that change per FFT block or once per second.
+    struct MPUData : MPUSample {
+        uint64_t total_samples = 0;
+        uint64_t dropped_samples = 0;
+        float samples_per_second = 0.0f;
+
         // For spike detection
         float gx_last = 0.0f;
         float gy_last = 0.0f;
         float gz_last = 0.0f;
 
-        // Lifetime max G-forces
-        float max_gx = 0.0f;
-        float max_gy = 0.0f;
-        float max_gz = 0.0f;
+        // Vibration spectrum (MPUVibration.h), refreshed once per FFT block
+        float vibration_rms = 0.0f;             // G, gravity/bias removed
+        float vibration_band_rms[8] = {0};      // G per configured band, see vibration::VibrationConfig
+        uint8_t vibration_band_count = 0;
+        float vibration_peak_hz[3] = {0};       // dominant peaks, strongest first
+        float vibration_peak_g[3] = {0};
+        uint8_t vibration_peak_count = 0;
+        uint32_t vibration_blocks = 0;
+        uint32_t vibration_overruns = 0;        // blocks dropped because the previous one was still queued
         
         // maps for historical G-force tracking:
         std::map<String, float> max_g_windows_x;
         std::map<String, float> max_g_windows_y;
         std::map<String, float> max_g_windows_z;
         
+        // Windowed |G| quantiles per axis, filled only after MPU6000::enableQuantiles()
+        std::map<String, overseer::device::stats::QuantileSummary> g_quantiles_x;
+        std::map<String, overseer::device::stats::QuantileSummary> g_quantiles_y;
+        std::map<String, overseer::device::stats::QuantileSummary> g_quantiles_z;
+        
         // Rolling max windows (time durations in ms)
 /*         GMaxWindow max_1s;
         GMaxWindow max_5s;
@@ -76,6 +104,51 @@ namespace overseer::device::imu {
         GMaxWindow max_30m; */
     };
 
+    // Walks every numeric field without copying the struct or building Strings.
+    // fn(name, window, value): window is the max_g_windows_* key, nullptr for scalars.
+    template <typename Fn>
+    void visitFields(const MPUData& d, Fn&& fn) {
+        fn("pitch_deg", nullptr, d.pitch_deg);
+        fn("roll_deg", nullptr, d.roll_deg);
+        fn("yaw_deg", nullptr, d.yaw_deg);
+        fn("gx", nullptr, d.gx);
+        fn("gy", nullptr, d.gy);
+        fn("gz", nullptr, d.gz);
+        fn("rate_x_dps", nullptr, d.rate_x_dps);
+        fn("rate_y_dps", nullptr, d.rate_y_dps);
+        fn("rate_z_dps", nullptr, d.rate_z_dps);
+        fn("pitch_deg_smooth", nullptr, d.pitch_deg_smooth);
+        fn("roll_deg_smooth", nullptr, d.roll_deg_smooth);
+        fn("gx_smooth", nullptr, d.gx_smooth);
+        fn("gy_smooth", nullptr, d.gy_smooth);
+        fn("gz_smooth", nullptr, d.gz_smooth);
+        fn("max_gx", nullptr, d.max_gx);
+        fn("max_gy", nullptr, d.max_gy);
+        fn("max_gz", nullptr, d.max_gz);
+        for (const auto& entry : d.max_g_windows_x) fn("max_gx", entry.first.c_str(), entry.second);
+        for (const auto& entry : d.max_g_windows_y) fn("max_gy", entry.first.c_str(), entry.second);
+        for (const auto& entry : d.max_g_windows_z) fn("max_gz", entry.first.c_str(), entry.second);
+        auto quantiles = [&fn](const char* p50, const char* p95, const char* p99,
+                               const std::map<String, overseer::device::stats::QuantileSummary>& tiers) {
+            for (const auto& entry : tiers) {
+                fn(p50, entry.first.c_str(), entry.second.p50);
+                fn(p95, entry.first.c_str(), entry.second.p95);
+                fn(p99, entry.first.c_str(), entry.second.p99);
+            }
+        };
+        quantiles("gx_p50", "gx_p95", "gx_p99", d.g_quantiles_x);
+        quantiles("gy_p50", "gy_p95", "gy_p99", d.g_quantiles_y);
+        quantiles("gz_p50", "gz_p95", "gz_p99", d.g_quantiles_z);
+        fn("vibration_rms", nullptr, d.vibration_rms);
+        static const char* const labels[] = {"0", "1", "2", "3", "4", "5", "6", "7"};
+        for (uint8_t i = 0; i < d.vibration_band_count; i++) fn("vibration_band_rms", labels[i], d.vibration_band_rms[i]);
+        for (uint8_t i = 0; i < d.vibration_peak_count; i++) {
+            fn("vibration_peak_hz", labels[i], d.vibration_peak_hz[i]);
+            fn("vibration_peak_g", labels[i], d.vibration_peak_g[i]);
+        }
+        fn("samples_per_second", nullptr, d.samples_per_second);
+    }
+
     }  // namespace data
 }  // namespace overseer::device::imu
 
@@ -0,0 +1,151 @@
+//MPUFusion.h
+#pragma once
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+// Attitude fusion stage for the MPU6000.
+// Select the filter at compile time (build_flags = -DMPU_FUSION_FILTER=MPU_FUSION_MADGWICK).
+// Both filters are branch-light and loop-free so the per-sample cost is fixed:
+//   complementary: 2x atan2 + 1x sqrt + ~20 flops
+//   madgwick:      2x inv-sqrt + ~110 flops, euler angles derived on demand
+#define MPU_FUSION_COMPLEMENTARY 0
+#define MPU_FUSION_MADGWICK      1
+
+#ifndef MPU_FUSION_FILTER
+#define MPU_FUSION_FILTER MPU_FUSION_COMPLEMENTARY
+#endif
+
+namespace overseer::device::imu::fusion {
+
+    constexpr float RAD_TO_DEG_F = 57.29577951f;
+    constexpr float DEG_TO_RAD_F = 0.01745329252f;
+
+    // Fast inverse square root (one Newton iteration, ~0.2% error), avoids a divide + sqrt.
+    inline float invSqrt(float x) {
+        uint32_t i;
+        memcpy(&i, &x, sizeof(i));      // bit copy, not a union pun (UB in C++); folds to a register move
+        i = 0x5F3759DF - (i >> 1);
+        float y;
+        memcpy(&y, &i, sizeof(y));
+        return y * (1.5f - 0.5f * x * y * y);
+    }
+
+    class ComplementaryFilter {
+        private:
+            float alpha = 0.98f;   // gyro weight; (1 - alpha) is the accel correction
+            float pitch = 0.0f;    // degrees
+            float roll = 0.0f;
+            float yaw = 0.0f;      // gyro-only, drifts
+            bool seeded = false;
+        public:
+            void setGain(float gyro_weight) { alpha = gyro_weight; }
+            float getGain() const { return alpha; }
+            void reset() { pitch = roll = yaw = 0.0f; seeded = false; }
+
+            // accel in g, gyro in deg/s, dt in seconds
+            void update(float ax, float ay, float az, float gx, float gy, float gz, float dt) {
+                float acc_pitch = atan2f(ax, sqrtf(ay * ay + az * az)) * RAD_TO_DEG_F;
+                float acc_roll  = atan2f(ay, az) * RAD_TO_DEG_F;
+
+                if (!seeded) {
+                    pitch = acc_pitch;
+                    roll = acc_roll;
+                    seeded = true;
+                    return;
+                }
+
+                // Pitch rotates about Y, roll about X
+                pitch = alpha * (pitch - gy * dt) + (1.0f - alpha) * acc_pitch;
+                roll  = alpha * (roll  + gx * dt) + (1.0f - alpha) * acc_roll;
+                yaw  += gz * dt;
+            }
+
+            float getPitch() const { return pitch; }
+            float getRoll() const { return roll; }
+            float getYaw() const { return yaw; }
+    };
+
+    // Madgwick IMU (6-DOF) gradient-descent orientation filter.
+    class MadgwickFilter {
+        private:
+            float beta = 0.1f;     // algorithm gain
+            float q0 = 1.0f, q1 = 0.0f, q2 = 0.0f, q3 = 0.0f;
+        public:
+            void setGain(float gain) { beta = gain; }
+            float getGain() const { return beta; }
+            void reset() { q0 = 1.0f; q1 = q2 = q3 = 0.0f; }
+
+            // accel in g, gyro in deg/s, dt in seconds
+            void update(float ax, float ay, float az, float gx, float gy, float gz, float dt) {
+                gx *= DEG_TO_RAD_F;
+                gy *= DEG_TO_RAD_F;
+                gz *= DEG_TO_RAD_F;
+
+                // Rate of change of quaternion from gyroscope
+                float qDot1 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+                float qDot2 = 0.5f * ( q0 * gx + q2 * gz - q3 * gy);
+                float qDot3 = 0.5f * ( q0 * gy - q1 * gz + q3 * gx);
+                float qDot4 = 0.5f * ( q0 * gz + q1 * gy - q2 * gx);
+
+                // Accelerometer correction only when the measurement is usable (avoids NaN)
+                if (!((ax == 0.0f) && (ay == 0.0f) && (az == 0.0f))) {
+                    float recipNorm = invSqrt(ax * ax + ay * ay + az * az);
+                    ax *= recipNorm;
+                    ay *= recipNorm;
+                    az *= recipNorm;
+
+                    float _2q0 = 2.0f * q0, _2q1 = 2.0f * q1, _2q2 = 2.0f * q2, _2q3 = 2.0f * q3;
+                    float _4q0 = 4.0f * q0, _4q1 = 4.0f * q1, _4q2 = 4.0f * q2;
+                    float _8q1 = 8.0f * q1, _8q2 = 8.0f * q2;
+                    float q0q0 = q0 * q0, q1q1 = q1 * q1, q2q2 = q2 * q2, q3q3 = q3 * q3;
+
+                    // Gradient descent corrective step
+                    float s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+                    float s1 = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q1 - _2q0 * ay - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+                    float s2 = 4.0f * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+                    float s3 = 4.0f * q1q1 * q3 - _2q1 * ax + 4.0f * q2q2 * q3 - _2q2 * ay;
+                    float sNorm = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+                    if (sNorm > 0.0f) {
+                        recipNorm = invSqrt(sNorm);
+                        qDot1 -= beta * s0 * recipNorm;
+                        qDot2 -= beta * s1 * recipNorm;
+                        qDot3 -= beta * s2 * recipNorm;
+                        qDot4 -= beta * s3 * recipNorm;
+                    }
+                }
+
+                q0 += qDot1 * dt;
+                q1 += qDot2 * dt;
+                q2 += qDot3 * dt;
+                q3 += qDot4 * dt;
+
+                float recipNorm = invSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+                q0 *= recipNorm;
+                q1 *= recipNorm;
+                q2 *= recipNorm;
+                q3 *= recipNorm;
+            }
+
+            // Same sign convention as the accel-only pitch (positive when +X points up)
+            float getPitch() const {
+                float s = 2.0f * (q1 * q3 - q0 * q2);
+                if (s > 1.0f) s = 1.0f;
+                if (s < -1.0f) s = -1.0f;
+                return asinf(s) * RAD_TO_DEG_F;
+            }
+            float getRoll() const {
+                return atan2f(q0 * q1 + q2 * q3, 0.5f - q1 * q1 - q2 * q2) * RAD_TO_DEG_F;
+            }
+            float getYaw() const {
+                return atan2f(q1 * q2 + q0 * q3, 0.5f - q2 * q2 - q3 * q3) * RAD_TO_DEG_F;
+            }
+    };
+
+#if MPU_FUSION_FILTER == MPU_FUSION_MADGWICK
+    using AttitudeFilter = MadgwickFilter;
+#else
+    using AttitudeFilter = ComplementaryFilter;
+#endif
+
+}  // namespace overseer::device::imu::fusion
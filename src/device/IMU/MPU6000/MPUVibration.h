@@ -0,0 +1,307 @@
+//MPUVibration.h
+#pragma once
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <array>
+#include <atomic>
+
+// Vibration spectrum stage for the MPU6000.
+// Fixed-size blocks of one accelerometer axis go through an in-place radix-2
+// real FFT (N reals packed as N/2 complex, then split). On ESP32 with ESP-DSP
+// available the complex core runs on dsps_fft2r_fc32; elsewhere the portable
+// loop below is used. Memory is static per analyzer: two N-sample buffers and
+// an N/2 twiddle table (~3 KB at the default N = 256), no heap.
+// Block size is a build flag (build_flags = -DMPU_VIBRATION_FFT_SIZE=512).
+#ifndef MPU_VIBRATION_FFT_SIZE
+#define MPU_VIBRATION_FFT_SIZE 256
+#endif
+
+#if defined(ARDUINO_ARCH_ESP32) && __has_include(<esp_dsp.h>)
+#include <esp_dsp.h>
+#define MPU_VIBRATION_ESP_DSP 1
+#endif
+
+namespace overseer::device::imu::vibration {
+
+    constexpr uint8_t MAX_BANDS = 8;
+    constexpr uint8_t MAX_PEAKS = 3;
+
+    // In-place real FFT of N samples.
+    // Output layout: data[0] = X[0], data[1] = X[N/2] (both real),
+    // data[2k], data[2k+1] = Re/Im X[k] for 0 < k < N/2.
+    template <size_t N>
+    class RealFFT {
+        static_assert(N >= 8 && (N & (N - 1)) == 0, "FFT size must be a power of two >= 8");
+
+        public:
+            static constexpr size_t M = N / 2;      // complex points in the core transform
+
+            RealFFT() {
+                for (size_t k = 0; k < M; k++) {
+                    cos_table[k] = cosf(2.0f * (float)M_PI * k / N);
+                    sin_table[k] = sinf(2.0f * (float)M_PI * k / N);
+                }
+            #ifdef MPU_VIBRATION_ESP_DSP
+                dsps_fft2r_init_fc32(nullptr, M);
+            #endif
+            }
+
+            void transform(float* data) const {
+                complexFFT(data);
+                split(data);
+            }
+
+            // cos(2 pi k / N) for 0 <= k < N/2, shared with the Hann window
+            float cosAt(size_t k) const { return cos_table[k]; }
+
+        private:
+            std::array<float, M> cos_table;
+            std::array<float, M> sin_table;
+
+            void complexFFT(float* data) const {
+            #ifdef MPU_VIBRATION_ESP_DSP
+                dsps_fft2r_fc32(data, M);
+                dsps_bit_rev_fc32(data, M);
+            #else
+                // Bit-reversal permutation
+                for (size_t i = 1, j = 0; i < M; i++) {
+                    size_t bit = M >> 1;
+                    for (; j & bit; bit >>= 1) j ^= bit;
+                    j ^= bit;
+                    if (i < j) {
+                        float tr = data[2 * i], ti = data[2 * i + 1];
+                        data[2 * i] = data[2 * j];
+                        data[2 * i + 1] = data[2 * j + 1];
+                        data[2 * j] = tr;
+                        data[2 * j + 1] = ti;
+                    }
+                }
+                // Butterflies; twiddles for size M are every (N / len)-th entry of the N table
+                for (size_t len = 2; len <= M; len <<= 1) {
+                    const size_t half = len >> 1;
+                    const size_t stride = N / len;
+                    for (size_t start = 0; start < M; start += len) {
+                        for (size_t k = 0; k < half; k++) {
+                            const float wr = cos_table[k * stride];
+                            const float wi = -sin_table[k * stride];
+                            float* a = &data[2 * (start + k)];
+                            float* b = &data[2 * (start + k + half)];
+                            const float tr = b[0] * wr - b[1] * wi;
+                            const float ti = b[0] * wi + b[1] * wr;
+                            b[0] = a[0] - tr;
+                            b[1] = a[1] - ti;
+                            a[0] += tr;
+                            a[1] += ti;
+                        }
+                    }
+                }
+            #endif
+            }
+
+            // Separate the packed even/odd transforms into the spectrum of the real input
+            void split(float* data) const {
+                const float z0r = data[0], z0i = data[1];
+                data[0] = z0r + z0i;        // DC
+                data[1] = z0r - z0i;        // Nyquist
+
+                for (size_t k = 1; k <= M / 2; k++) {
+                    const size_t m = M - k;
+                    const float a = data[2 * k], b = data[2 * k + 1];
+                    const float c = data[2 * m], d = data[2 * m + 1];
+                    const float er = 0.5f * (a + c), ei = 0.5f * (b - d);
+                    const float orr = 0.5f * (b + d), oi = -0.5f * (a - c);
+                    const float wr = cos_table[k], wi = -sin_table[k];
+                    const float tr = wr * orr - wi * oi;
+                    const float ti = wr * oi + wi * orr;
+                    data[2 * k] = er + tr;
+                    data[2 * k + 1] = ei + ti;
+                    if (m != k) {
+                        data[2 * m] = er - tr;
+                        data[2 * m + 1] = -(ei - ti);
+                    }
+                }
+            }
+    };
+
+    enum class VibrationAxis : uint8_t { X, Y, Z };
+
+    struct VibrationConfig {
+        float sample_rate_hz = 1000.0f;
+        VibrationAxis axis = VibrationAxis::Z;
+        uint8_t band_count = 5;
+        float band_edges_hz[MAX_BANDS + 1] = {2.0f, 10.0f, 50.0f, 100.0f, 200.0f, 500.0f};
+        float min_peak_hz = 2.0f;       // ignore the DC skirt when picking peaks
+        bool hann_window = true;
+    };
+
+    struct VibrationSpectrum {
+        float rms = 0.0f;                       // G, DC removed, all bins
+        float band_rms[MAX_BANDS] = {0};        // G per configured band
+        float peak_hz[MAX_PEAKS] = {0};         // strongest first
+        float peak_g[MAX_PEAKS] = {0};          // amplitude (0-peak) in G
+        uint8_t band_count = 0;
+        uint8_t peak_count = 0;
+    };
+
+    // Double-buffered block analyzer.
+    // push() fills one buffer while process() transforms the other in place, so
+    // acquisition (FIFO drain, ISR or another task) never waits for the FFT. If
+    // a block fills before the previous one was processed, the new block is
+    // dropped and counted in getOverruns() instead of blocking the producer.
+    template <size_t N>
+    class VibrationAnalyzer {
+        public:
+            static constexpr size_t BINS = N / 2;
+
+            VibrationAnalyzer() = default;
+
+            // Copies carry the configuration and last spectrum; buffered samples start over
+            VibrationAnalyzer(const VibrationAnalyzer& other) : cfg(other.cfg), spectrum(other.spectrum) {}
+            VibrationAnalyzer& operator=(const VibrationAnalyzer& other) {
+                cfg = other.cfg;
+                spectrum = other.spectrum;
+                reset();
+                return *this;
+            }
+
+            void configure(const VibrationConfig& config) {
+                cfg = config;
+                if (cfg.band_count > MAX_BANDS) cfg.band_count = MAX_BANDS;
+                reset();
+            }
+
+            void reset() {
+                fill_index = 0;
+                fill_count = 0;
+                ready.store(-1);
+                blocks = 0;
+                overruns = 0;
+            }
+
+            // Producer side: O(1), never blocks
+            inline void push(float sample) {
+                buffers[fill_index][fill_count++] = sample;
+                if (fill_count < N) return;
+                fill_count = 0;
+                if (ready.load(std::memory_order_acquire) >= 0) {
+                    overruns++;                 // consumer still busy: reuse this buffer
+                    return;
+                }
+                ready.store((int8_t)fill_index, std::memory_order_release);
+                fill_index ^= 1;
+            }
+
+            bool isBlockReady() const { return ready.load(std::memory_order_acquire) >= 0; }
+
+            // Consumer side: transforms the ready block; false when none is waiting
+            bool process() {
+                int8_t index = ready.load(std::memory_order_acquire);
+                if (index < 0) return false;
+                float* data = buffers[index].data();
+                analyze(data);
+                blocks++;
+                ready.store(-1, std::memory_order_release);
+                return true;
+            }
+
+            const VibrationSpectrum& getSpectrum() const { return spectrum; }
+            const VibrationConfig& getConfig() const { return cfg; }
+            float getBinWidth() const { return cfg.sample_rate_hz / N; }
+            uint32_t getBlockCount() const { return blocks; }
+            uint32_t getOverruns() const { return overruns; }
+
+        private:
+            VibrationConfig cfg;
+            RealFFT<N> fft;
+            alignas(16) std::array<float, N> buffers[2];   // ESP-DSP wants 16-byte alignment
+            uint8_t fill_index = 0;
+            size_t fill_count = 0;
+            std::atomic<int8_t> ready{-1};
+            uint32_t blocks = 0;
+            uint32_t overruns = 0;
+            VibrationSpectrum spectrum;
+
+            void analyze(float* data) {
+                // Remove DC (gravity, bias) and apply the window
+                float mean = 0.0f;
+                for (size_t n = 0; n < N; n++) mean += data[n];
+                mean /= N;
+
+                float window_sum = 0.0f, window_sq = 0.0f;
+                for (size_t n = 0; n < N; n++) {
+                    float w = 1.0f;
+                    if (cfg.hann_window) {
+                        // cos(2 pi n / N) from the twiddle table, mirrored for the upper half
+                        size_t index = n < BINS ? n : N - n;
+                        w = 0.5f - 0.5f * (index < BINS ? fft.cosAt(index) : -1.0f);
+                    }
+                    data[n] = (data[n] - mean) * w;
+                    window_sum += w;
+                    window_sq += w * w;
+                }
+
+                fft.transform(data);
+
+                // One-sided power per bin (G^2), written in place over the spectrum
+                const float power_scale = 2.0f / (N * window_sq);
+                const float amplitude_scale = 2.0f / window_sum;
+                const float nyquist = data[1] * data[1] * (power_scale * 0.5f);
+                data[0] = 0.0f;     // DC was removed above
+                for (size_t k = 1; k < BINS; k++) {
+                    const float re = data[2 * k], im = data[2 * k + 1];
+                    data[k] = (re * re + im * im) * power_scale;
+                }
+
+                // Overall and per-band RMS
+                const float bin_hz = getBinWidth();
+                float total = nyquist;
+                for (size_t k = 1; k < BINS; k++) total += data[k];
+                spectrum.rms = sqrtf(total);
+                spectrum.band_count = cfg.band_count;
+                for (uint8_t b = 0; b < cfg.band_count; b++) {
+                    float sum = 0.0f;
+                    for (size_t k = 1; k < BINS; k++) {
+                        float f = k * bin_hz;
+                        if (f >= cfg.band_edges_hz[b] && f < cfg.band_edges_hz[b + 1]) sum += data[k];
+                    }
+                    spectrum.band_rms[b] = sqrtf(sum);
+                }
+
+                findPeaks(data, bin_hz, amplitude_scale / sqrtf(power_scale));
+            }
+
+            // Local maxima of the power spectrum, strongest first, refined by a parabolic fit
+            void findPeaks(const float* power, float bin_hz, float to_amplitude) {
+                spectrum.peak_count = 0;
+                for (uint8_t p = 0; p < MAX_PEAKS; p++) {
+                    spectrum.peak_hz[p] = 0.0f;
+                    spectrum.peak_g[p] = 0.0f;
+                }
+
+                size_t first = (size_t)ceilf(cfg.min_peak_hz / bin_hz);
+                if (first < 1) first = 1;
+                for (size_t k = first; k + 1 < BINS; k++) {
+                    if (power[k] <= power[k - 1] || power[k] < power[k + 1]) continue;
+
+                    const float a = sqrtf(power[k - 1]), b = sqrtf(power[k]), c = sqrtf(power[k + 1]);
+                    const float denom = a - 2.0f * b + c;
+                    const float delta = denom != 0.0f ? 0.5f * (a - c) / denom : 0.0f;
+                    const float magnitude = b - 0.25f * (a - c) * delta;
+                    const float amplitude = magnitude * to_amplitude;
+
+                    // Insert into the sorted top-K list
+                    uint8_t slot = spectrum.peak_count < MAX_PEAKS ? spectrum.peak_count : MAX_PEAKS;
+                    while (slot > 0 && spectrum.peak_g[slot - 1] < amplitude) slot--;
+                    if (slot >= MAX_PEAKS) continue;
+                    for (uint8_t p = MAX_PEAKS - 1; p > slot; p--) {
+                        spectrum.peak_hz[p] = spectrum.peak_hz[p - 1];
+                        spectrum.peak_g[p] = spectrum.peak_g[p - 1];
+                    }
+                    spectrum.peak_hz[slot] = (k + delta) * bin_hz;
+                    spectrum.peak_g[slot] = amplitude;
+                    if (spectrum.peak_count < MAX_PEAKS) spectrum.peak_count++;
+                }
+            }
+    };
+} // namespace overseer::device::imu::vibration
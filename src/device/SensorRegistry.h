@@ -0,0 +1,131 @@
+// SensorRegistry.h
+#pragma once
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <device_types.h>
+
+namespace overseer::device {
+    namespace detail {
+        template <typename T>
+        struct is_sensor_array : std::false_type {};
+        template <typename T, size_t N>
+        struct is_sensor_array<std::array<T, N>> : std::true_type {};
+
+        // Calls fn on a device, or on every device of a std::array<Device, N> slot
+        template <typename Slot, typename Fn>
+        void visitSlot(Slot& slot, Fn& fn) {
+            if constexpr (is_sensor_array<Slot>::value) {
+                for (auto& device : slot) fn(device);
+            } else {
+                fn(slot);
+            }
+        }
+
+        template <typename T, typename... Ts>
+        constexpr size_t countType() { return (0 + ... + (std::is_same_v<T, Ts> ? 1 : 0)); }
+
+        template <typename T>
+        constexpr size_t slotSize() {
+            if constexpr (is_sensor_array<T>::value) return std::tuple_size<T>::value;
+            else return 1;
+        }
+
+        template <typename T>
+        struct slot_device { using type = T; };
+        template <typename T, size_t N>
+        struct slot_device<std::array<T, N>> { using type = T; };
+    } // namespace detail
+
+    // Compile-time registry of sensor devices held by value in one tuple.
+    // Every call is resolved statically (fold over the type list), so there are no
+    // virtual calls and no heap; a slot may be std::array<Device, N> for many
+    // identical sensors. Devices need begin() and update(); a device type that
+    // declares `static constexpr HARDWARE_DEVICE_TYPE DEVICE_TYPE` can also be
+    // selected by category with forEachOfType().
+    //
+    //   SensorRegistry<MPU6000, WCS1800, std::array<WCS1800, 4>> node;
+    //   node.beginAll();
+    //   node.updateAll();
+    //   node.get<MPU6000>().getPitch();
+    template <typename... Slots>
+    class SensorRegistry {
+        static_assert(sizeof...(Slots) > 0, "SensorRegistry needs at least one device");
+
+        private:
+            std::tuple<Slots...> _slots;
+
+        public:
+            SensorRegistry() = default;
+
+            // One constructor argument per slot, e.g. SensorRegistry<WCS1800, MPU6000> r(WCS1800(34), MPU6000(1, 2));
+            template <typename... Args, typename = std::enable_if_t<sizeof...(Args) == sizeof...(Slots) && (sizeof...(Args) > 0)>>
+            explicit SensorRegistry(Args&&... args) : _slots(std::forward<Args>(args)...) {}
+
+            // Number of slots / number of individual devices (arrays expanded)
+            static constexpr size_t slotCount() { return sizeof...(Slots); }
+            static constexpr size_t deviceCount() { return (0 + ... + detail::slotSize<Slots>()); }
+
+            // Typed lookup; the slot type must appear exactly once
+            template <typename T>
+            T& get() {
+                static_assert(detail::countType<T, Slots...>() == 1, "type must appear exactly once in the registry, use get<I>()");
+                return std::get<T>(_slots);
+            }
+            template <typename T>
+            const T& get() const {
+                static_assert(detail::countType<T, Slots...>() == 1, "type must appear exactly once in the registry, use get<I>()");
+                return std::get<T>(_slots);
+            }
+
+            template <size_t I>
+            auto& get() { return std::get<I>(_slots); }
+            template <size_t I>
+            const auto& get() const { return std::get<I>(_slots); }
+
+            // Calls fn(device) for every device, arrays expanded, in declaration order
+            template <typename Fn>
+            void forEach(Fn&& fn) {
+                std::apply([&fn](auto&... slot) { (detail::visitSlot(slot, fn), ...); }, _slots);
+            }
+            template <typename Fn>
+            void forEach(Fn&& fn) const {
+                std::apply([&fn](const auto&... slot) { (detail::visitSlot(slot, fn), ...); }, _slots);
+            }
+
+            // Calls fn(device) only for devices of the given category
+            template <HARDWARE_DEVICE_TYPE TYPE, typename Fn>
+            void forEachOfType(Fn&& fn) {
+                forEach([&fn](auto& device) {
+                    using Device = std::decay_t<decltype(device)>;
+                    if constexpr (hasType<Device, TYPE>(0)) fn(device);
+                });
+            }
+
+            template <HARDWARE_DEVICE_TYPE TYPE>
+            static constexpr size_t countOfType() {
+                return (0 + ... + (hasType<typename detail::slot_device<Slots>::type, TYPE>(0) ? detail::slotSize<Slots>() : 0));
+            }
+
+            // Starts every device, even after a failure; returns how many came up
+            size_t beginAll() {
+                size_t started = 0;
+                forEach([&started](auto& device) { started += device.begin() ? 1 : 0; });
+                return started;
+            }
+
+            // One batched pass over every device
+            void updateAll() {
+                forEach([](auto& device) { device.update(); });
+            }
+
+        private:
+            template <typename Device, HARDWARE_DEVICE_TYPE TYPE>
+            static constexpr auto hasType(int) -> decltype(Device::DEVICE_TYPE, bool()) { return Device::DEVICE_TYPE == TYPE; }
+            template <typename Device, HARDWARE_DEVICE_TYPE TYPE>
+            static constexpr bool hasType(...) { return false; }
+    };
+} // namespace overseer::device
@@ -4,20 +4,41 @@
 
 namespace overseer::device::ads {
 
-    MPLEX::MPLEX(uint8_t address) : _ads(address) {
+    MPLEX::MPLEX(uint8_t address) : _ads(address), _address(address) {
         _channelConfigs.resize(4);
         _channelData.resize(4);
+        _channelCalibration.resize(4);
+        _channelRange.resize(4);
+        _channelDecimator.resize(4);
         
         // Initialize default channel configurations
         for (int i = 0; i < 4; i++) {
             _channelConfigs[i].label = "CH" + String(i);
             _channelConfigs[i].units = "V";
+            _channelRange[i].begin(expectedRange(_channelConfigs[i]));
+            _channelDecimator[i].begin(1);
         }
     }
+    bool MPLEX::attachBus(bus::I2CBus& bus) {
+        uint8_t client = bus.addClient("ads1115", _address);
+        if (client == 0xFF) {
+            Log.warning("MPLEX: I2C bus has no free client slot, using Wire directly" CR);
+            return false;
+        }
+        _bus = &bus;
+        _busClient = client;
+        _wireClock = bus.getConfig().clock_hz;
+        return true;
+    }
+
     bool MPLEX::begin() {    
-        _ads.begin();
-        _ads.setWireClock(100000);
+        {
+            bus::I2CBus::Lock lock(_bus, _busClient);
+            _ads.begin();
+            if (!_bus) _ads.setWireClock(100000);     // the shared bus sets the clock for every device
+        }
         delay(30);
+        bus::I2CBus::Lock lock(_bus, _busClient);
         _ads.setGain(0);
         _ads.setDataRate(7);  //  0 = slow   4 = medium   7 = fast
         //_ads.setMode(1);
@@ -25,37 +46,38 @@ namespace overseer::device::ads {
     }
 
     bool MPLEX::isConnected() {
+        bus::I2CBus::Lock lock(_bus, _busClient);
         return _ads.isConnected();        
     }
 
     void MPLEX::scan_i2c_bus () {
         Serial.println("I2C Scanner:: Starting");
+        bus::I2CBus::Lock lock(_bus, _busClient);
         for (byte address = 1; address < 127; address++) {
             Wire.beginTransmission(address);
             if (Wire.endTransmission() == 0) {
                 Serial.print("Found device at 0x");
                 Serial.println(address, HEX);
             }
-            delay(10);            
         }
         Serial.println("I2C Scanner:: Finished");
     }
 
     int16_t MPLEX::getChannelRaw(int channel) {
         if (!isValidChannel(channel)) return 0;
-        updateChannel(channel);
+        refreshChannel(channel);
         return _channelData[channel].raw_value;
     }
 
     float MPLEX::getChannelVoltage(int channel) {
         if (!isValidChannel(channel)) return 0.0f;
-        updateChannel(channel);
+        refreshChannel(channel);
         return _channelData[channel].voltage;
     }
 
     float MPLEX::getChannelScaled(int channel) {
         if (!isValidChannel(channel)) return 0.0f;
-        updateChannel(channel);
+        refreshChannel(channel);
         return _channelData[channel].scaled_value;
     }
 
@@ -67,6 +89,10 @@ namespace overseer::device::ads {
     void MPLEX::setChannelConfig(int channel, const ChannelConfig& config) {
         if (isValidChannel(channel)) {
             _channelConfigs[channel] = config;
+            _channelRange[channel].begin(expectedRange(config));
+            _channelDecimator[channel].begin(config.decimation, config.decimation_filter);
+            invalidateChannel(channel);
+            syncAlertThresholds(channel);
         }
     }
 
@@ -92,12 +118,14 @@ namespace overseer::device::ads {
     void MPLEX::setChannelGain(int channel, float gain) {
         if (isValidChannel(channel)) {
             _channelConfigs[channel].gain = gain;
+            invalidateChannel(channel);
         }
     }
 
     void MPLEX::setChannelOffset(int channel, float offset) {
         if (isValidChannel(channel)) {
             _channelConfigs[channel].offset = offset;
+            invalidateChannel(channel);
         }
     }
 
@@ -105,28 +133,158 @@ namespace overseer::device::ads {
         if (isValidChannel(channel)) {
             _channelConfigs[channel].min_range = min_val;
             _channelConfigs[channel].max_range = max_val;
+            _channelRange[channel].begin(expectedRange(_channelConfigs[channel]));
+            syncAlertThresholds(channel);
         }
     }
 
     void MPLEX::enableChannel(int channel, bool enabled) {
         if (isValidChannel(channel)) {
             _channelConfigs[channel].enabled = enabled;
+            _channelDecimator[channel].reset();
+            invalidateChannel(channel);
+        }
+    }
+
+    void MPLEX::setChannelInput(int channel, InputMode mode) {
+        if (isValidChannel(channel)) {
+            _channelConfigs[channel].input = mode;
+            _channelDecimator[channel].reset();
+            invalidateChannel(channel);
         }
     }
 
+    void MPLEX::setChannelDecimation(int channel, uint8_t factor, DecimationFilter filter) {
+        if (isValidChannel(channel)) {
+            _channelConfigs[channel].decimation = factor;
+            _channelConfigs[channel].decimation_filter = filter;
+            _channelDecimator[channel].begin(factor, filter);
+            invalidateChannel(channel);
+        }
+    }
+
+    void MPLEX::setChannelMaxAge(int channel, unsigned long max_age_ms) {
+        if (isValidChannel(channel)) {
+            _channelConfigs[channel].max_age_ms = max_age_ms;
+        }
+    }
+
+    void MPLEX::setMaxAge(unsigned long max_age_ms) {
+        for (int i = 0; i < 4; i++) {
+            _channelConfigs[i].max_age_ms = max_age_ms;
+        }
+    }
+
+    void MPLEX::setChannelAutoRange(int channel, bool enabled, const AutoRangeConfig& config) {
+        if (isValidChannel(channel)) {
+            _channelConfigs[channel].auto_range = enabled;
+            _channelRange[channel].begin(expectedRange(_channelConfigs[channel]), config);
+            syncAlertThresholds(channel);
+        }
+    }
+
+    uint8_t MPLEX::getChannelPga(int channel) const {
+        return isValidChannel(channel) ? channelGain(channel) : _gain;
+    }
+
+    uint8_t MPLEX::channelGain(int channel) const {
+        return _channelConfigs[channel].auto_range ? _channelRange[channel].getGain() : _gain;
+    }
+
     float MPLEX::calibrateChannelZero(int channel, uint8_t samples) {
-        if (!isValidChannel(channel)) return 0.0f;
+        if (!isValidChannel(channel)) return NAN;
         
-        float sum = 0.0f;
-        for (uint8_t i = 0; i < samples; ++i) {
-            int16_t raw = _ads.readADC(channel);
-            float voltage_mV = _ads.toVoltage(raw);
-            sum += voltage_mV / 1000.0f;
-            delay(10);
+        calibration::ZeroCalibrationConfig cfg;
+        cfg.max_samples = samples;
+        if (cfg.min_samples > samples) cfg.min_samples = samples;
+
+        calibration::ZeroCalibration& cal = _channelCalibration[channel];
+        cal.start(cfg);
+        while (cal.isRunning()) {
+            cal.addSample(readChannelVoltage(channel), millis());
+            if (cal.isRunning()) delay(cfg.sample_interval_ms);
+        }
+        return finishChannelCalibration(channel) ? cal.getMean() : NAN;
+    }
+
+    void MPLEX::startChannelCalibration(int channel, const calibration::ZeroCalibrationConfig& config) {
+        if (isValidChannel(channel)) {
+            _channelCalibration[channel].start(config);
         }
-        float zero_voltage = sum / samples;
-        _channelConfigs[channel].offset = zero_voltage;
-        return zero_voltage;
+    }
+
+    void MPLEX::startAllChannelCalibration(const calibration::ZeroCalibrationConfig& config) {
+        for (int i = 0; i < 4; i++) {
+            if (_channelConfigs[i].enabled) {
+                startChannelCalibration(i, config);
+            }
+        }
+    }
+
+    bool MPLEX::isCalibrating(int channel) const {
+        return isValidChannel(channel) && _channelCalibration[channel].isRunning();
+    }
+
+    calibration::CalibrationState MPLEX::getCalibrationState(int channel) const {
+        if (!isValidChannel(channel)) return calibration::CalibrationState::IDLE;
+        return _channelCalibration[channel].getState();
+    }
+
+    void MPLEX::update() {
+        unsigned long now = millis();
+
+        // ALERT fired: the comparator saw a conversion outside the window, confirm it now
+        if (_alertPending && _alertChannel >= 0) {
+            _alertPending = false;
+            _alertCount++;
+            const ChannelConfig& cfg = _channelConfigs[_alertChannel];
+            float scaled = (readChannelVoltage(_alertChannel) + cfg.offset) * cfg.gain;
+            if (_alarms) _alarms->evaluate(_alarmSignalBase + _alertChannel, scaled, now);
+            return;
+        }
+
+        // Round-robin over channels so a single call never costs more than one conversion
+        for (int n = 0; n < 4; n++) {
+            int channel = (_nextCalibrationChannel + n) % 4;
+            calibration::ZeroCalibration& cal = _channelCalibration[channel];
+            if (!cal.isDue(now)) continue;
+
+            if (cal.addSample(readChannelVoltage(channel), now) != calibration::CalibrationState::RUNNING) {
+                finishChannelCalibration(channel);
+            }
+            _nextCalibrationChannel = (channel + 1) % 4;
+            return;
+        }
+
+        // Otherwise keep decimated channels accumulating in the background
+        for (int n = 0; n < 4; n++) {
+            int channel = (_nextScanChannel + n) % 4;
+            if (!_channelConfigs[channel].enabled || _channelConfigs[channel].decimation <= 1) continue;
+
+            convertChannel(channel);
+            _nextScanChannel = (channel + 1) % 4;
+            return;
+        }
+    }
+
+    bool MPLEX::finishChannelCalibration(int channel) {
+        const calibration::ZeroCalibration& cal = _channelCalibration[channel];
+        if (cal.getState() != calibration::CalibrationState::DONE) {
+            Log.warning("MPLEX: CH%d zero calibration rejected (n=%u, stddev=%.4fV)" CR,
+                        channel, (unsigned)cal.getSampleCount(), cal.getStdDev());
+            return false;
+        }
+        // scaled = (voltage + offset) * gain, so the offset cancels the measured zero
+        _channelConfigs[channel].offset = -cal.getMean();
+        invalidateChannel(channel);
+        return true;
+    }
+
+    float MPLEX::readChannelVoltage(int channel) {
+        uint8_t gain = channelGain(channel);
+        bus::I2CBus::Lock lock(_bus, _busClient);
+        if (_ads.getGain() != gain) _ads.setGain(gain);
+        return rawToVoltage(readInput(_ads, _channelConfigs[channel].input, channel), gain);
     }
 
     void MPLEX::calibrateAllChannels(uint8_t samples) {
@@ -141,44 +299,165 @@ namespace overseer::device::ads {
         if (!isValidChannel(channel)) {
             return ChannelData{};
         }
-        updateChannel(channel);
+        refreshChannel(channel);
         return _channelData[channel];
     }
 
+    const std::vector<ChannelData>& MPLEX::snapshot() {
+        for (int i = 0; i < 4; i++) {
+            refreshChannel(i);
+        }
+        return _channelData;
+    }
+
     void MPLEX::updateAllChannels() {
         for (int i = 0; i < 4; i++) {
             updateChannel(i);
         }
     }
 
+    void MPLEX::refreshChannel(int channel) {
+        if (!_channelConfigs[channel].enabled ||
+            isStale(_channelData[channel], _channelConfigs[channel].max_age_ms, millis())) {
+            updateChannel(channel);
+        }
+    }
+
+    void MPLEX::invalidateChannel(int channel) {
+        if (isValidChannel(channel)) {
+            _channelData[channel].valid = false;
+        }
+    }
+
     void MPLEX::updateChannel(int channel) {
         if (!isValidChannel(channel) || !_channelConfigs[channel].enabled) {
             _channelData[channel].valid = false;
             return;
         }
 
-        _channelData[channel].raw_value = _ads.readADC(channel);
-        float voltage_mV = _ads.toVoltage(_channelData[channel].raw_value);
-        _channelData[channel].voltage = voltage_mV / 1000.0f;
-        
+        // Blocks for up to settleConversions() + 1 conversions (2 x factor + 1 for a cold
+        // CIC2, ~2 s at 128 SPS and factor 128); update() normally keeps this short. If
+        // auto-range keeps restarting the decimator the previous result is kept, marked invalid.
+        if (!convertBounded(_channelDecimator[channel], [&] { return convertChannel(channel); })) {
+            _channelData[channel].valid = false;
+            Log.trace("MPLEX: CH%d no decimated result within %u conversions" CR,
+                      channel, (unsigned)_channelDecimator[channel].settleConversions() + 1);
+        }
+    }
+
+    bool MPLEX::convertChannel(int channel) {
+        const ChannelConfig& cfg = _channelConfigs[channel];
+        ChannelData& data = _channelData[channel];
+        Decimator& decimator = _channelDecimator[channel];
+
+        // PGA is only switched here, when this channel is actually scanned
+        uint8_t gain = channelGain(channel);
+        bool ready, range_changed;
+        {
+            bus::I2CBus::Lock lock(_bus, _busClient);
+            ready = convertDecimated(_ads, cfg, channel, gain, decimator, _channelRange[channel],
+                                     data.raw_value, range_changed);
+        }
+        if (range_changed) syncAlertThresholds(channel);
+        if (!ready) return false;
+
+        data.counts = decimator.getValue();
+        data.voltage = rawToVoltage(data.counts, gain);
+        data.pga_gain = gain;
+
         // Apply gain and offset
-        _channelData[channel].scaled_value = (_channelData[channel].voltage + _channelConfigs[channel].offset) * _channelConfigs[channel].gain;
-        
-        _channelData[channel].valid = true;
-        _channelData[channel].last_update = millis();
+        data.scaled_value = (data.voltage + cfg.offset) * cfg.gain;
+
+        data.valid = true;
+        data.last_update = millis();
+
+        if (_alarms) _alarms->evaluate(_alarmSignalBase + channel, data.scaled_value, data.last_update);
+        return true;
+    }
+
+    void MPLEX::attachAlarms(alarm::AlarmEngine& engine, uint8_t signal_base) {
+        _alarms = &engine;
+        _alarmSignalBase = signal_base;
+    }
+
+    void IRAM_ATTR MPLEX::onAlert(void* arg) {
+        static_cast<MPLEX*>(arg)->_alertPending = true;
+    }
+
+    bool MPLEX::enableAlertPrefilter(int channel, float low_volts, float high_volts, uint8_t alert_pin) {
+        if (!isValidChannel(channel) || low_volts >= high_volts) return false;
+
+        _alertChannel = channel;
+        _alertLowVolts = low_volts;
+        _alertHighVolts = high_volts;
+        programAlertThresholds();
+        {
+            bus::I2CBus::Lock lock(_bus, _busClient);
+            _ads.setComparatorMode(1);          // window: alert outside [low, high]
+            _ads.setComparatorPolarity(0);      // active low
+            _ads.setComparatorLatch(0);
+            _ads.setComparatorQueConvert(0);    // assert after one conversion
+        }
+
+        _alertPin = alert_pin;
+        _alertPending = false;
+        pinMode(alert_pin, INPUT_PULLUP);
+        attachInterruptArg(digitalPinToInterrupt(alert_pin), onAlert, this, FALLING);
+        Log.notice("MPLEX: ALERT prefilter on CH%d [%dmV, %dmV], pin %d" CR,
+                   channel, (int)lroundf(low_volts * 1000.0f), (int)lroundf(high_volts * 1000.0f), alert_pin);
+        return true;
+    }
+
+    // Thresholds are raw counts at the alert channel's PGA; the comparator sees every
+    // conversion, so an alert from another channel only costs one confirming read.
+    void MPLEX::programAlertThresholds() {
+        _alertGain = channelGain(_alertChannel);
+        float counts_per_volt = 32767.0f / pgaFullScale(_alertGain);
+        float lo = _alertLowVolts * counts_per_volt;
+        float hi = _alertHighVolts * counts_per_volt;
+        bus::I2CBus::Lock lock(_bus, _busClient);
+        _ads.setComparatorThresholdLow((int16_t)(lo < -32768.0f ? -32768.0f : lo));
+        _ads.setComparatorThresholdHigh((int16_t)(hi > 32767.0f ? 32767.0f : hi));
+    }
+
+    // Auto-range or a gain change moved the alert channel's PGA: rescale the counts
+    void MPLEX::syncAlertThresholds(int channel) {
+        if (_alertChannel < 0 || (channel >= 0 && channel != _alertChannel)) return;
+        if (channelGain(_alertChannel) != _alertGain) programAlertThresholds();
+    }
+
+    void MPLEX::disableAlertPrefilter() {
+        if (_alertChannel < 0) return;
+        detachInterrupt(digitalPinToInterrupt(_alertPin));
+        bus::I2CBus::Lock lock(_bus, _busClient);
+        _ads.setComparatorQueConvert(3);    // comparator off, ALERT high-Z
+        _alertChannel = -1;
+        _alertPending = false;
     }
 
     void MPLEX::setGain(uint8_t gain) {
         _gain = gain;
-        _ads.setGain(gain);
+        {
+            bus::I2CBus::Lock lock(_bus, _busClient);
+            _ads.setGain(gain);
+        }
+        for (int i = 0; i < 4; i++) {
+            invalidateChannel(i);
+        }
+        syncAlertThresholds(-1);
     }
 
     void MPLEX::setDataRate(uint8_t rate) {
         _dataRate = rate;
+        bus::I2CBus::Lock lock(_bus, _busClient);
         _ads.setDataRate(rate);
     }
 
     void MPLEX::setWireClock(uint32_t clock) {
+        if (_bus) {
+            Log.notice("MPLEX: Wire clock is owned by the shared I2C bus (%lu Hz)" CR, (unsigned long)_wireClock);
+            return;
+        }
         _wireClock = clock;
         _ads.setWireClock(clock);
     }
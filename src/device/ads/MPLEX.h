@@ -1,42 +1,65 @@
 // MPLEX.h
 #pragma once
 #include <ADS1X15.h>
+#include <ArduinoLog.h>
+#include <device_types.h>
 #include <vector>
+#include "MPLEXData.h"
+#include "PgaAutoRange.h"
+#include "device/calibration/ZeroCalibration.h"
+#include "device/alarm/AlarmEngine.h"
+#include "device/bus/I2CBus.h"
 
 namespace overseer::device::ads {
-    struct ChannelConfig {
-        bool enabled = true;
-        float gain = 1.0f;
-        float offset = 0.0f;
-        String label = "";
-        String units = "V";
-        float min_range = 0.0f;
-        float max_range = 5.0f;
-    };
-
-    struct ChannelData {
-        int16_t raw_value = 0;
-        float voltage = 0.0f;
-        float scaled_value = 0.0f;
-        bool valid = false;
-        unsigned long last_update = 0;
-    };
-    
     class MPLEX {
     private:
         ADS1115 _ads;
+        uint8_t _address;
         std::vector<ChannelConfig> _channelConfigs;
         std::vector<ChannelData> _channelData;
+        std::vector<calibration::ZeroCalibration> _channelCalibration;
+        std::vector<PgaAutoRange> _channelRange;
+        std::vector<Decimator> _channelDecimator;
+        int _nextCalibrationChannel = 0;
+        int _nextScanChannel = 0;
+
+        // Alarms: evaluated on every published sample; ALERT pin triggers an immediate read
+        alarm::AlarmEngine* _alarms = nullptr;
+        uint8_t _alarmSignalBase = 0;
+        int _alertChannel = -1;
+        uint8_t _alertPin = 0;
+        volatile bool _alertPending = false;
+        uint32_t _alertCount = 0;
+        float _alertLowVolts = 0.0f;
+        float _alertHighVolts = 0.0f;
+        uint8_t _alertGain = 0;             // PGA the comparator thresholds were computed for
         
         // ADC settings
         uint8_t _gain = 0;
         uint8_t _dataRate = 7;
         uint32_t _wireClock = 100000;
 
+        // Shared bus (optional): ADS1X15 keeps driving Wire, under the bus Lock
+        bus::I2CBus* _bus = nullptr;
+        uint8_t _busClient = 0xFF;
+
+        // Conversion / calibration helpers
+        float readChannelVoltage(int channel);
+        void refreshChannel(int channel);
+        bool convertChannel(int channel);
+        static void onAlert(void* arg);
+        uint8_t channelGain(int channel) const;
+        bool finishChannelCalibration(int channel);
+        void programAlertThresholds();
+        void syncAlertThresholds(int channel);
+
     public:
+        static constexpr HARDWARE_DEVICE_TYPE DEVICE_TYPE = ANALOG_MUX;
+
         MPLEX(uint8_t address = 0x48);
         
         // Initialization and status
+        bool attachBus(bus::I2CBus& bus);  // before begin(); the bus then owns the Wire clock
         bool begin();
         bool isConnected();
         void scan_i2c_bus();
@@ -56,15 +79,35 @@ namespace overseer::device::ads {
         void setChannelOffset(int channel, float offset);
         void setChannelRange(int channel, float min_val, float max_val);
         void enableChannel(int channel, bool enabled = true);
+        void setChannelAutoRange(int channel, bool enabled = true, const AutoRangeConfig& config = AutoRangeConfig());
+        void setChannelInput(int channel, InputMode mode);
+        void setChannelDecimation(int channel, uint8_t factor, DecimationFilter filter = DecimationFilter::BOXCAR);
+        void setChannelMaxAge(int channel, unsigned long max_age_ms);
+        void setMaxAge(unsigned long max_age_ms);                           // all channels
+        uint8_t getChannelPga(int channel) const;
         
         // Calibration
-        float calibrateChannelZero(int channel, uint8_t samples = 10);
+        float calibrateChannelZero(int channel, uint8_t samples = 10);     // blocking, stops early once converged; NAN if rejected
         void calibrateAllChannels(uint8_t samples = 10);
+        void startChannelCalibration(int channel,
+                                     const calibration::ZeroCalibrationConfig& config = calibration::ZeroCalibrationConfig());
+        void startAllChannelCalibration(const calibration::ZeroCalibrationConfig& config = calibration::ZeroCalibrationConfig());
+        bool isCalibrating(int channel) const;
+        calibration::CalibrationState getCalibrationState(int channel) const;
+        void update();                                                     // steps calibrations, then decimated channels; one conversion per call
         
-        // Data access
+        // Alarms
+        void attachAlarms(alarm::AlarmEngine& engine, uint8_t signal_base = 0);   // signal = base + channel
+        bool enableAlertPrefilter(int channel, float low_volts, float high_volts, uint8_t alert_pin);
+        void disableAlertPrefilter();
+        uint32_t getAlertCount() const { return _alertCount; }
+
+        // Data access (getters convert only when the cached sample is older than max_age_ms)
         ChannelData getChannelData(int channel);
+        const std::vector<ChannelData>& snapshot();                        // all channels, one scan of the stale ones
         void updateAllChannels();
         void updateChannel(int channel);
+        void invalidateChannel(int channel);
         
         // ADC settings
         void setGain(uint8_t gain);
@@ -0,0 +1,262 @@
+// MPLEXBus.h
+#pragma once
+#include <array>
+#include <device_types.h>
+#include "MPLEXData.h"
+#include "PgaAutoRange.h"
+#include "device/alarm/AlarmEngine.h"
+#include "device/bus/I2CBus.h"
+
+#ifdef ARDUINO
+#include <ADS1X15.h>
+#include <ArduinoLog.h>
+#endif
+
+namespace overseer::device::ads {
+    // Bus-level manager for up to four ADS1115 chips (0x48-0x4B) on one I2C bus.
+    // Logical channel = (address - 0x48) * 4 + input, so channel numbers stay stable
+    // regardless of which chips are fitted. update() interleaves single-shot
+    // conversions: every chip gets a conversion requested, and results are collected
+    // from whichever chips are ready, so one chip's conversion time overlaps with
+    // reads from the others and throughput scales with the number of chips.
+    //
+    // ADC is any type with the ADS1X15 async API (begin, isConnected, setGain,
+    // setDataRate, setMode, requestADC, isReady, getValue); Bus is what its
+    // constructor takes as second argument (TwoWire* on target). Channels configured
+    // as differential pairs use the requestADC_Differential_x_y() calls instead.
+    // With a shared I2CBus attached, every chip access runs under its Lock, one
+    // chip's service at a time, so queued bursts from other devices interleave.
+    template <typename ADC, typename Bus>
+    class MPLEXBusT {
+    public:
+        static constexpr uint8_t BASE_ADDRESS = 0x48;
+        static constexpr uint8_t MAX_DEVICES = 4;
+        static constexpr uint8_t CHANNELS_PER_DEVICE = 4;
+        static constexpr uint8_t MAX_CHANNELS = MAX_DEVICES * CHANNELS_PER_DEVICE;
+
+    private:
+        struct DeviceSlot {
+            ADC adc;
+            bool present = false;
+            int8_t pending_input = -1;      // input with a conversion in flight, -1 if idle
+            uint8_t pending_gain = 0;       // PGA the in-flight conversion was started with
+            uint8_t next_input = 0;
+            uint32_t conversions = 0;
+        };
+
+        std::array<DeviceSlot, MAX_DEVICES> _devices;
+        std::array<ChannelConfig, MAX_CHANNELS> _channelConfigs;
+        std::array<ChannelData, MAX_CHANNELS> _channelData;
+        std::array<PgaAutoRange, MAX_CHANNELS> _channelRange;
+        std::array<Decimator, MAX_CHANNELS> _channelDecimator;
+        alarm::AlarmEngine* _alarms = nullptr;
+        uint8_t _alarmSignalBase = 0;
+        bus::I2CBus* _i2cBus = nullptr;
+        uint8_t _i2cClient = 0xFF;
+        uint8_t _deviceCount = 0;
+        uint8_t _gain = 0;
+        uint8_t _dataRate = 7;
+
+        static DeviceSlot makeSlot(uint8_t index, Bus bus) {
+            return DeviceSlot{ADC(BASE_ADDRESS + index, bus)};
+        }
+
+        bool nextEnabledInput(DeviceSlot& slot, uint8_t device, uint8_t& input) const {
+            for (uint8_t n = 0; n < CHANNELS_PER_DEVICE; n++) {
+                uint8_t candidate = (slot.next_input + n) % CHANNELS_PER_DEVICE;
+                if (_channelConfigs[device * CHANNELS_PER_DEVICE + candidate].enabled) {
+                    input = candidate;
+                    slot.next_input = (candidate + 1) % CHANNELS_PER_DEVICE;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Config change: drop partial decimator sums, the cached result and any
+        // in-flight conversion started under the old settings
+        void invalidateChannel(uint8_t channel) {
+            _channelDecimator[channel].reset();
+            _channelData[channel].valid = false;
+            DeviceSlot& slot = _devices[channel / CHANNELS_PER_DEVICE];
+            if (slot.pending_input == (int8_t)(channel % CHANNELS_PER_DEVICE)) slot.pending_input = -1;
+        }
+
+        uint8_t channelGain(uint8_t channel) const {
+            return _channelConfigs[channel].auto_range ? _channelRange[channel].getGain() : _gain;
+        }
+
+        void publish(uint8_t channel, int16_t raw, uint8_t gain) {
+            ChannelData& data = _channelData[channel];
+            const ChannelConfig& cfg = _channelConfigs[channel];
+            Decimator& decimator = _channelDecimator[channel];
+            data.raw_value = raw;
+            bool ready = decimator.push(raw);
+            if (cfg.auto_range && _channelRange[channel].update(raw)) {
+                decimator.reset();      // never mix PGA ranges in one decimated result
+            }
+            if (!ready) return;
+
+            data.counts = decimator.getValue();
+            data.voltage = rawToVoltage(data.counts, gain);
+            data.scaled_value = (data.voltage + cfg.offset) * cfg.gain;
+            data.pga_gain = gain;
+            data.valid = true;
+            data.last_update = millis();
+            if (_alarms) _alarms->evaluate(_alarmSignalBase + channel, data.scaled_value, data.last_update);
+        }
+
+    public:
+        static constexpr HARDWARE_DEVICE_TYPE DEVICE_TYPE = ANALOG_MUX;
+
+        explicit MPLEXBusT(Bus bus)
+            : _devices{{makeSlot(0, bus), makeSlot(1, bus), makeSlot(2, bus), makeSlot(3, bus)}} {
+            for (uint8_t i = 0; i < MAX_CHANNELS; i++) {
+                _channelConfigs[i].label = String("ADS") + String(i / CHANNELS_PER_DEVICE) + String("_CH") + String(i % CHANNELS_PER_DEVICE);
+                _channelConfigs[i].units = "V";
+                _channelRange[i].begin(expectedRange(_channelConfigs[i]));
+                _channelDecimator[i].begin(1);
+            }
+        }
+
+        // Probes only 0x48-0x4B, back to back, no per-address delay.
+        uint8_t discover() {
+            _deviceCount = 0;
+            for (uint8_t i = 0; i < MAX_DEVICES; i++) {
+                DeviceSlot& slot = _devices[i];
+                bus::I2CBus::Lock lock(_i2cBus, _i2cClient);
+                slot.present = slot.adc.begin() && slot.adc.isConnected();
+                slot.pending_input = -1;
+                if (!slot.present) continue;
+
+                slot.adc.setGain(_gain);
+                slot.adc.setDataRate(_dataRate);
+                slot.adc.setMode(1);    // single-shot, required for requestADC()/isReady()
+                _deviceCount++;
+            }
+            return _deviceCount;
+        }
+
+        bool begin() { return discover() > 0; }
+
+        // Services every chip once: collect finished conversions, start the next ones.
+        // Never blocks on a conversion; returns the number of results collected.
+        uint8_t update() {
+            uint8_t collected = 0;
+            for (uint8_t d = 0; d < MAX_DEVICES; d++) {
+                DeviceSlot& slot = _devices[d];
+                if (!slot.present) continue;
+
+                bus::I2CBus::Lock lock(_i2cBus, _i2cClient);
+                if (slot.pending_input >= 0) {
+                    if (!slot.adc.isReady()) continue;    // still converting, go service the next chip
+                    publish(d * CHANNELS_PER_DEVICE + slot.pending_input, slot.adc.getValue(), slot.pending_gain);
+                    slot.pending_input = -1;
+                    slot.conversions++;
+                    collected++;
+                }
+
+                uint8_t input;
+                if (nextEnabledInput(slot, d, input)) {
+                    // Per-channel PGA is applied as part of starting this channel's conversion
+                    uint8_t gain = channelGain(d * CHANNELS_PER_DEVICE + input);
+                    if (slot.adc.getGain() != gain) slot.adc.setGain(gain);
+                    requestInput(slot.adc, _channelConfigs[d * CHANNELS_PER_DEVICE + input].input, input);
+                    slot.pending_input = input;
+                    slot.pending_gain = gain;
+                }
+            }
+            return collected;
+        }
+
+        // Shared bus (optional), before begin(): one client for all four chips
+        bool attachBus(bus::I2CBus& i2c) {
+            uint8_t client = i2c.addClient("ads1115_bus", BASE_ADDRESS);
+            if (client == 0xFF) {
+                Log.warning("MPLEXBus: I2C bus has no free client slot, using Wire directly" CR);
+                return false;
+            }
+            _i2cBus = &i2c;
+            _i2cClient = client;
+            return true;
+        }
+
+        // Alarms are evaluated as each result is published; signal = base + channel
+        void attachAlarms(alarm::AlarmEngine& engine, uint8_t signal_base = 0) {
+            _alarms = &engine;
+            _alarmSignalBase = signal_base;
+        }
+
+        // Status
+        uint8_t getDeviceCount() const { return _deviceCount; }
+        bool isDevicePresent(uint8_t device) const { return device < MAX_DEVICES && _devices[device].present; }
+        uint32_t getConversionCount(uint8_t device) const { return device < MAX_DEVICES ? _devices[device].conversions : 0; }
+        uint32_t getTotalConversions() const {
+            uint32_t total = 0;
+            for (const DeviceSlot& slot : _devices) total += slot.conversions;
+            return total;
+        }
+
+        // Channels
+        int getChannelCount() const { return MAX_CHANNELS; }
+        bool isValidChannel(int channel) const {
+            return channel >= 0 && channel < MAX_CHANNELS && _devices[channel / CHANNELS_PER_DEVICE].present;
+        }
+        const ChannelData& getChannelData(int channel) const { return _channelData[isValidChannel(channel) ? channel : 0]; }
+        float getChannelVoltage(int channel) const { return isValidChannel(channel) ? _channelData[channel].voltage : 0.0f; }
+        float getChannelScaled(int channel) const { return isValidChannel(channel) ? _channelData[channel].scaled_value : 0.0f; }
+        // Results are always cached here; update() is what refreshes them
+        const std::array<ChannelData, MAX_CHANNELS>& snapshot() const { return _channelData; }
+        void setChannelConfig(int channel, const ChannelConfig& config) {
+            if (channel < 0 || channel >= MAX_CHANNELS) return;
+            _channelConfigs[channel] = config;
+            _channelRange[channel].begin(expectedRange(config));
+            _channelDecimator[channel].begin(config.decimation, config.decimation_filter);
+            invalidateChannel(channel);
+        }
+        void setChannelAutoRange(int channel, bool enabled = true, const AutoRangeConfig& config = AutoRangeConfig()) {
+            if (channel < 0 || channel >= MAX_CHANNELS) return;
+            _channelConfigs[channel].auto_range = enabled;
+            _channelRange[channel].begin(expectedRange(_channelConfigs[channel]), config);
+        }
+        void setChannelInput(int channel, InputMode mode) {
+            if (channel < 0 || channel >= MAX_CHANNELS) return;
+            _channelConfigs[channel].input = mode;
+            invalidateChannel(channel);
+        }
+        void setChannelDecimation(int channel, uint8_t factor, DecimationFilter filter = DecimationFilter::BOXCAR) {
+            if (channel < 0 || channel >= MAX_CHANNELS) return;
+            _channelConfigs[channel].decimation = factor;
+            _channelConfigs[channel].decimation_filter = filter;
+            _channelDecimator[channel].begin(factor, filter);
+            invalidateChannel(channel);
+        }
+        ChannelConfig getChannelConfig(int channel) const {
+            if (channel < 0 || channel >= MAX_CHANNELS) return ChannelConfig{};
+            return _channelConfigs[channel];
+        }
+        void enableChannel(int channel, bool enabled = true) {
+            if (channel < 0 || channel >= MAX_CHANNELS) return;
+            _channelConfigs[channel].enabled = enabled;
+            invalidateChannel(channel);
+        }
+
+        // ADC settings, applied to every chip
+        void setGain(uint8_t gain) {
+            _gain = gain;
+            bus::I2CBus::Lock lock(_i2cBus, _i2cClient);
+            for (DeviceSlot& slot : _devices) if (slot.present) slot.adc.setGain(gain);
+        }
+        void setDataRate(uint8_t rate) {
+            _dataRate = rate;
+            bus::I2CBus::Lock lock(_i2cBus, _i2cClient);
+            for (DeviceSlot& slot : _devices) if (slot.present) slot.adc.setDataRate(rate);
+        }
+        uint8_t getGain() const { return _gain; }
+        uint8_t getDataRate() const { return _dataRate; }
+    };
+
+#ifdef ARDUINO
+    using MPLEXBus = MPLEXBusT<ADS1115, TwoWire*>;
+#endif
+} // namespace overseer::device::ads
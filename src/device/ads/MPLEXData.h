@@ -0,0 +1,91 @@
+// MPLEXData.h
+#pragma once
+#include <stdint.h>
+#include "Decimator.h"
+
+namespace overseer::device::ads {
+    // What a logical channel converts. Differential pairs are the four the ADS1115 mux supports.
+    enum class InputMode : uint8_t {
+        SINGLE_ENDED,   // AINx vs GND, x = channel
+        DIFF_0_1,
+        DIFF_0_3,
+        DIFF_1_3,
+        DIFF_2_3
+    };
+
+    struct ChannelConfig {
+        bool enabled = true;
+        float gain = 1.0f;
+        float offset = 0.0f;
+        String label = "";
+        String units = "V";
+        float min_range = 0.0f;         // expected input range, seeds the auto-range PGA level
+        float max_range = 5.0f;
+        bool auto_range = false;        // pick the PGA per channel from the signal envelope
+        unsigned long max_age_ms = 0;   // getters reuse a sample younger than this, 0 = always convert
+        InputMode input = InputMode::SINGLE_ENDED;
+        uint8_t decimation = 1;         // conversions per published result
+        DecimationFilter decimation_filter = DecimationFilter::BOXCAR;
+    };
+
+    struct ChannelData {
+        int16_t raw_value = 0;
+        float voltage = 0.0f;
+        float scaled_value = 0.0f;
+        bool valid = false;
+        unsigned long last_update = 0;
+        uint8_t pga_gain = 0;           // ADS1X15 gain code the sample was taken with
+        float counts = 0.0f;            // decimated result in LSBs (fractional when decimation > 1)
+    };
+
+    // Start / run a conversion for `input` on any ADS1X15-compatible ADC
+    template <typename ADC>
+    inline void requestInput(ADC& adc, InputMode mode, uint8_t pin) {
+        switch (mode) {
+            case InputMode::DIFF_0_1: adc.requestADC_Differential_0_1(); break;
+            case InputMode::DIFF_0_3: adc.requestADC_Differential_0_3(); break;
+            case InputMode::DIFF_1_3: adc.requestADC_Differential_1_3(); break;
+            case InputMode::DIFF_2_3: adc.requestADC_Differential_2_3(); break;
+            default:                  adc.requestADC(pin); break;
+        }
+    }
+
+    template <typename ADC>
+    inline int16_t readInput(ADC& adc, InputMode mode, uint8_t pin) {
+        switch (mode) {
+            case InputMode::DIFF_0_1: return adc.readADC_Differential_0_1();
+            case InputMode::DIFF_0_3: return adc.readADC_Differential_0_3();
+            case InputMode::DIFF_1_3: return adc.readADC_Differential_1_3();
+            case InputMode::DIFF_2_3: return adc.readADC_Differential_2_3();
+            default:                  return adc.readADC(pin);
+        }
+    }
+
+    // True when `data` must be re-read before use (wrap-safe on millis())
+    inline bool isStale(const ChannelData& data, unsigned long max_age_ms, unsigned long now) {
+        return !data.valid || (now - data.last_update) >= max_age_ms;
+    }
+
+    inline float expectedRange(const ChannelConfig& config) {
+        float lo = config.min_range < 0.0f ? -config.min_range : config.min_range;
+        float hi = config.max_range < 0.0f ? -config.max_range : config.max_range;
+        return lo > hi ? lo : hi;
+    }
+
+    // ADS1X15 PGA gain codes and their full-scale ranges (volts)
+    inline float pgaFullScale(uint8_t gain) {
+        switch (gain) {
+            case 0:  return 6.144f;
+            case 1:  return 4.096f;
+            case 2:  return 2.048f;
+            case 4:  return 1.024f;
+            case 8:  return 0.512f;
+            case 16: return 0.256f;
+            default: return 6.144f;
+        }
+    }
+
+    inline float rawToVoltage(float raw, uint8_t gain) {
+        return raw * (pgaFullScale(gain) / 32767.0f);
+    }
+} // namespace overseer::device::ads
@@ -0,0 +1,105 @@
+// PgaAutoRange.h
+#pragma once
+#include <math.h>
+#include <stdint.h>
+#include "MPLEXData.h"
+
+namespace overseer::device::ads {
+    struct AutoRangeConfig {
+        float upshift_fraction = 0.90f;     // widen when the envelope passes this fraction of full scale
+        float downshift_fraction = 0.40f;   // narrow when the envelope fits in this fraction of the next range
+        uint8_t downshift_scans = 8;        // ...for this many consecutive scans (hysteresis)
+        float envelope_decay = 0.95f;       // per-scan peak decay
+    };
+
+    // Per-channel PGA selection from the recent signal envelope.
+    // Widening is immediate (clipping loses data), narrowing needs a sustained quiet signal.
+    class PgaAutoRange {
+        public:
+            static constexpr uint8_t LEVELS = 6;
+
+            static uint8_t gainCode(uint8_t level) {
+                constexpr uint8_t codes[LEVELS] = {0, 1, 2, 4, 8, 16};
+                return codes[level < LEVELS ? level : 0];
+            }
+
+            // Narrowest level whose full scale still covers `volts`
+            static uint8_t levelForRange(float volts) {
+                uint8_t level = 0;
+                while (level + 1 < LEVELS && pgaFullScale(gainCode(level + 1)) >= volts) level++;
+                return level;
+            }
+
+            // Start at the narrowest range that covers the configured input range
+            void begin(float expected_range_volts, const AutoRangeConfig& config = AutoRangeConfig()) {
+                cfg = config;
+                level = levelForRange(expected_range_volts);
+                envelope = 0.0f;
+                quiet_scans = 0;
+            }
+
+            // Feed one conversion taken at the current gain; returns true if the gain changed
+            bool update(int16_t raw) {
+                const float full_scale = pgaFullScale(gainCode(level));
+                const float magnitude = fabsf(rawToVoltage(raw, gainCode(level)));
+                envelope = fmaxf(magnitude, envelope * cfg.envelope_decay);
+
+                const bool clipped = raw >= 32767 || raw <= -32768;
+                if ((clipped || envelope > cfg.upshift_fraction * full_scale) && level > 0) {
+                    level--;
+                    quiet_scans = 0;
+                    return true;
+                }
+
+                if (level + 1 < LEVELS &&
+                    envelope < cfg.downshift_fraction * pgaFullScale(gainCode(level + 1))) {
+                    if (++quiet_scans >= cfg.downshift_scans) {
+                        level++;
+                        quiet_scans = 0;
+                        return true;
+                    }
+                } else {
+                    quiet_scans = 0;
+                }
+                return false;
+            }
+
+            uint8_t getGain() const { return gainCode(level); }
+            uint8_t getLevel() const { return level; }
+            float getEnvelope() const { return envelope; }
+
+        private:
+            AutoRangeConfig cfg;
+            uint8_t level = 0;
+            uint8_t quiet_scans = 0;
+            float envelope = 0.0f;
+    };
+
+    // One blocking conversion of a decimated channel on any ADS1X15-compatible ADC:
+    // apply the PGA, read, decimate, then let auto-range react. A PGA change
+    // restarts the decimator (ranges are never mixed in one result) and is
+    // reported in range_changed. True when a decimated result is ready.
+    template <typename ADC>
+    inline bool convertDecimated(ADC& adc, const ChannelConfig& cfg, uint8_t pin, uint8_t gain,
+                                 Decimator& decimator, PgaAutoRange& range,
+                                 int16_t& raw, bool& range_changed) {
+        if (adc.getGain() != gain) adc.setGain(gain);
+        raw = readInput(adc, cfg.input, pin);
+        bool ready = decimator.push(raw);
+        range_changed = cfg.auto_range && range.update(raw);
+        if (range_changed) decimator.reset();
+        return ready;
+    }
+
+    // Runs convert() until it yields a result, at most settleConversions() + 1 times:
+    // enough for a cold decimator, bounded when auto-range keeps resetting it
+    // (a signal hovering at a PGA threshold). False when the budget ran out.
+    template <typename Convert>
+    inline bool convertBounded(const Decimator& decimator, Convert convert) {
+        uint16_t budget = decimator.settleConversions() + 1;
+        for (uint16_t n = 0; n < budget; n++) {
+            if (convert()) return true;
+        }
+        return false;
+    }
+} // namespace overseer::device::ads
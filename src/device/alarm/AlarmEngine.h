@@ -0,0 +1,150 @@
+// AlarmEngine.h
+#pragma once
+#include <math.h>
+#include <stdint.h>
+#include "EventQueue.h"
+
+namespace overseer::device::alarm {
+    enum class AlarmType : uint8_t {
+        OVER,       // value above `high` (HIGH/LOW are Arduino macros)
+        UNDER,      // value below `low`
+        RATE        // |d value / dt| above `max_rate` (units per second)
+    };
+
+    // One declarative rule against one signal. Unused limits stay NAN.
+    struct AlarmRule {
+        uint8_t signal = 0;
+        float high = NAN;
+        float low = NAN;
+        float hysteresis = 0.0f;            // clear only once back inside the limit by this much
+        float max_rate = NAN;
+        unsigned long min_duration_ms = 0;  // condition must hold this long before it is raised
+    };
+
+    struct AlarmEvent {
+        uint8_t rule = 0;
+        uint8_t signal = 0;
+        AlarmType type = AlarmType::OVER;
+        bool raised = false;                // false = cleared
+        float value = 0.0f;
+        unsigned long timestamp = 0;
+    };
+
+    // Evaluates rules inline as each sample is produced, so alarm latency is one
+    // sample period. Raise/clear transitions go to a lock-free SPSC queue that the
+    // application drains at its own pace with poll().
+    class AlarmEngine {
+        public:
+            static constexpr uint8_t MAX_RULES = 16;
+            static constexpr size_t QUEUE_SIZE = 32;
+
+        private:
+            struct Condition {
+                bool active = false;
+                bool pending = false;
+                unsigned long since = 0;
+            };
+
+            struct RuleState {
+                AlarmRule rule;
+                Condition high, low, rate;
+                bool has_last = false;
+                float last_value = 0.0f;
+                unsigned long last_time = 0;
+            };
+
+            RuleState _rules[MAX_RULES];
+            uint8_t _ruleCount = 0;
+            EventQueue<AlarmEvent, QUEUE_SIZE> _events;
+
+            void track(uint8_t index, Condition& cond, AlarmType type, bool on, bool off,
+                       float value, unsigned long now) {
+                if (cond.active) {
+                    if (off) {
+                        cond.active = false;
+                        cond.pending = false;
+                        emit(index, type, false, value, now);
+                    }
+                    return;
+                }
+
+                if (!on) {
+                    cond.pending = false;
+                    return;
+                }
+                if (!cond.pending) {
+                    cond.pending = true;
+                    cond.since = now;
+                }
+                if (now - cond.since >= _rules[index].rule.min_duration_ms) {
+                    cond.active = true;
+                    emit(index, type, true, value, now);
+                }
+            }
+
+            void emit(uint8_t index, AlarmType type, bool raised, float value, unsigned long now) {
+                AlarmEvent event;
+                event.rule = index;
+                event.signal = _rules[index].rule.signal;
+                event.type = type;
+                event.raised = raised;
+                event.value = value;
+                event.timestamp = now;
+                _events.push(event);
+            }
+
+        public:
+            // Returns the rule id, or -1 when the table is full
+            int addRule(const AlarmRule& rule) {
+                if (_ruleCount >= MAX_RULES) return -1;
+                _rules[_ruleCount] = RuleState();
+                _rules[_ruleCount].rule = rule;
+                return _ruleCount++;
+            }
+
+            void clearRules() { _ruleCount = 0; }
+            uint8_t getRuleCount() const { return _ruleCount; }
+            const AlarmRule& getRule(uint8_t id) const { return _rules[id < _ruleCount ? id : 0].rule; }
+
+            // Called from the acquisition path for every new sample of `signal`
+            void evaluate(uint8_t signal, float value, unsigned long now) {
+                for (uint8_t i = 0; i < _ruleCount; i++) {
+                    RuleState& s = _rules[i];
+                    if (s.rule.signal != signal) continue;
+                    const AlarmRule& r = s.rule;
+
+                    if (!isnan(r.high)) {
+                        track(i, s.high, AlarmType::OVER, value > r.high, value < r.high - r.hysteresis, value, now);
+                    }
+                    if (!isnan(r.low)) {
+                        track(i, s.low, AlarmType::UNDER, value < r.low, value > r.low + r.hysteresis, value, now);
+                    }
+                    if (!isnan(r.max_rate)) {
+                        if (s.has_last && now != s.last_time) {
+                            float rate = fabsf(value - s.last_value) * 1000.0f / (float)(now - s.last_time);
+                            track(i, s.rate, AlarmType::RATE, rate > r.max_rate, rate <= r.max_rate, rate, now);
+                        }
+                        s.has_last = true;
+                        s.last_value = value;
+                        s.last_time = now;
+                    }
+                }
+            }
+
+            bool isActive(uint8_t id) const {
+                if (id >= _ruleCount) return false;
+                const RuleState& s = _rules[id];
+                return s.high.active || s.low.active || s.rate.active;
+            }
+
+            uint8_t getActiveCount() const {
+                uint8_t count = 0;
+                for (uint8_t i = 0; i < _ruleCount; i++) count += isActive(i) ? 1 : 0;
+                return count;
+            }
+
+            // Consumer side
+            bool poll(AlarmEvent& event) { return _events.pop(event); }
+            uint32_t getDroppedEvents() const { return _events.dropped(); }
+    };
+} // namespace overseer::device::alarm
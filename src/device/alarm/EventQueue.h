@@ -0,0 +1,46 @@
+// EventQueue.h
+#pragma once
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace overseer::device::alarm {
+    // Single-producer / single-consumer ring buffer. The acquisition path pushes,
+    // one consumer pops; neither side ever blocks or takes a lock. When the queue
+    // is full new events are dropped and counted rather than overwriting old ones.
+    template <typename T, size_t CAPACITY>
+    class EventQueue {
+        static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "EventQueue capacity must be a power of two");
+
+        public:
+            bool push(const T& item) {
+                const size_t head = _head.load(std::memory_order_relaxed);
+                if (head - _tail.load(std::memory_order_acquire) >= CAPACITY) {
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                _items[head & (CAPACITY - 1)] = item;
+                _head.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+            bool pop(T& item) {
+                const size_t tail = _tail.load(std::memory_order_relaxed);
+                if (tail == _head.load(std::memory_order_acquire)) return false;
+                item = _items[tail & (CAPACITY - 1)];
+                _tail.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            bool empty() const { return _tail.load(std::memory_order_acquire) == _head.load(std::memory_order_acquire); }
+            size_t size() const { return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire); }
+            uint32_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+            static constexpr size_t capacity() { return CAPACITY; }
+
+        private:
+            T _items[CAPACITY];
+            std::atomic<size_t> _head{0};
+            std::atomic<size_t> _tail{0};
+            std::atomic<uint32_t> _dropped{0};
+    };
+} // namespace overseer::device::alarm
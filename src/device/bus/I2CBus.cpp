@@ -0,0 +1,329 @@
+// I2CBus.cpp
+#include "I2CBus.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <ArduinoLog.h>
+#endif
+
+#ifdef ARDUINO_ARCH_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace overseer::device::bus {
+
+#ifdef ARDUINO
+    bool WireTransport::begin(const I2CBusConfig& config) {
+        bool ok = true;
+#ifdef ARDUINO_ARCH_ESP32
+        if (config.sda >= 0 && config.scl >= 0) {
+            ok = _wire.begin(config.sda, config.scl, config.clock_hz);
+        } else {
+            ok = _wire.begin();
+        }
+#else
+        _wire.begin();
+#endif
+        _wire.setClock(config.clock_hz);
+        return ok;
+    }
+
+    bool WireTransport::readRegisters(uint8_t address, uint8_t reg, uint8_t* buffer, size_t length) {
+        _wire.beginTransmission(address);
+        _wire.write(reg);
+        if (_wire.endTransmission(false) != 0) return false;        // repeated start
+        if (_wire.requestFrom(address, length, true) != length) return false;
+        for (size_t i = 0; i < length; i++) {
+            buffer[i] = (uint8_t)_wire.read();
+        }
+        return true;
+    }
+
+    bool WireTransport::writeRegisters(uint8_t address, uint8_t reg, const uint8_t* data, size_t length) {
+        _wire.beginTransmission(address);
+        _wire.write(reg);
+        _wire.write(data, length);
+        return _wire.endTransmission() == 0;
+    }
+#endif
+
+    I2CBus::Lock::Lock(I2CBus* bus, uint8_t client) : _bus(bus), _client(client), _start_us(0) {
+        if (!_bus) return;
+        _bus->_bus_mutex.lock();
+        _start_us = micros();
+    }
+
+    I2CBus::Lock::~Lock() {
+        if (!_bus) return;
+        unsigned long elapsed = micros() - _start_us;
+        if (_client < _bus->_client_count) {
+            I2CClientStats& stats = _bus->_clients[_client];
+            stats.requests++;
+            stats.transfers++;
+            stats.bus_time_us += elapsed;
+        }
+        _bus->_bus_mutex.unlock();
+    }
+
+    I2CBus::I2CBus(I2CTransport& transport) : _transport(transport) {}
+
+    bool I2CBus::begin(const I2CBusConfig& config) {
+        _config = config;
+        if (_config.max_burst == 0 || _config.max_burst > MAX_BURST) _config.max_burst = MAX_BURST;
+
+        std::lock_guard<std::recursive_mutex> bus(_bus_mutex);
+        bool ok = _transport.begin(_config);
+#ifdef ARDUINO
+        Log.notice("I2C bus: sda=%d scl=%d clock=%lu Hz burst=%d %s" CR,
+                   _config.sda, _config.scl, (unsigned long)_config.clock_hz, _config.max_burst,
+                   ok ? "ready" : "FAILED");
+#endif
+        return ok;
+    }
+
+    I2CBusConfig I2CBus::loadConfig(const ::config::ConfigManager& config, const char* section) {
+        I2CBusConfig result;
+        result.sda = config.getInt(section, "sda", result.sda);
+        result.scl = config.getInt(section, "scl", result.scl);
+        result.clock_hz = (uint32_t)config.getInt(section, "clock", (int)result.clock_hz);
+        result.max_burst = (uint8_t)config.getInt(section, "max_burst", result.max_burst);
+        result.timeout_us = (uint32_t)config.getInt(section, "timeout_us", (int)result.timeout_us);
+        return result;
+    }
+
+    uint8_t I2CBus::addClient(const char* name, uint8_t address) {
+        if (_client_count >= MAX_CLIENTS) return 0xFF;
+        I2CClientStats& stats = _clients[_client_count];
+        stats = I2CClientStats();
+        stats.name = name;
+        stats.address = address;
+        return _client_count++;
+    }
+
+    void I2CBus::resetStats() {
+        std::lock_guard<std::recursive_mutex> bus(_bus_mutex);
+        for (uint8_t i = 0; i < _client_count; i++) {
+            const char* name = _clients[i].name;
+            uint8_t address = _clients[i].address;
+            _clients[i] = I2CClientStats();
+            _clients[i].name = name;
+            _clients[i].address = address;
+        }
+        _dropped = 0;
+    }
+
+    bool I2CBus::submit(I2CRequest& request) {
+        if (request.client >= _client_count || request.length == 0 || request.length > MAX_BURST || !request.data) {
+            request.status.store(I2CStatus::FAILED);
+            return false;
+        }
+        request.queued_us = micros();
+        request.status.store(I2CStatus::PENDING);
+        {
+            std::lock_guard<std::mutex> guard(_queue_mutex);
+            if (_queue_count >= QUEUE_SIZE) {
+                _dropped++;
+                request.status.store(I2CStatus::DROPPED);
+                return false;
+            }
+            _queue[_queue_count++] = &request;
+        }
+#ifdef ARDUINO_ARCH_ESP32
+        if (_task) xTaskNotifyGive((TaskHandle_t)_task);
+#endif
+        return true;
+    }
+
+    bool I2CBus::read(uint8_t client, uint8_t reg, uint8_t* buffer, uint8_t length) {
+        I2CRequest request;
+        request.client = client;
+        request.reg = reg;
+        request.length = length;
+        request.data = buffer;
+        if (!submit(request)) return false;
+        return waitFor(request);
+    }
+
+    bool I2CBus::write(uint8_t client, uint8_t reg, const uint8_t* data, uint8_t length) {
+        I2CRequest request;
+        request.client = client;
+        request.reg = reg;
+        request.length = length;
+        request.write = true;
+        request.data = const_cast<uint8_t*>(data);     // never written through for writes
+        if (!submit(request)) return false;
+        return waitFor(request);
+    }
+
+    size_t I2CBus::pending() const {
+        std::lock_guard<std::mutex> guard(_queue_mutex);
+        return _queue_count;
+    }
+
+    // Pops the head request plus every queued read that can share its transfer.
+    // Candidates are the same client's reads up to its next write, absorbed while
+    // they touch the running [lo, hi) range and keep it within max_burst; the
+    // scan repeats so a request bridging two others is picked up in any order.
+    size_t I2CBus::takeBurst(I2CRequest** burst, uint8_t& first_reg, uint8_t& span) {
+        std::lock_guard<std::mutex> guard(_queue_mutex);
+        if (_queue_count == 0) return 0;
+
+        I2CRequest* head = _queue[0];
+        bool taken[QUEUE_SIZE] = {true};
+        size_t count = 0;
+        burst[count++] = head;
+        unsigned lo = head->reg;
+        unsigned hi = head->reg + head->length;
+
+        bool grew = !head->write;
+        while (grew) {
+            grew = false;
+            for (size_t i = 1; i < _queue_count; i++) {
+                I2CRequest* r = _queue[i];
+                if (taken[i] || r->client != head->client) continue;
+                if (r->write) break;                                // barrier
+                unsigned r_lo = r->reg;
+                unsigned r_hi = r->reg + r->length;
+                if (r_lo > hi || r_hi < lo) continue;               // gap between the ranges
+                unsigned new_lo = r_lo < lo ? r_lo : lo;
+                unsigned new_hi = r_hi > hi ? r_hi : hi;
+                if (new_hi - new_lo > _config.max_burst) continue;
+                lo = new_lo;
+                hi = new_hi;
+                taken[i] = true;
+                burst[count++] = r;
+                grew = true;
+            }
+        }
+
+        size_t kept = 0;
+        for (size_t i = 0; i < _queue_count; i++) {
+            if (!taken[i]) _queue[kept++] = _queue[i];
+        }
+        _queue_count = kept;
+
+        first_reg = (uint8_t)lo;
+        span = (uint8_t)(hi - lo);
+        return count;
+    }
+
+    size_t I2CBus::process(size_t max_transfers) {
+        size_t ran = 0;
+        while (ran < max_transfers) {
+            I2CRequest* burst[QUEUE_SIZE];
+            uint8_t first_reg = 0;
+            uint8_t span = 0;
+            size_t count = takeBurst(burst, first_reg, span);
+            if (count == 0) break;
+
+            I2CRequest& head = *burst[0];
+            I2CClientStats& stats = _clients[head.client];
+            uint8_t scratch[MAX_BURST];
+            bool ok;
+            unsigned long start, end;
+            {
+                std::lock_guard<std::recursive_mutex> bus(_bus_mutex);
+                start = micros();
+                if (head.write) {
+                    ok = _transport.writeRegisters(stats.address, head.reg, head.data, head.length);
+                } else {
+                    ok = _transport.readRegisters(stats.address, first_reg, scratch, span);
+                }
+                end = micros();
+
+                // Stats share _bus_mutex with Lock::~Lock, which updates them from other tasks
+                stats.transfers++;
+                stats.bytes += span;
+                stats.bus_time_us += end - start;
+                if (!ok) stats.errors++;
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                I2CRequest& request = *burst[i];
+                if (ok && !request.write) {
+                    memcpy(request.data, scratch + (request.reg - first_reg), request.length);
+                }
+                complete(request, ok, end);
+            }
+            ran++;
+        }
+        return ran;
+    }
+
+    void I2CBus::complete(I2CRequest& request, bool ok, unsigned long now) {
+        {
+            std::lock_guard<std::recursive_mutex> bus(_bus_mutex);
+            I2CClientStats& stats = _clients[request.client];
+            stats.requests++;
+            uint32_t latency = (uint32_t)(now - request.queued_us);
+            if (latency > stats.max_latency_us) stats.max_latency_us = latency;
+        }
+
+        if (request.on_complete) request.on_complete(request, request.context);
+        // Last touch: a synchronous caller may return (and free the request) as soon as it sees this
+        request.status.store(ok ? I2CStatus::OK : I2CStatus::FAILED);
+    }
+
+    bool I2CBus::cancel(I2CRequest& request) {
+        std::lock_guard<std::mutex> guard(_queue_mutex);
+        for (size_t i = 0; i < _queue_count; i++) {
+            if (_queue[i] != &request) continue;
+            for (size_t j = i + 1; j < _queue_count; j++) {
+                _queue[j - 1] = _queue[j];
+            }
+            _queue_count--;
+            request.status.store(I2CStatus::DROPPED);
+            return true;
+        }
+        return false;
+    }
+
+    // Without the task the caller drains the queue itself, in order, so earlier
+    // requests from other devices still go first. With the task it waits up to
+    // timeout_us; a request still queued by then is withdrawn, one already on the
+    // wire is waited out (its transfer is bounded by max_burst).
+    bool I2CBus::waitFor(I2CRequest& request) {
+#ifdef ARDUINO_ARCH_ESP32
+        if (_task) {
+            unsigned long start = micros();
+            while (request.status.load() == I2CStatus::PENDING) {
+                if (micros() - start > _config.timeout_us && cancel(request)) break;
+                yield();
+            }
+            return request.status.load() == I2CStatus::OK;
+        }
+#endif
+        while (request.status.load() == I2CStatus::PENDING) {
+            if (process(1) == 0) break;
+        }
+        return request.status.load() == I2CStatus::OK;
+    }
+
+#ifdef ARDUINO_ARCH_ESP32
+    bool I2CBus::startTask(uint8_t priority, int core) {
+        if (_task) return true;
+        TaskHandle_t handle = nullptr;
+        if (xTaskCreatePinnedToCore(taskEntry, "i2c_bus", 3072, this, priority, &handle, core) != pdPASS) {
+            Log.warning("I2C bus: task start failed" CR);
+            return false;
+        }
+        _task = handle;
+        return true;
+    }
+
+    void I2CBus::taskEntry(void* arg) {
+        I2CBus* bus = static_cast<I2CBus*>(arg);
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            while (bus->process() > 0) {}
+        }
+    }
+#else
+    bool I2CBus::startTask(uint8_t, int) {
+        return false;
+    }
+
+    void I2CBus::taskEntry(void*) {}
+#endif
+} // namespace overseer::device::bus
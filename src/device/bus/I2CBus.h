@@ -0,0 +1,157 @@
+// I2CBus.h
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <config/ConfigManager.h>
+#ifdef ARDUINO
+#include <Wire.h>
+#endif
+
+namespace overseer::device::bus {
+
+    struct I2CBusConfig {
+        int sda = -1;                       // -1: board default pins
+        int scl = -1;
+        uint32_t clock_hz = 400000;
+        uint8_t max_burst = 32;             // bytes per merged read; bounds how long one transfer holds the bus
+        uint32_t timeout_us = 10000;        // synchronous read()/write() give up after this
+    };
+
+    enum class I2CStatus : uint8_t {
+        PENDING,
+        OK,
+        FAILED,     // NACK / short read from the transport
+        DROPPED     // queue full, never sent
+    };
+
+    // Physical bus: one register write (+ repeated-start read) per call.
+    class I2CTransport {
+        public:
+            virtual ~I2CTransport() = default;
+            virtual bool begin(const I2CBusConfig& config) = 0;
+            virtual bool readRegisters(uint8_t address, uint8_t reg, uint8_t* buffer, size_t length) = 0;
+            virtual bool writeRegisters(uint8_t address, uint8_t reg, const uint8_t* data, size_t length) = 0;
+    };
+
+#ifdef ARDUINO
+    class WireTransport : public I2CTransport {
+        public:
+            explicit WireTransport(TwoWire& wire = Wire) : _wire(wire) {}
+            bool begin(const I2CBusConfig& config) override;
+            bool readRegisters(uint8_t address, uint8_t reg, uint8_t* buffer, size_t length) override;
+            bool writeRegisters(uint8_t address, uint8_t reg, const uint8_t* data, size_t length) override;
+
+        private:
+            TwoWire& _wire;
+    };
+#endif
+
+    // One queued register transfer. Owned by the caller and must stay alive until
+    // status leaves PENDING; on_complete (optional) runs on the bus context.
+    struct I2CRequest {
+        uint8_t client = 0;
+        uint8_t reg = 0;
+        uint8_t length = 0;
+        bool write = false;
+        uint8_t* data = nullptr;
+        void (*on_complete)(I2CRequest& request, void* context) = nullptr;
+        void* context = nullptr;
+        std::atomic<I2CStatus> status{I2CStatus::PENDING};
+        unsigned long queued_us = 0;
+    };
+
+    // Per-device accounting, including time spent under Lock by libraries that
+    // talk to Wire directly.
+    struct I2CClientStats {
+        const char* name = "";
+        uint8_t address = 0;
+        uint32_t requests = 0;              // completed I2CRequests (or Lock sections)
+        uint32_t transfers = 0;             // physical transfers; < requests when reads were merged
+        uint32_t bytes = 0;
+        uint32_t errors = 0;
+        uint64_t bus_time_us = 0;
+        uint32_t max_latency_us = 0;        // queued -> completed
+    };
+
+    // Shared I2C bus manager.
+    // Devices submit register transfers to one queue; the bus side (a FreeRTOS
+    // task on ESP32, or process() from the main loop) drains it in order. Queued
+    // reads to the same device whose register ranges touch or overlap are merged
+    // into one burst of at most max_burst bytes and scattered back, so e.g. accel
+    // and gyro blocks cost one transaction. A write to a device is a barrier:
+    // nothing is merged across it. Libraries that drive Wire themselves (I2Cdev,
+    // ADS1X15) take a Lock around their calls so they never interleave with a
+    // burst, and their time is charged to their client.
+    class I2CBus {
+        public:
+            static constexpr size_t QUEUE_SIZE = 16;
+            static constexpr uint8_t MAX_CLIENTS = 8;
+            static constexpr uint8_t MAX_BURST = 128;   // ESP32 Wire buffer
+
+            // Exclusive bus access for direct Wire users; no-op when bus is null
+            class Lock {
+                public:
+                    Lock(I2CBus* bus, uint8_t client);
+                    ~Lock();
+                    Lock(const Lock&) = delete;
+                    Lock& operator=(const Lock&) = delete;
+
+                private:
+                    I2CBus* _bus;
+                    uint8_t _client;
+                    unsigned long _start_us;
+            };
+
+            explicit I2CBus(I2CTransport& transport);
+
+            bool begin(const I2CBusConfig& config = I2CBusConfig());
+            static I2CBusConfig loadConfig(const ::config::ConfigManager& config, const char* section = "i2c");
+            const I2CBusConfig& getConfig() const { return _config; }
+
+            // Returns a client id for submit()/read()/write(), or 0xFF when full
+            uint8_t addClient(const char* name, uint8_t address);
+            const I2CClientStats& getClientStats(uint8_t client) const { return _clients[client]; }
+            uint8_t getClientCount() const { return _client_count; }
+            void resetStats();
+
+            // Asynchronous: false (status DROPPED) when the queue is full
+            bool submit(I2CRequest& request);
+
+            // Synchronous helpers: queue, then wait for the bus side (or run it inline)
+            bool read(uint8_t client, uint8_t reg, uint8_t* buffer, uint8_t length);
+            bool write(uint8_t client, uint8_t reg, const uint8_t* data, uint8_t length);
+
+            // Runs up to max_transfers transfers; returns how many ran
+            size_t process(size_t max_transfers = QUEUE_SIZE);
+
+            // ESP32: drain the queue from a dedicated task, woken on submit()
+            bool startTask(uint8_t priority = 5, int core = 1);
+            bool isTaskRunning() const { return _task != nullptr; }
+
+            size_t pending() const;
+            uint32_t getDroppedCount() const { return _dropped; }
+
+        private:
+            I2CTransport& _transport;
+            I2CBusConfig _config;
+            I2CClientStats _clients[MAX_CLIENTS];
+            uint8_t _client_count = 0;
+
+            mutable std::mutex _queue_mutex;
+            std::recursive_mutex _bus_mutex;
+            I2CRequest* _queue[QUEUE_SIZE] = {nullptr};
+            size_t _queue_count = 0;
+            uint32_t _dropped = 0;
+            void* _task = nullptr;
+
+            size_t takeBurst(I2CRequest** burst, uint8_t& first_reg, uint8_t& span);
+            void complete(I2CRequest& request, bool ok, unsigned long now);
+            bool waitFor(I2CRequest& request);
+            bool cancel(I2CRequest& request);
+            static void taskEntry(void* bus);
+    };
+} // namespace overseer::device::bus
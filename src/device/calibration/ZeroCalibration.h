@@ -0,0 +1,99 @@
+// ZeroCalibration.h
+#pragma once
+#include <math.h>
+#include <stdint.h>
+
+namespace overseer::device::calibration {
+
+    // Welford running mean / variance, numerically stable in float.
+    struct Welford {
+        uint32_t count = 0;
+        float mean = 0.0f;
+        float m2 = 0.0f;
+
+        void reset() { count = 0; mean = 0.0f; m2 = 0.0f; }
+
+        void add(float x) {
+            count++;
+            float delta = x - mean;
+            mean += delta / count;
+            m2 += delta * (x - mean);
+        }
+
+        float variance() const { return count > 1 ? m2 / (count - 1) : 0.0f; }
+        float stddev() const { return sqrtf(variance()); }
+        float standardError() const { return count > 1 ? sqrtf(variance() / count) : INFINITY; }
+    };
+
+    struct ZeroCalibrationConfig {
+        uint16_t min_samples = 16;              // never stop before this many samples
+        uint16_t max_samples = 200;             // stop here and take the mean, CI reached or not
+        float tolerance = 0.001f;               // stop early once the CI half-width is below this
+        float z_score = 2.576f;                 // 99% confidence
+        float max_stddev = 0.02f;               // reject calibrations noisier than this
+        unsigned long sample_interval_ms = 10;  // spacing between samples
+    };
+
+    enum class CalibrationState : uint8_t {
+        IDLE,
+        RUNNING,
+        DONE,
+        REJECTED
+    };
+
+    // Incremental zero-point calibration: feed one sample per update() and it
+    // stops as soon as the mean is known to within the requested tolerance, or
+    // at max_samples. Only a signal noisier than max_stddev is rejected, so
+    // ordinary ADC noise (a few mV) still calibrates, just without stopping early.
+    class ZeroCalibration {
+        private:
+            ZeroCalibrationConfig cfg;
+            Welford stats;
+            CalibrationState state = CalibrationState::IDLE;
+            unsigned long last_sample_ms = 0;
+
+        public:
+            void start(const ZeroCalibrationConfig& config = ZeroCalibrationConfig()) {
+                cfg = config;
+                if (cfg.min_samples < 2) cfg.min_samples = 2;
+                if (cfg.max_samples < cfg.min_samples) cfg.max_samples = cfg.min_samples;
+                stats.reset();
+                state = CalibrationState::RUNNING;
+                last_sample_ms = 0;
+            }
+
+            void cancel() { state = CalibrationState::IDLE; }
+
+            bool isRunning() const { return state == CalibrationState::RUNNING; }
+
+            // True when the state machine wants another sample at time `now`
+            bool isDue(unsigned long now) const {
+                if (state != CalibrationState::RUNNING) return false;
+                return stats.count == 0 || (now - last_sample_ms) >= cfg.sample_interval_ms;
+            }
+
+            CalibrationState addSample(float value, unsigned long now) {
+                if (state != CalibrationState::RUNNING) return state;
+
+                stats.add(value);
+                last_sample_ms = now;
+
+                if (stats.count < cfg.min_samples) return state;
+
+                if (stats.stddev() > cfg.max_stddev) {
+                    state = CalibrationState::REJECTED;
+                } else if (cfg.z_score * stats.standardError() <= cfg.tolerance ||
+                           stats.count >= cfg.max_samples) {
+                    state = CalibrationState::DONE;
+                }
+                return state;
+            }
+
+            CalibrationState getState() const { return state; }
+            float getMean() const { return stats.mean; }
+            float getStdDev() const { return stats.stddev(); }
+            uint32_t getSampleCount() const { return stats.count; }
+            const ZeroCalibrationConfig& getConfig() const { return cfg; }
+    };
+
+} // namespace overseer::device::calibration
@@ -0,0 +1,242 @@
+// TriggerCapture.h
+#pragma once
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace overseer::device::capture {
+
+    enum class TriggerType : uint8_t {
+        NONE,
+        CROSS_ABOVE,    // crosses threshold upwards (RISING/FALLING are Arduino macros)
+        CROSS_BELOW,    // crosses threshold downwards
+        MAGNITUDE,      // |value| crosses threshold upwards (either current direction, G on any sign)
+        SLOPE,          // |dvalue/dt| rises above threshold, units per second
+        EXTERNAL        // fire()
+    };
+
+    struct TriggerConfig {
+        TriggerType type = TriggerType::NONE;
+        float threshold = 0.0f;
+        uint32_t holdoff_us = 0;        // after a capture completes, before the trigger re-arms
+    };
+
+    struct CaptureSample {
+        uint32_t t_us;
+        float value;
+    };
+
+    // A frozen capture as handed to drain(); samples[pre_count] is the trigger sample
+    struct Capture {
+        uint32_t sequence;
+        TriggerType reason;
+        uint32_t trigger_us;
+        float trigger_value;
+        uint16_t pre_count;
+        uint16_t count;
+        const CaptureSample* samples;
+    };
+
+    // Pre/post-trigger capture of one raw sample stream, oscilloscope style.
+    // A ring keeps the last `pre` samples at all times; when the trigger fires
+    // the ring is frozen into a free slot and the next `post` samples are
+    // appended, after which the slot waits for drain(). Triggers that find
+    // every slot full are counted as missed, so an undrained backlog never
+    // overwrites a capture. All buffers are allocated in configure(); push()
+    // is O(1) apart from the one ring copy when a trigger fires.
+    class TriggerCapture {
+        public:
+            bool configure(uint16_t pre, uint16_t post, uint8_t slot_count = 2) {
+                if (slot_count == 0) return false;
+                pre_len = pre;
+                post_len = post;
+                ring.assign(pre, CaptureSample{0, 0.0f});
+                slots.assign(slot_count, Slot());
+                for (Slot& s : slots) s.samples.assign((size_t)pre + 1 + post, CaptureSample{0, 0.0f});
+                reset();
+                return true;
+            }
+
+            bool isConfigured() const { return !slots.empty(); }
+
+            void setTrigger(const TriggerConfig& config) { trigger = config; }
+            const TriggerConfig& getTrigger() const { return trigger; }
+
+            // External trigger: the next pushed sample becomes the trigger sample
+            void fire() { external_pending = true; }
+
+            void push(uint32_t t_us, float value) {
+                if (slots.empty()) return;
+
+                if (collecting >= 0) {
+                    Slot& slot = slots[collecting];
+                    slot.samples[slot.count++] = {t_us, value};
+                    if (slot.count == slot.pre_count + 1 + post_len) complete(slot, t_us);
+                } else {
+                    TriggerType reason = evaluate(t_us, value);
+                    if (reason != TriggerType::NONE) start(reason, t_us, value);
+                }
+
+                if (pre_len > 0) {
+                    ring[ring_head] = {t_us, value};
+                    ring_head = (ring_head + 1) % pre_len;
+                    if (ring_count < pre_len) ring_count++;
+                }
+                prev = {t_us, value};
+                has_prev = true;
+            }
+
+            bool isCollecting() const { return collecting >= 0; }
+
+            size_t readyCount() const {
+                size_t n = 0;
+                for (const Slot& s : slots) n += s.state == SlotState::READY;
+                return n;
+            }
+
+            // Hands the oldest finished capture to sink(const Capture&) and frees
+            // its slot; false when nothing is ready. Call from the slow path
+            // (flash writer, telemetry) at whatever pace it can sustain.
+            template <typename Sink>
+            bool drain(Sink&& sink) {
+                Slot* oldest = nullptr;
+                for (Slot& s : slots) {
+                    if (s.state != SlotState::READY) continue;
+                    if (!oldest || (int32_t)(s.sequence - oldest->sequence) < 0) oldest = &s;
+                }
+                if (!oldest) return false;
+                Capture capture = {oldest->sequence, oldest->reason, oldest->trigger_us, oldest->trigger_value,
+                                   oldest->pre_count, oldest->count, oldest->samples.data()};
+                sink(capture);
+                oldest->state = SlotState::FREE;
+                return true;
+            }
+
+            void reset() {
+                ring_head = 0;
+                ring_count = 0;
+                for (Slot& s : slots) s.state = SlotState::FREE;
+                collecting = -1;
+                external_pending = false;
+                has_prev = false;
+                slope_over = false;
+                holdoff_until_us = 0;
+                holdoff = false;
+            }
+
+            uint16_t getPreSamples() const { return pre_len; }
+            uint16_t getPostSamples() const { return post_len; }
+            uint32_t getTriggerCount() const { return triggers; }
+            uint32_t getCaptureCount() const { return captures; }
+            uint32_t getMissedCount() const { return missed; }
+
+        private:
+            enum class SlotState : uint8_t { FREE, COLLECTING, READY };
+
+            struct Slot {
+                SlotState state = SlotState::FREE;
+                uint32_t sequence = 0;
+                TriggerType reason = TriggerType::NONE;
+                uint32_t trigger_us = 0;
+                float trigger_value = 0.0f;
+                uint16_t pre_count = 0;
+                uint16_t count = 0;
+                std::vector<CaptureSample> samples;
+            };
+
+            TriggerConfig trigger;
+            uint16_t pre_len = 0;
+            uint16_t post_len = 0;
+            std::vector<CaptureSample> ring;
+            size_t ring_head = 0;           // next write
+            size_t ring_count = 0;
+            std::vector<Slot> slots;
+            int collecting = -1;
+
+            CaptureSample prev = {0, 0.0f};
+            bool has_prev = false;
+            bool external_pending = false;
+            bool slope_over = false;
+            bool holdoff = false;
+            uint32_t holdoff_until_us = 0;
+
+            uint32_t sequence = 0;
+            uint32_t triggers = 0;
+            uint32_t captures = 0;
+            uint32_t missed = 0;
+
+            TriggerType evaluate(uint32_t t_us, float value) {
+                if (holdoff) {
+                    if ((int32_t)(t_us - holdoff_until_us) < 0) return TriggerType::NONE;
+                    holdoff = false;
+                }
+                if (external_pending) {
+                    external_pending = false;
+                    return TriggerType::EXTERNAL;
+                }
+                if (!has_prev || isnan(value) || isnan(prev.value)) return TriggerType::NONE;
+
+                const float th = trigger.threshold;
+                switch (trigger.type) {
+                    case TriggerType::CROSS_ABOVE:
+                        return (prev.value <= th && value > th) ? TriggerType::CROSS_ABOVE : TriggerType::NONE;
+                    case TriggerType::CROSS_BELOW:
+                        return (prev.value >= th && value < th) ? TriggerType::CROSS_BELOW : TriggerType::NONE;
+                    case TriggerType::MAGNITUDE:
+                        return (fabsf(prev.value) <= th && fabsf(value) > th) ? TriggerType::MAGNITUDE : TriggerType::NONE;
+                    case TriggerType::SLOPE: {
+                        uint32_t dt = t_us - prev.t_us;
+                        if (dt == 0) return TriggerType::NONE;
+                        bool over = fabsf(value - prev.value) * 1.0e6f / dt > th;
+                        bool crossed = over && !slope_over;     // edge, like the level triggers
+                        slope_over = over;
+                        return crossed ? TriggerType::SLOPE : TriggerType::NONE;
+                    }
+                    default:
+                        return TriggerType::NONE;
+                }
+            }
+
+            void start(TriggerType reason, uint32_t t_us, float value) {
+                triggers++;
+                int free_slot = -1;
+                for (size_t i = 0; i < slots.size(); i++) {
+                    if (slots[i].state == SlotState::FREE) {
+                        free_slot = (int)i;
+                        break;
+                    }
+                }
+                if (free_slot < 0) {
+                    missed++;
+                    return;
+                }
+
+                Slot& slot = slots[free_slot];
+                slot.state = SlotState::COLLECTING;
+                slot.sequence = sequence++;
+                slot.reason = reason;
+                slot.trigger_us = t_us;
+                slot.trigger_value = value;
+                size_t oldest = (ring_head + pre_len - ring_count) % (pre_len ? pre_len : 1);
+                for (size_t i = 0; i < ring_count; i++) {
+                    slot.samples[i] = ring[(oldest + i) % pre_len];
+                }
+                slot.pre_count = (uint16_t)ring_count;
+                slot.samples[ring_count] = {t_us, value};
+                slot.count = (uint16_t)(ring_count + 1);
+                collecting = free_slot;
+                if (post_len == 0) complete(slot, t_us);
+            }
+
+            void complete(Slot& slot, uint32_t t_us) {
+                slot.state = SlotState::READY;
+                collecting = -1;
+                captures++;
+                if (trigger.holdoff_us > 0) {
+                    holdoff = true;
+                    holdoff_until_us = t_us + trigger.holdoff_us;
+                }
+            }
+    };
+} // namespace overseer::device::capture
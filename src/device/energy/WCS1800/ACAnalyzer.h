@@ -0,0 +1,166 @@
+// ACAnalyzer.h
+#pragma once
+#include <math.h>
+#include <stdint.h>
+
+namespace overseer::device::energy {
+
+    struct ACConfig {
+        uint32_t sample_rate_hz = 4000;     // fixed sampling rate inside a block
+        uint16_t block_samples = 400;       // 100 ms: 5 cycles at 50 Hz, 6 at 60 Hz
+        float hysteresis = 0.1f;            // A below the centre line needed to re-arm a crossing
+        float min_frequency = 20.0f;        // cycles outside this band are discarded
+        float max_frequency = 500.0f;
+    };
+
+    // Result of one block. With no complete cycle in the block (DC load, or the
+    // signal stayed inside the hysteresis band) the figures cover every sample and
+    // frequency is 0.
+    struct ACResult {
+        float rms = 0.0f;
+        float peak = 0.0f;          // largest |sample|
+        float crest_factor = 0.0f;  // peak / rms
+        float frequency = 0.0f;     // Hz, from zero-crossing spacing
+        float dc = 0.0f;            // mean
+        uint16_t cycles = 0;
+        uint16_t samples = 0;
+    };
+
+    // Streaming per-cycle RMS / peak / crest / frequency at a fixed sample rate.
+    //
+    // Nothing is stored per sample: each sample updates running sums for the
+    // current cycle and the block. A cycle closes on a rising crossing of the DC
+    // line (the previous cycle's mean), located to a fraction of a sample by linear
+    // interpolation, so frequency resolution does not depend on the rate being a
+    // multiple of the line frequency. Hysteresis keeps noise near zero from
+    // producing extra crossings.
+    class ACAnalyzer {
+        public:
+            void configure(const ACConfig& config) {
+                cfg = config;
+                reset();
+            }
+
+            void reset() {
+                index = 0;
+                dc = 0.0f;
+                armed = false;
+                have_crossing = false;
+                have_prev = false;
+                resetCycle();
+                beginBlock();
+            }
+
+            void beginBlock() {
+                b_sum = b_sq = b_peak = 0.0f;
+                b_n = 0;
+                k_sum = k_sq = k_peak = k_period = 0.0f;
+                k_n = 0;
+                k_cycles = 0;
+            }
+
+            inline void addSample(float x) {
+                const float centred = x - dc;
+                if (have_prev && armed && centred >= 0.0f && prev_centred < 0.0f) {
+                    float frac = -prev_centred / (centred - prev_centred);
+                    onCrossing(index - 1, frac);
+                    armed = false;
+                }
+                if (centred < -cfg.hysteresis) armed = true;
+
+                float magnitude = fabsf(x);
+                c_sum += x;
+                c_sq += x * x;
+                if (magnitude > c_peak) c_peak = magnitude;
+                c_n++;
+
+                b_sum += x;
+                b_sq += x * x;
+                if (magnitude > b_peak) b_peak = magnitude;
+                b_n++;
+
+                prev_centred = centred;
+                have_prev = true;
+                index++;
+            }
+
+            // Missing sample (bad ADC read): keeps the time base, drops the open cycle
+            void skipSample() {
+                index++;
+                have_prev = false;
+                have_crossing = false;
+                armed = false;
+                resetCycle();
+            }
+
+            ACResult endBlock() {
+                ACResult r;
+                r.samples = b_n;
+                r.cycles = k_cycles;
+                if (k_cycles > 0 && k_n > 0) {
+                    r.rms = sqrtf(k_sq / k_n);
+                    r.dc = k_sum / k_n;
+                    r.peak = k_peak;
+                    r.frequency = k_period > 0.0f ? k_cycles * (float)cfg.sample_rate_hz / k_period : 0.0f;
+                } else if (b_n > 0) {
+                    r.rms = sqrtf(b_sq / b_n);
+                    r.dc = b_sum / b_n;
+                    r.peak = b_peak;
+                }
+                r.crest_factor = r.rms > 0.0f ? r.peak / r.rms : 0.0f;
+                beginBlock();
+                return r;
+            }
+
+            const ACConfig& getConfig() const { return cfg; }
+            float getDcLevel() const { return dc; }
+
+        private:
+            ACConfig cfg;
+            uint32_t index = 0;         // samples since reset
+            float dc = 0.0f;            // crossing reference, previous cycle mean
+            bool armed = false;
+            bool have_prev = false;
+            float prev_centred = 0.0f;
+
+            bool have_crossing = false;
+            uint32_t crossing_index = 0;
+            float crossing_frac = 0.0f;
+
+            // Open cycle
+            float c_sum = 0.0f, c_sq = 0.0f, c_peak = 0.0f;
+            uint16_t c_n = 0;
+
+            // Block: all samples, and complete cycles only
+            float b_sum = 0.0f, b_sq = 0.0f, b_peak = 0.0f;
+            uint16_t b_n = 0;
+            float k_sum = 0.0f, k_sq = 0.0f, k_peak = 0.0f, k_period = 0.0f;
+            uint16_t k_n = 0;
+            uint16_t k_cycles = 0;
+
+            void resetCycle() {
+                c_sum = c_sq = c_peak = 0.0f;
+                c_n = 0;
+            }
+
+            void onCrossing(uint32_t at_index, float frac) {
+                if (have_crossing && c_n > 0) {
+                    float period = (float)(at_index - crossing_index) + (frac - crossing_frac);
+                    float frequency = period > 0.0f ? cfg.sample_rate_hz / period : 0.0f;
+                    if (frequency >= cfg.min_frequency && frequency <= cfg.max_frequency) {
+                        k_sum += c_sum;
+                        k_sq += c_sq;
+                        if (c_peak > k_peak) k_peak = c_peak;
+                        k_n += c_n;
+                        k_period += period;
+                        k_cycles++;
+                        dc = c_sum / c_n;
+                    }
+                }
+                have_crossing = true;
+                crossing_index = at_index;
+                crossing_frac = frac;
+                resetCycle();
+            }
+    };
+} // namespace overseer::device::energy
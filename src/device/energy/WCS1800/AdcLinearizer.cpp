@@ -0,0 +1,81 @@
+// AdcLinearizer.cpp
+#include "AdcLinearizer.h"
+
+#if defined(ARDUINO_ARCH_ESP32) && __has_include(<esp_adc_cal.h>)
+#include <esp_adc_cal.h>
+#define WCS_HAS_ESP_ADC_CAL 1
+#endif
+
+namespace overseer::device::energy {
+
+    void AdcLinearizer::buildLinear(uint16_t adc_bits, float vcc_voltage) {
+        const float uv_per_count = vcc_voltage * 1.0e6f / ((1 << adc_bits) - 1);
+        build(adc_bits, [uv_per_count](int32_t raw) {
+            return (int32_t)(raw * uv_per_count + 0.5f);
+        });
+    }
+
+    bool AdcLinearizer::buildFromEspAdcCal(uint16_t adc_bits, uint32_t default_vref_mv) {
+    #ifdef WCS_HAS_ESP_ADC_CAL
+        esp_adc_cal_characteristics_t chars;
+        esp_adc_cal_value_t source = esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12,
+                                                              default_vref_mv, &chars);
+        Log.notice("AdcLinearizer: characterized from %s" CR,
+                   source == ESP_ADC_CAL_VAL_EFUSE_TP ? "eFuse two-point" :
+                   source == ESP_ADC_CAL_VAL_EFUSE_VREF ? "eFuse Vref" : "default Vref");
+
+        // esp_adc_cal works on 12-bit counts; rescale if the sketch reads at another width
+        const int shift_to_12 = 12 - (int)adc_bits;
+        build(adc_bits, [&chars, shift_to_12](int32_t raw) {
+            uint32_t raw12 = shift_to_12 >= 0 ? (uint32_t)raw << shift_to_12 : (uint32_t)raw >> -shift_to_12;
+            return (int32_t)esp_adc_cal_raw_to_voltage(raw12, &chars) * 1000;
+        });
+        return true;
+    #else
+        (void)adc_bits;
+        (void)default_vref_mv;
+        Log.warning("AdcLinearizer: esp_adc_cal not available on this platform" CR);
+        return false;
+    #endif
+    }
+
+    String AdcLinearizer::serialize() const {
+        char buffer[POINTS * 12 + 8];
+        int pos = snprintf(buffer, sizeof(buffer), "%u:", (unsigned)bits);
+        for (uint8_t i = 0; i < POINTS && pos < (int)sizeof(buffer); i++) {
+            pos += snprintf(buffer + pos, sizeof(buffer) - pos, i ? ",%ld" : "%ld", (long)lut[i]);
+        }
+        return String(buffer);
+    }
+
+    bool AdcLinearizer::deserialize(const char* text) {
+        if (!text || !*text) return false;
+
+        char* end = nullptr;
+        long bits = strtol(text, &end, 10);
+        if (end == text || *end != ':' || bits <= SEGMENT_BITS || bits > 16) return false;
+
+        int32_t parsed[POINTS];
+        const char* cursor = end + 1;
+        for (uint8_t i = 0; i < POINTS; i++) {
+            parsed[i] = (int32_t)strtol(cursor, &end, 10);
+            if (end == cursor) return false;
+            if (i > 0 && parsed[i] < parsed[i - 1]) return false;   // table must be monotonic
+            cursor = (*end == ',') ? end + 1 : end;
+        }
+
+        configure((uint16_t)bits);
+        memcpy(lut, parsed, sizeof(lut));
+        valid = true;
+        return true;
+    }
+
+    bool AdcLinearizer::load(const config::ConfigManager& cfg, const char* section, const char* key) {
+        return deserialize(cfg.getString(section, key, ""));
+    }
+
+    void AdcLinearizer::store(config::ConfigManager& cfg, const char* section, const char* key) const {
+        cfg.set(section, key, serialize());
+    }
+
+} // namespace overseer::device::energy
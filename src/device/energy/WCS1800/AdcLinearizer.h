@@ -0,0 +1,83 @@
+// AdcLinearizer.h
+#pragma once
+#include <config/ConfigManager.h>
+#include <stdint.h>
+
+namespace overseer::device::energy {
+    // Compact per-unit ADC linearization table.
+    // Built once at calibration time (from esp_adc_cal on target, or any raw->uV
+    // characteristic), persisted as a string, and applied per sample with one
+    // table lookup + linear interpolation between 33 breakpoints.
+    class AdcLinearizer {
+        public:
+            static constexpr uint8_t SEGMENT_BITS = 5;
+            static constexpr uint8_t SEGMENTS = 1 << SEGMENT_BITS;
+            static constexpr uint8_t POINTS = SEGMENTS + 1;
+
+            // Build the table from a raw-count -> microvolt characteristic.
+            // Only POINTS evaluations, so expensive characterizations are fine here.
+            template <typename RawToMicrovolts>
+            void build(uint16_t adc_bits, RawToMicrovolts&& characteristic) {
+                configure(adc_bits);
+                const int32_t max_count = (1 << adc_bits) - 1;
+                for (uint8_t i = 0; i < POINTS; i++) {
+                    int32_t raw = (int32_t)i << shift;
+                    if (raw > max_count) {
+                        // Last breakpoint sits one count past full scale; extrapolate the final segment
+                        int32_t prev = (int32_t)(i - 1) << shift;
+                        int32_t at_max = (int32_t)characteristic(max_count);
+                        lut[i] = at_max + (int32_t)((int64_t)(at_max - lut[i - 1]) * (raw - max_count) / (max_count - prev));
+                    } else {
+                        lut[i] = (int32_t)characteristic(raw);
+                    }
+                }
+                valid = true;
+            }
+
+            // Ideal linear mapping (what WCS1800 assumed before calibration)
+            void buildLinear(uint16_t adc_bits, float vcc_voltage);
+
+            // ESP32: sample the eFuse/two-point characterization once per breakpoint
+            bool buildFromEspAdcCal(uint16_t adc_bits, uint32_t default_vref_mv = 1100);
+
+            // Counts past the table's full scale clamp to the last segment instead of
+            // reading past lut[]; a table must still match the ADC width (see getBits())
+            inline int32_t toMicrovolts(int32_t raw) const {
+                int32_t idx = raw >> shift;
+                int32_t frac = raw & mask;
+                if (idx >= SEGMENTS) {
+                    idx = SEGMENTS - 1;
+                    frac = mask;
+                } else if (idx < 0) {
+                    idx = 0;
+                    frac = 0;
+                }
+                int32_t lo = lut[idx];
+                return lo + (int32_t)(((int64_t)(lut[idx + 1] - lo) * frac) >> shift);
+            }
+
+            bool isValid() const { return valid; }
+            uint8_t getBits() const { return bits; }
+            void clear() { valid = false; }
+            int32_t getPoint(uint8_t index) const { return index < POINTS ? lut[index] : 0; }
+
+            // Persistence: "bits:uV0,uV1,...,uV32"
+            String serialize() const;
+            bool deserialize(const char* text);
+            bool load(const config::ConfigManager& cfg, const char* section, const char* key = "adc_lut");
+            void store(config::ConfigManager& cfg, const char* section, const char* key = "adc_lut") const;
+
+        private:
+            int32_t lut[POINTS] = {0};
+            uint8_t bits = 12;
+            uint8_t shift = 7;
+            int32_t mask = 127;
+            bool valid = false;
+
+            void configure(uint16_t adc_bits) {
+                bits = (uint8_t)adc_bits;
+                shift = adc_bits > SEGMENT_BITS ? adc_bits - SEGMENT_BITS : 0;
+                mask = (1 << shift) - 1;
+            }
+    };
+} // namespace overseer::device::energy
@@ -0,0 +1,139 @@
+// EnergyMeter.cpp
+#include "EnergyMeter.h"
+
+namespace overseer::device::energy {
+
+    EnergyMeter::EnergyMeter() {
+        setWindows({60, 3600, 86400});
+    }
+
+    void EnergyMeter::addSample(float current_a, float voltage_v, unsigned long now) {
+        const int32_t ua = (int32_t)lroundf(current_a * 1.0e6f);
+        const bool has_power = isfinite(voltage_v);
+        const int64_t nw = has_power ? (int64_t)ua * (int32_t)lroundf(voltage_v * 1000.0f) : 0;
+
+        if (!persist_started) markPersisted(now);     // first interval counts from the first sample
+        voltage = voltage_v;
+        power_w = has_power ? current_a * voltage_v : 0.0f;
+        rollWindows(now);
+
+        if (has_prev) {
+            unsigned long dt = now - prev_ms;
+            if (dt > 0 && dt <= max_gap_ms) {
+                int64_t dq = ((int64_t)prev_ua + ua) * (int64_t)dt;
+                charge.add(dq, CHARGE_UNIT);
+                for (EnergyWindow& w : windows) w.charge.add(dq, CHARGE_UNIT);
+
+                if (has_power && prev_has_power) {
+                    int64_t de = (prev_nw + nw) * (int64_t)dt;
+                    energy.add(de, ENERGY_UNIT);
+                    for (EnergyWindow& w : windows) w.energy.add(de, ENERGY_UNIT);
+                }
+            }
+        }
+
+        has_prev = true;
+        prev_has_power = has_power;
+        prev_ua = ua;
+        prev_nw = nw;
+        prev_ms = now;
+    }
+
+    void EnergyMeter::rollWindows(unsigned long now) {
+        for (EnergyWindow& w : windows) {
+            if (!has_prev && w.start_ms == 0) {
+                w.start_ms = now;
+                continue;
+            }
+            const unsigned long period_ms = w.seconds * 1000UL;
+            unsigned long elapsed = now - w.start_ms;
+            if (elapsed < period_ms) continue;
+
+            // A period with no samples in between reports zero rather than the stale one
+            bool skipped = elapsed >= 2 * period_ms;
+            w.last_ah = skipped ? 0.0f : (float)(w.charge.value(CHARGE_UNIT) / 1000.0);
+            w.last_wh = skipped ? 0.0f : (float)(w.energy.value(ENERGY_UNIT) / 1000.0);
+            w.complete = true;
+            w.charge.reset();
+            w.energy.reset();
+            w.start_ms += (elapsed / period_ms) * period_ms;
+            rolled_over = true;
+        }
+    }
+
+    void EnergyMeter::resetTotals() {
+        charge.reset();
+        energy.reset();
+        for (EnergyWindow& w : windows) {
+            w.charge.reset();
+            w.energy.reset();
+            w.last_ah = 0.0f;
+            w.last_wh = 0.0f;
+            w.complete = false;
+        }
+    }
+
+    void EnergyMeter::setWindows(const std::vector<unsigned long>& seconds) {
+        windows.clear();
+        for (unsigned long s : seconds) {
+            if (s == 0) continue;
+            EnergyWindow w;
+            w.seconds = s;
+            w.start_ms = has_prev ? prev_ms : 0;
+            windows.push_back(w);
+        }
+    }
+
+    float EnergyMeter::getWindowChargeAh(size_t index) const {
+        return index < windows.size() ? (float)(windows[index].charge.value(CHARGE_UNIT) / 1000.0) : 0.0f;
+    }
+
+    float EnergyMeter::getWindowEnergyWh(size_t index) const {
+        return index < windows.size() ? (float)(windows[index].energy.value(ENERGY_UNIT) / 1000.0) : 0.0f;
+    }
+
+    String EnergyMeter::serialize() const {
+        char buffer[96];
+        snprintf(buffer, sizeof(buffer), "%lld,%lld,%lld,%lld",
+                 (long long)charge.whole, (long long)charge.frac,
+                 (long long)energy.whole, (long long)energy.frac);
+        return String(buffer);
+    }
+
+    bool EnergyMeter::deserialize(const char* text) {
+        if (!text || !*text) return false;
+
+        long long parsed[4];
+        const char* cursor = text;
+        char* end = nullptr;
+        for (uint8_t i = 0; i < 4; i++) {
+            parsed[i] = strtoll(cursor, &end, 10);
+            if (end == cursor) return false;
+            if (i < 3 && *end != ',') return false;
+            cursor = end + 1;
+        }
+        if (*end != '\0') return false;
+        if (parsed[1] <= -CHARGE_UNIT || parsed[1] >= CHARGE_UNIT) return false;
+        if (parsed[3] <= -ENERGY_UNIT || parsed[3] >= ENERGY_UNIT) return false;
+
+        charge.whole = parsed[0];
+        charge.frac = parsed[1];
+        energy.whole = parsed[2];
+        energy.frac = parsed[3];
+        return true;
+    }
+
+    bool EnergyMeter::load(const config::ConfigManager& cfg, const char* section, const char* key) {
+        return deserialize(cfg.getString(section, key, ""));
+    }
+
+    void EnergyMeter::store(config::ConfigManager& cfg, const char* section, const char* key) const {
+        cfg.set(section, key, serialize());
+    }
+
+    bool EnergyMeter::isPersistDue(unsigned long now) const {
+        if (persist_interval_ms == 0 || !persist_started) return false;
+        return now - last_persist_ms >= persist_interval_ms;
+    }
+
+} // namespace overseer::device::energy
@@ -0,0 +1,110 @@
+// EnergyMeter.h
+#pragma once
+#include <config/ConfigManager.h>
+#include <math.h>
+#include <stdint.h>
+#include <vector>
+
+namespace overseer::device::energy {
+
+    // Exact 64-bit fixed-point sum carried into whole units.
+    // Increments are integers, so totals never drift with sample count or uptime;
+    // `frac` always stays within one unit of zero.
+    struct FixedAccumulator {
+        int64_t whole = 0;
+        int64_t frac = 0;
+
+        void reset() { whole = 0; frac = 0; }
+
+        inline void add(int64_t sub_units, int64_t unit) {
+            frac += sub_units;
+            if (frac >= unit || frac <= -unit) {
+                whole += frac / unit;
+                frac %= unit;
+            }
+        }
+
+        double value(int64_t unit) const { return (double)whole + (double)frac / (double)unit; }
+    };
+
+    // Tumbling metering period: counts the running period and keeps the last complete one
+    struct EnergyWindow {
+        unsigned long seconds = 0;
+        unsigned long start_ms = 0;
+        FixedAccumulator charge;
+        FixedAccumulator energy;
+        float last_ah = 0.0f;
+        float last_wh = 0.0f;
+        bool complete = false;      // at least one full period has elapsed
+    };
+
+    // Coulomb / watt-hour counter for one current channel.
+    //
+    // Trapezoidal integration over sample timestamps in integer units: current in
+    // uA, voltage in mV, time in ms. Sums are doubled (no halving per step) and
+    // carried into whole mAh / mWh, so a 30 A, 48 V load fits for centuries.
+    // Gaps longer than max_gap_ms (dropped or invalid samples) are not bridged;
+    // the next sample starts a new segment. Totals persist through ConfigManager
+    // at a configurable interval so a reboot loses at most one interval.
+    class EnergyMeter {
+        public:
+            static constexpr int64_t CHARGE_UNIT = 2LL * 1000 * 3600000;             // 2 x uA*ms per mAh
+            static constexpr int64_t ENERGY_UNIT = 2LL * 1000000 * 3600000;          // 2 x nW*ms per mWh
+
+            EnergyMeter();
+
+            // Per sample; voltage may be NAN when no bus voltage is available (charge only)
+            void addSample(float current_a, float voltage_v, unsigned long now);
+            void resetTotals();
+            void breakSegment() { has_prev = false; }
+
+            // Configuration
+            void setWindows(const std::vector<unsigned long>& seconds);
+            void setMaxGap(unsigned long ms) { max_gap_ms = ms; }
+            void setPersistInterval(unsigned long ms) { persist_interval_ms = ms; }
+
+            // Totals
+            float getChargeAh() const { return (float)(charge.value(CHARGE_UNIT) / 1000.0); }
+            float getEnergyWh() const { return (float)(energy.value(ENERGY_UNIT) / 1000.0); }
+            float getPower() const { return power_w; }
+            float getVoltage() const { return voltage; }
+            const FixedAccumulator& getChargeAccumulator() const { return charge; }
+            const FixedAccumulator& getEnergyAccumulator() const { return energy; }
+
+            // Windows: running period so far, and the last complete period
+            size_t getWindowCount() const { return windows.size(); }
+            const EnergyWindow& getWindow(size_t index) const { return windows[index]; }
+            float getWindowChargeAh(size_t index) const;
+            float getWindowEnergyWh(size_t index) const;
+            bool takeWindowRollover() { bool r = rolled_over; rolled_over = false; return r; }
+
+            // Persistence: "charge_whole,charge_frac,energy_whole,energy_frac"
+            String serialize() const;
+            bool deserialize(const char* text);
+            bool load(const config::ConfigManager& cfg, const char* section, const char* key = "energy_totals");
+            void store(config::ConfigManager& cfg, const char* section, const char* key = "energy_totals") const;
+            bool isPersistDue(unsigned long now) const;
+            void markPersisted(unsigned long now) { last_persist_ms = now; persist_started = true; }
+
+        private:
+            FixedAccumulator charge;
+            FixedAccumulator energy;
+            std::vector<EnergyWindow> windows;
+
+            bool has_prev = false;
+            bool prev_has_power = false;
+            int32_t prev_ua = 0;
+            int64_t prev_nw = 0;
+            unsigned long prev_ms = 0;
+
+            float power_w = 0.0f;
+            float voltage = NAN;
+            unsigned long max_gap_ms = 5000;
+            unsigned long persist_interval_ms = 300000;
+            unsigned long last_persist_ms = 0;
+            bool persist_started = false;
+            bool rolled_over = false;
+
+            void rollWindows(unsigned long now);
+    };
+} // namespace overseer::device::energy
@@ -26,10 +26,13 @@ namespace overseer::device::energy {
         sensitivity = 66.0f;          // WCS1800 default: 66mV/A
         zeroCurrentVoltage = 2.5f;    // V at 0A
         vccVoltage = 5.0f;
-        adcResolution = 4096;
+        adcResolution = 12;
         calibrationOffset = 0.0f;
         smoothing_alpha = 0.1f;
         spike_threshold = 1.5f;
+        recomputeScale();
+        configureReporter();
+        configureWindows();
     }
 
     WCS1800::WCS1800(uint8_t pin) 
@@ -42,6 +45,26 @@ namespace overseer::device::energy {
         , spike_threshold(0.3f)
     {
         zeroCurrentVoltage = vccVoltage / 2.0f;
+        recomputeScale();
+        configureReporter();
+        configureWindows();
+    }
+
+    std::vector<String> WCS1800::windowLabels(const std::vector<unsigned long>& windows_sec) {
+        std::vector<String> labels;
+        labels.reserve(windows_sec.size());
+        for (unsigned long window_sec : windows_sec) labels.push_back(String(window_sec) + "s");
+        return labels;
+    }
+
+    void WCS1800::configureReporter() {
+        // Roughly one ADC count of noise per field; anything else reports every change
+        reporter.setDefaultDeadband(0.01f);
+        reporter.setDeadband("current", 0.05f);
+        reporter.setDeadband("current_smooth", 0.02f);
+        reporter.setDeadband("voltage", 0.005f);
+        reporter.setDeadband("power", 1.0f);
+        reporter.setDeadband("samples_per_second", 5.0f);
     }
 
     bool WCS1800::begin() {
@@ -49,6 +72,7 @@ namespace overseer::device::energy {
         
         configureHardware();
         loadConfiguration();
+        configureWindows();
         
         // Test ADC reading
         int testRead = analogRead(analogPin);
@@ -83,8 +107,46 @@ namespace overseer::device::energy {
         // smoothing_alpha = 0.1f; (already set in constructor) 
         // spike_threshold = 0.3f; (already set in constructor)
         
-        // Recalculate zero point based on loaded Vcc
-        zeroCurrentVoltage = vccVoltage / 2.0f;
+        // Recalculate zero point based on loaded Vcc, unless a profile or calibration fixed it
+        if (!zero_point_fixed) zeroCurrentVoltage = vccVoltage / 2.0f;
+        _data.zero_point_voltage = zeroCurrentVoltage;
+        recomputeScale();
+
+        if (config) {
+            valid_min_current = config->getFloat(config_section, "valid_min", valid_min_current);
+            valid_max_current = config->getFloat(config_section, "valid_max", valid_max_current);
+            if (config->getBool(config_section, "quantiles", false)) enableQuantiles();
+            stats::parseWindowList(config->getString(config_section, "windows", ""), current_windows);
+            loadCaptureConfig();
+            bus_voltage = config->getFloat(config_section, "bus_voltage", bus_voltage);
+            voltage_interval_ms = (unsigned long)config->getInt(config_section, "bus_voltage_interval_ms", (int)voltage_interval_ms);
+            energy_meter.setPersistInterval((unsigned long)config->getInt(config_section, "energy_persist_s", 300) * 1000UL);
+
+            ACConfig ac_cfg = ac_analyzer.getConfig();
+            ac_cfg.sample_rate_hz = config->getInt(config_section, "ac_sample_rate", ac_cfg.sample_rate_hz);
+            ac_cfg.block_samples = config->getInt(config_section, "ac_block_samples", ac_cfg.block_samples);
+            setACConfig(ac_cfg);
+            const char* mode_name = config->getString(config_section, "mode", "dc");
+            setMeasurementMode(strcasecmp(mode_name, "ac") == 0 ? MeasurementMode::AC : MeasurementMode::DC);
+
+            // Reporting: [wcs1800] report_keyframe_s=60, report_deadband=0.01, deadband_<field>=...
+            report::loadConfig(reporter, *config, config_section, _data);
+
+            if (energy_meter.load(*config, config_section)) {
+                Log.trace("WCS1800: Energy totals restored (%.3fAh, %.3fWh)" CR,
+                          energy_meter.getChargeAh(), energy_meter.getEnergyWh());
+            }
+        }
+
+        if (config && linearizer.load(*config, config_section)) {
+            if (linearizer.getBits() != adcResolution) {
+                Log.warning("WCS1800: Ignoring %d-bit ADC linearization table, ADC reads %d bits" CR,
+                            linearizer.getBits(), adcResolution);
+                linearizer.clear();
+            } else {
+                Log.trace("WCS1800: ADC linearization table loaded from [%s]" CR, config_section);
+            }
+        }
         
         Log.trace("WCS1800: Config loaded - Sens=%.1fmV/A, Vcc=%.2fV, Alpha=%.3f" CR,
                  sensitivity, vccVoltage, smoothing_alpha);
@@ -95,73 +157,109 @@ namespace overseer::device::energy {
     }
 
     void WCS1800::printWCSData(const WCSData& data) {
+        report::LineBuffer<96> line;
         Serial.println("=== WCS1800 CURRENT SENSOR DATA ===");
-        Serial.printf("Current: %.3f A (Raw: %.3f V)\n", data.current, data.voltage);
-        Serial.printf("Smooth Current: %.3f A\n", data.current_smooth);
-        Serial.printf("Lifetime Max: %.3f A (dir: %.3f A)\n", data.max_current, data.max_current_dir);
+        line.append("Current: ").appendFloat(data.current).append(" A (Raw: ").appendFloat(data.voltage).append(" V)");
+        Serial.println(line.c_str());
+        line.clear();
+        line.append("Smooth Current: ").appendFloat(data.current_smooth).append(" A");
+        Serial.println(line.c_str());
+        line.clear();
+        line.append("Lifetime Max: ").appendFloat(data.max_current).append(" A (dir: ").appendFloat(data.max_current_dir).append(" A)");
+        Serial.println(line.c_str());
         
         Serial.println("----- Calibration -----");
-        Serial.printf("Zero Point: %.3f V, Calibrated: %s\n", 
-                     data.zero_point_voltage, data.is_calibrated ? "Yes" : "No");
+        line.clear();
+        line.append("Zero Point: ").appendFloat(data.zero_point_voltage).append(" V, Calibrated: ")
+            .append(data.is_calibrated ? "Yes" : "No");
+        Serial.println(line.c_str());
         
         Serial.println("----- Stats -----");
-        Serial.printf("Samples: Total=%llu, Dropped=%llu, Bad ADC=%llu\n", 
-                     data.total_samples, data.dropped_samples, data.bad_adc_read);
-        Serial.printf("Sample Rate: %.2f Hz, Valid: %s\n", 
-                     data.samples_per_second, data.valid_reading ? "Yes" : "No");
+        line.clear();
+        line.append("Samples: Total=").appendUnsigned(data.total_samples)
+            .append(", Dropped=").appendUnsigned(data.dropped_samples)
+            .append(", Bad ADC=").appendUnsigned(data.bad_adc_read);
+        Serial.println(line.c_str());
+        line.clear();
+        line.append("Sample Rate: ").appendFloat(data.samples_per_second, 2).append(" Hz, Valid: ")
+            .append(data.valid_reading ? "Yes" : "No");
+        Serial.println(line.c_str());
         
         Serial.println("----- Config -----");
-        Serial.printf("Smoothing Alpha: %.3f, Spike Threshold: %.3f\n", 
-                     smoothing_alpha, spike_threshold);
+        line.clear();
+        line.append("Smoothing Alpha: ").appendFloat(smoothing_alpha).append(", Spike Threshold: ").appendFloat(spike_threshold);
+        Serial.println(line.c_str());
         
         Serial.println("--- Rolling Max Current Windows ---");
         for (const auto& entry : data.max_current_windows) {
-            Serial.printf(" [%s] Max Current: %.3f A\n", entry.first.c_str(), entry.second);
+            line.clear();
+            line.append(" [").append(entry.first.c_str()).append("] Max Current: ").appendFloat(entry.second).append(" A");
+            Serial.println(line.c_str());
         }
         Serial.println("====================================");
     }
 
+    report::PublishResult WCS1800::printWCSChanges(unsigned long now) {
+        return report::printChanges(reporter, _data, "WCS1800", now, Serial);
+    }
+
     void WCS1800::smoothAndFilterData(WCSData& d) {
-        // Exponential moving average
-        d.current_smooth = smoothing_alpha * d.current + (1.0f - smoothing_alpha) * d.current_smooth;
-        
-        // Spike rejection
-        if (abs(d.current_smooth - d.current) > spike_threshold) {
-            d.current_smooth = d.current;
-        }
+        // Exponential moving average with spike rejection
+        d.current_smooth = scale.smooth(d.current_smooth, d.current);
         
+        trackMaxAndWindows(d);
+    }
+
+    void WCS1800::trackMaxAndWindows(WCSData& d) {
         // Lifetime max tracking
         updateMax(d.max_current, d.max_current_dir, d.current_smooth);
         
-        // Append to historical deque
         unsigned long now = millis();
-        current_history.push_back({now, abs(d.current_smooth)});
-        
-        // Clear old samples outside the largest window
-        auto cutoff = now - current_windows.back() * 1000;
-        while (!current_history.empty() && current_history.front().first < cutoff) {
-            current_history.pop_front();
+        if (quantiles_enabled) {
+            // Instantaneous current: the tails are what the smoothed value hides
+            if (d.valid_reading) current_quantiles.add(d.current);
+            current_quantiles.advance(now);
+            if (!quantiles_published || now - last_quantile_refresh_ms >= QUANTILE_REFRESH_MS) {
+                for (size_t t = 0; t < current_quantiles.getTierCount(); t++) {
+                    d.current_quantiles[String(current_quantiles.getTierSeconds(t)) + "s"] = current_quantiles.summary(t);
+                }
+                quantiles_published = true;
+                last_quantile_refresh_ms = now;
+            }
         }
         
-        // Compute per-window max
-        d.max_current_windows.clear();
-        for (auto window_sec : current_windows) {
-            unsigned long window_start = now - window_sec * 1000;
-            float max_current = 0.0f;
-            
-            for (const auto& entry : current_history) {
-                if (entry.first >= window_start) {
-                    max_current = std::max(max_current, entry.second);
-                }
+        // Windowed max: one compare per sample; the map is refreshed when the engine
+        // folds (every tick), with entries overwritten in place
+        current_window_max.add(0, d.current_smooth);
+        if (current_window_max.advance(now)) {
+            for (size_t w = 0; w < current_window_labels.size(); w++) {
+                d.max_current_windows[current_window_labels[w]] = current_window_max.get(0, w);
             }
-            
-            String label = String(window_sec) + "s";
-            d.max_current_windows[label] = max_current;
         }
     }
 
+    void WCS1800::configureWindows() {
+        current_window_max.configure(current_windows, 1);
+        current_window_labels = windowLabels(current_windows);
+        _data.max_current_windows.clear();
+        for (const String& label : current_window_labels) _data.max_current_windows[label] = 0.0f;
+    }
+
+    bool WCS1800::setWindows(const std::vector<unsigned long>& windows_sec) {
+        if (windows_sec.empty()) return false;
+        current_windows = windows_sec;
+        std::sort(current_windows.begin(), current_windows.end());
+        current_windows.erase(std::unique(current_windows.begin(), current_windows.end()), current_windows.end());
+        configureWindows();
+        return true;
+    }
+
     void WCS1800::update() {
         if (!initialized) return;
+        if (mode == MeasurementMode::AC) {
+            sampleACSlice();
+            return;
+        }
         
         unsigned long now = millis();
         total_samples++;
@@ -175,15 +273,24 @@ namespace overseer::device::energy {
         }
         
         // Convert to voltage and current
-        _data.voltage = analogValueToVoltage(rawValue);
-        
-        // Calculate current based on voltage difference from zero point
-        float voltageDiff = _data.voltage - zeroCurrentVoltage;
-        _data.current = (voltageDiff * 1000.0f) / sensitivity; // Convert mV to A
-        _data.current += calibrationOffset; // Apply calibration
+        fixed::q16_t current_q16 = 0;
+        if (fixed_point) {
+            int32_t uv = countsToMicrovolts(rawValue);
+            current_q16 = fixed_scale.microvoltsToCurrent(uv);
+            _data.voltage = uv * 1.0e-6f;
+            _data.current = fixed::fromQ16(current_q16);
+        } else {
+            _data.voltage = analogValueToVoltage(rawValue);
+            _data.current = scale.voltageToCurrent(_data.voltage);     // zero point, mV -> A and offset folded
+        }
         
         // Validate reading
         _data.valid_reading = isValidReading(_data.current);
+        if (alarms && _data.valid_reading) {
+            alarms->evaluate(alarm_signal, _data.current, now);
+        }
+        if (_data.valid_reading) current_capture.push(micros(), _data.current);
+        updateEnergy(now);
         
         // Update sample rate calculation
         if (last_sample_time_ms > 0) {
@@ -204,10 +311,269 @@ namespace overseer::device::energy {
         _data.bad_adc_read = bad_adc_read;
         _data.samples_per_second = samples_per_second;
         _data.last_update_ms = now;
-        _data.zero_point_voltage = zeroCurrentVoltage;
         
         // Apply smoothing and filtering
+        if (fixed_point) {
+            current_smooth_q16 = fixed_scale.smooth(current_smooth_q16, current_q16);
+            _data.current_smooth = fixed::fromQ16(current_smooth_q16);
+            trackMaxAndWindows(_data);
+        } else {
+            smoothAndFilterData(_data);
+        }
+
+        stepZeroCalibration(_data.voltage, now);
+    }
+
+    // Pending zero calibration reuses the latest sample instead of blocking (DC and AC)
+    void WCS1800::stepZeroCalibration(float voltage, unsigned long now) {
+        if (zero_cal.isDue(now) &&
+            zero_cal.addSample(voltage, now) != calibration::CalibrationState::RUNNING) {
+            finishZeroCalibration();
+        }
+    }
+
+    // update() in AC mode: takes the block's samples as they fall due, never waiting for
+    // one, so a call costs at most a few conversions. A slot already a period late when
+    // update() gets to it is skipped (time base kept, open cycle dropped) and counted in
+    // dropped_samples; loops slower than the sample rate should feed ingestACBlock()
+    // from a continuous/DMA driver instead.
+    void WCS1800::sampleACSlice() {
+        const ACConfig& cfg = ac_analyzer.getConfig();
+        const uint32_t period_us = 1000000UL / cfg.sample_rate_hz;
+        uint32_t now_us = micros();
+        if (ac_index == 0) ac_block_start_us = now_us;
+
+        float voltage = NAN;
+        while (ac_index < cfg.block_samples) {
+            uint32_t due = ac_block_start_us + (uint32_t)((uint64_t)ac_index * 1000000UL / cfg.sample_rate_hz);
+            int32_t late = (int32_t)(now_us - due);
+            if (late < 0) break;
+            ac_index++;
+            if (late >= (int32_t)period_us) {
+                ac_analyzer.skipSample();
+                dropped_samples++;
+                continue;
+            }
+
+            int rawValue = analogRead(analogPin);
+            now_us = micros();
+            if (rawValue < 0) {
+                bad_adc_read++;
+                ac_analyzer.skipSample();
+                continue;
+            }
+            voltage = analogValueToVoltage(rawValue);
+            float current = rawToCurrent(rawValue);
+            ac_analyzer.addSample(current);
+            current_capture.push(due, current);
+        }
+
+        unsigned long now = millis();
+        if (ac_index >= cfg.block_samples) {
+            ac_index = 0;
+            publishACBlock(now, micros() - ac_block_start_us);
+        }
+        if (!isnan(voltage)) stepZeroCalibration(voltage, now);
+    }
+
+    void WCS1800::ingestACBlock(const int* samples, size_t count, unsigned long now) {
+        if (!initialized) return;
+        // Block timing is implied by the sample rate; the block ends at `now`
+        const uint32_t rate_hz = ac_analyzer.getConfig().sample_rate_hz;
+        const uint32_t period_us = rate_hz > 0 ? 1000000UL / rate_hz : 0;
+        const uint32_t first_us = (uint32_t)(now * 1000UL) - (uint32_t)count * period_us;
+        int last_raw = -1;
+        for (size_t i = 0; i < count; i++) {
+            if (samples[i] < 0) {
+                bad_adc_read++;
+                ac_analyzer.skipSample();
+                continue;
+            }
+            float current = rawToCurrent(samples[i]);
+            ac_analyzer.addSample(current);
+            current_capture.push(first_us + (uint32_t)i * period_us, current);
+            last_raw = samples[i];
+        }
+        ac_index = 0;
+        publishACBlock(now, 0);
+        if (last_raw >= 0) stepZeroCalibration(analogValueToVoltage(last_raw), now);
+    }
+
+    void WCS1800::publishACBlock(unsigned long now, uint32_t elapsed_us) {
+        ACResult result = ac_analyzer.endBlock();
+        total_samples += result.samples;
+
+        _data.ac_mode = true;
+        _data.ac_rms = result.rms;
+        _data.ac_peak = result.peak;
+        _data.ac_crest_factor = result.crest_factor;
+        _data.ac_frequency = result.frequency;
+        _data.ac_dc = result.dc;
+        _data.ac_cycles = result.cycles;
+
+        // Downstream stages (alarms, energy, EMA, windowed max) see the RMS value
+        _data.current = result.rms;
+        _data.valid_reading = result.samples > 0 && isValidReading(result.peak);
+        if (alarms && _data.valid_reading) {
+            alarms->evaluate(alarm_signal, _data.current, now);
+        }
+
+        samples_per_second = elapsed_us > 0 ? result.samples * 1.0e6f / elapsed_us
+                                            : (float)ac_analyzer.getConfig().sample_rate_hz;
+        last_sample_time_ms = now;
+        _data.total_samples = total_samples;
+        _data.dropped_samples = dropped_samples;
+        _data.bad_adc_read = bad_adc_read;
+        _data.samples_per_second = samples_per_second;
+        _data.last_update_ms = now;
+
+        updateEnergy(now);
         smoothAndFilterData(_data);
+        if (fixed_point) {
+            current_smooth_q16 = fixed::toQ16(_data.current_smooth);
+        }
+    }
+
+    float WCS1800::rawToCurrent(int analogValue) {
+        if (fixed_point) {
+            return fixed::fromQ16(fixed_scale.microvoltsToCurrent(countsToMicrovolts(analogValue)));
+        }
+        return scale.voltageToCurrent(analogValueToVoltage(analogValue));
+    }
+
+    void WCS1800::enableQuantiles(const std::vector<unsigned long>& tiers_sec) {
+        current_quantiles.configure(tiers_sec);
+        quantiles_enabled = true;
+        quantiles_published = false;
+        _data.current_quantiles.clear();
+    }
+
+    void WCS1800::disableQuantiles() {
+        current_quantiles.configure({});
+        quantiles_enabled = false;
+        _data.current_quantiles.clear();
+    }
+
+    bool WCS1800::enableCapture(const capture::TriggerConfig& trigger, uint16_t pre, uint16_t post, uint8_t slots) {
+        if (!current_capture.configure(pre, post, slots)) return false;
+        current_capture.setTrigger(trigger);
+        Log.notice("WCS1800: Trigger capture on pin %d, %d pre / %d post samples, %d slots" CR,
+                   analogPin, pre, post, slots);
+        return true;
+    }
+
+    void WCS1800::disableCapture() {
+        current_capture = capture::TriggerCapture();
+    }
+
+    // [wcs1800] capture_trigger = rising|falling|magnitude|slope, capture_threshold (A, or A/s
+    // for slope), capture_pre / capture_post (samples), capture_slots, capture_holdoff_ms
+    void WCS1800::loadCaptureConfig() {
+        const char* type_name = config->getString(config_section, "capture_trigger", "");
+        capture::TriggerConfig trigger;
+        if (strcasecmp(type_name, "rising") == 0) trigger.type = capture::TriggerType::CROSS_ABOVE;
+        else if (strcasecmp(type_name, "falling") == 0) trigger.type = capture::TriggerType::CROSS_BELOW;
+        else if (strcasecmp(type_name, "magnitude") == 0) trigger.type = capture::TriggerType::MAGNITUDE;
+        else if (strcasecmp(type_name, "slope") == 0) trigger.type = capture::TriggerType::SLOPE;
+        else return;
+
+        trigger.threshold = config->getFloat(config_section, "capture_threshold", 0.0f);
+        trigger.holdoff_us = (uint32_t)config->getInt(config_section, "capture_holdoff_ms", 0) * 1000UL;
+        enableCapture(trigger,
+                      (uint16_t)config->getInt(config_section, "capture_pre", 128),
+                      (uint16_t)config->getInt(config_section, "capture_post", 384),
+                      (uint8_t)config->getInt(config_section, "capture_slots", 2));
+    }
+
+    void WCS1800::setMeasurementMode(MeasurementMode new_mode) {
+        if (new_mode == mode) return;
+        mode = new_mode;
+        ac_analyzer.reset();
+        ac_index = 0;
+        _data.ac_mode = (mode == MeasurementMode::AC);
+        Log.trace("WCS1800: %s measurement mode" CR, mode == MeasurementMode::AC ? "AC" : "DC");
+    }
+
+    void WCS1800::setACConfig(const ACConfig& cfg) {
+        if (cfg.sample_rate_hz == 0 || cfg.block_samples == 0) {
+            Log.warning("WCS1800: Ignoring AC config with zero rate or block size" CR);
+            return;
+        }
+        ac_analyzer.configure(cfg);
+        ac_index = 0;
+    }
+
+    void WCS1800::updateEnergy(unsigned long now) {
+        // Integrate the unsmoothed current; invalid samples end the segment instead of being bridged
+        if (_data.valid_reading) {
+            energy_meter.addSample(_data.current, sampleBusVoltage(now), now);
+        } else {
+            energy_meter.breakSegment();
+        }
+
+        _data.bus_voltage = energy_meter.getVoltage();
+        _data.power = energy_meter.getPower();
+        _data.charge_ah = energy_meter.getChargeAh();
+        _data.energy_wh = energy_meter.getEnergyWh();
+
+        // Window maps only change on rollover, so don't rebuild them per sample
+        if (energy_meter.takeWindowRollover()) {
+            for (size_t i = 0; i < energy_meter.getWindowCount(); i++) {
+                const EnergyWindow& w = energy_meter.getWindow(i);
+                if (!w.complete) continue;
+                String label = String(w.seconds) + "s";
+                _data.charge_windows_ah[label] = w.last_ah;
+                _data.energy_windows_wh[label] = w.last_wh;
+            }
+        }
+
+        if (config && energy_meter.isPersistDue(now)) {
+            energy_save_pending = true;
+            energy_meter.markPersisted(now);
+        }
+    }
+
+    float WCS1800::sampleBusVoltage(unsigned long now) {
+        if (!read_voltage_source) return bus_voltage;
+        if (!voltage_cached || now - last_voltage_ms >= voltage_interval_ms) {
+            source_voltage = read_voltage_source(voltage_source, voltage_channel);
+            last_voltage_ms = now;
+            voltage_cached = true;
+        }
+        return source_voltage;
+    }
+
+    float WCS1800::readBusVoltage() {
+        if (read_voltage_source) {
+            return read_voltage_source(voltage_source, voltage_channel);
+        }
+        return bus_voltage;
+    }
+
+    void WCS1800::setBusVoltage(float volts) {
+        bus_voltage = volts;
+        voltage_source = nullptr;
+        read_voltage_source = nullptr;
+    }
+
+    void WCS1800::resetEnergy() {
+        energy_meter.resetTotals();
+        _data.charge_ah = 0.0f;
+        _data.energy_wh = 0.0f;
+        _data.charge_windows_ah.clear();
+        _data.energy_windows_wh.clear();
+        persistEnergy();
+    }
+
+    bool WCS1800::persistEnergy() {
+        if (!config) return false;
+        energy_save_pending = false;
+        energy_meter.store(*config, config_section);
+        return config->save();
+    }
+
+    bool WCS1800::flushEnergy() {
+        return energy_save_pending && persistEnergy();
     }
 
     float WCS1800::voltageToAnalogValue(float voltage) {
@@ -215,7 +581,17 @@ namespace overseer::device::energy {
     }
 
     float WCS1800::analogValueToVoltage(int analogValue) {
-        return (analogValue * vccVoltage) / ((1 << adcResolution) - 1);
+        if (linearizer.isValid()) {
+            return linearizer.toMicrovolts(analogValue) * 1.0e-6f;
+        }
+        return scale.toVoltage(analogValue);
+    }
+
+    int32_t WCS1800::countsToMicrovolts(int analogValue) const {
+        if (linearizer.isValid()) {
+            return linearizer.toMicrovolts(analogValue);
+        }
+        return fixed_scale.countsToMicrovolts(analogValue);
     }
 
     float WCS1800::readRawVoltage() {
@@ -240,46 +616,150 @@ namespace overseer::device::energy {
     }
 
     bool WCS1800::isValidReading(float current) {
-        // WCS1800 typical range: ±30A
-        return (current >= -35.0f && current <= 35.0f);
+        // WCS1800 typical range: ±30A, limits default to ±35A
+        return (current >= valid_min_current && current <= valid_max_current);
     }
 
-    void WCS1800::calibrateZeroPoint(uint8_t samples) {
-        Log.notice("WCS1800: Calibrating zero point with %d samples..." CR, samples);
-        float sum = 0.0f;
-        
-        for (uint8_t i = 0; i < samples; i++) {
-            sum += readRawVoltage();
-            delay(10);
+    void WCS1800::setValidRange(float min_current, float max_current) {
+        valid_min_current = min_current;
+        valid_max_current = max_current;
+    }
+
+    bool WCS1800::calibrateZeroPoint(uint8_t samples) {
+        Log.notice("WCS1800: Calibrating zero point with up to %d samples..." CR, samples);
+
+        calibration::ZeroCalibrationConfig cfg = zero_cal_config;
+        cfg.max_samples = samples;
+        if (cfg.min_samples > samples) cfg.min_samples = samples;
+        zero_cal.start(cfg);
+
+        while (zero_cal.isRunning()) {
+            zero_cal.addSample(readRawVoltage(), millis());
+            if (zero_cal.isRunning()) delay(cfg.sample_interval_ms);
         }
-        
-        zeroCurrentVoltage = sum / samples;
+        return finishZeroCalibration();
+    }
+
+    void WCS1800::startZeroCalibration() {
+        Log.notice("WCS1800: Zero point calibration started" CR);
+        zero_cal.start(zero_cal_config);
+    }
+
+    bool WCS1800::finishZeroCalibration() {
+        if (zero_cal.getState() != calibration::CalibrationState::DONE) {
+            Log.warning("WCS1800: Zero point calibration rejected (n=%d, stddev=%.4fV)" CR,
+                        zero_cal.getSampleCount(), zero_cal.getStdDev());
+            return false;
+        }
+
+        zeroCurrentVoltage = zero_cal.getMean();
+        zero_point_fixed = true;
+        recomputeScale();
         _data.is_calibrated = true;
         _data.zero_point_voltage = zeroCurrentVoltage;
+        _data.zero_point_noise = zero_cal.getStdDev();
         
         // Configuration saving disabled - use external config management
         // configManager.setFloat("wcs1800", "zero_point_voltage", zeroCurrentVoltage);
         
-        Log.notice("WCS1800: Zero point calibrated to %.3fV" CR, zeroCurrentVoltage);
+        Log.notice("WCS1800: Zero point calibrated to %.3fV after %d samples" CR,
+                   zeroCurrentVoltage, zero_cal.getSampleCount());
+        return true;
+    }
+
+    void WCS1800::setZeroCalibrationConfig(const calibration::ZeroCalibrationConfig& cfg) {
+        zero_cal_config = cfg;
+    }
+
+    bool WCS1800::isCalibrating() const {
+        return zero_cal.isRunning();
+    }
+
+    calibration::CalibrationState WCS1800::getCalibrationState() const {
+        return zero_cal.getState();
     }
 
     void WCS1800::setCalibrationOffset(float offset) {
         calibrationOffset = offset;
+        recomputeScale();
         // Configuration saving disabled - use external config management
         // configManager.setFloat("wcs1800", "calibration_offset", offset);
     }
 
     void WCS1800::setSensitivity(float sens) {
         sensitivity = sens;
+        recomputeScale();
         // Configuration saving disabled - use external config management
         // configManager.setFloat("wcs1800", "sensitivity", sens);
     }
 
+    void WCS1800::attachConfig(ConfigManager& cfg, const char* section) {
+        config = &cfg;
+        config_section = section;
+    }
+
+    void WCS1800::attachAlarms(alarm::AlarmEngine& engine, uint8_t signal) {
+        alarms = &engine;
+        alarm_signal = signal;
+    }
+
+    bool WCS1800::calibrateAdcLinearization() {
+        Log.notice("WCS1800: Building ADC linearization table..." CR);
+        if (!linearizer.buildFromEspAdcCal(adcResolution)) {
+            return false;
+        }
+
+        if (config) {
+            linearizer.store(*config, config_section);
+            config->save();
+        }
+        Log.notice("WCS1800: ADC linearization table ready (full scale %.3fV)" CR,
+                   linearizer.toMicrovolts((1 << adcResolution) - 1) * 1.0e-6f);
+        return true;
+    }
+
+    bool WCS1800::setAdcLinearization(const AdcLinearizer& table) {
+        if (table.isValid() && table.getBits() != adcResolution) {
+            Log.warning("WCS1800: Rejecting %d-bit ADC linearization table, ADC reads %d bits" CR,
+                        table.getBits(), adcResolution);
+            return false;
+        }
+        linearizer = table;
+        return true;
+    }
+
+    const AdcLinearizer& WCS1800::getAdcLinearization() const {
+        return linearizer;
+    }
+
+    void WCS1800::recomputeScale() {
+        scale.configure(vccVoltage, adcResolution, sensitivity, zeroCurrentVoltage,
+                        calibrationOffset, smoothing_alpha, spike_threshold);
+        fixed_scale.configure(vccVoltage, adcResolution, sensitivity, zeroCurrentVoltage,
+                              calibrationOffset, smoothing_alpha, spike_threshold);
+    }
+
+    void WCS1800::setFixedPointEnabled(bool enabled) {
+        if (enabled && !fixed_point) {
+            // Carry the float filter state over so the EMA doesn't restart from zero
+            current_smooth_q16 = fixed::toQ16(_data.current_smooth);
+        }
+        fixed_point = enabled;
+    }
+
+    bool WCS1800::isFixedPointEnabled() const {
+        return fixed_point;
+    }
+
     void WCS1800::setData(const WCSData& newData) {
         _data = newData;
     }
 
-    WCSData WCS1800::getData() const {
+    void WCS1800::setData(WCSData&& newData) {
+        _data = std::move(newData);
+    }
+
+    const WCSData& WCS1800::getData() const {
         return _data;
     }
 
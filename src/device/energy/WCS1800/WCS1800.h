@@ -1,11 +1,24 @@
 // WCS1800.h
 #pragma once
 #include <config/ConfigManager.h>
+#include <device_types.h>
 
 #include "WCSData.h"
+#include "WCSFixedPoint.h"
+#include "WCSProfile.h"
+#include "AdcLinearizer.h"
+#include "EnergyMeter.h"
+#include "ACAnalyzer.h"
+#include "device/calibration/ZeroCalibration.h"
+#include "device/alarm/AlarmEngine.h"
+#include "device/stats/QuantileSketch.h"
+#include "device/stats/WindowMax.h"
+#include "device/report/ChangePublisher.h"
+#include "device/report/FastFormat.h"
+#include "device/capture/TriggerCapture.h"
 #include "ADS1X15.h"
 
-#include <deque>
+#include <iterator>
 #include <map>
 #include <vector>
 #include <algorithm>
@@ -13,6 +26,11 @@
 using namespace overseer::device::energy::data;
 using namespace config;
 namespace overseer::device::energy {
+    enum class MeasurementMode : uint8_t {
+        DC,     // one sample per update(), EMA + windowed max on the instantaneous current
+        AC      // one fixed-rate block per update(), RMS/peak/crest/frequency per cycle
+    };
+
     class WCS1800 {
         private:
             bool initialized = false;
@@ -23,15 +41,79 @@ namespace overseer::device::energy {
             // Configuration parameters (loaded from config)
             float sensitivity;           // mV/A
             float zeroCurrentVoltage;    // Voltage at zero current
+            bool zero_point_fixed = false;  // explicit (profile) or calibrated zero: begin() keeps it instead of vcc/2
             float vccVoltage;            // Supply voltage
             uint16_t adcResolution;      // ADC resolution bits
             float calibrationOffset;     // Calibration offset
             float smoothing_alpha;       // Smoothing factor
             float spike_threshold;       // Spike rejection threshold
+            float valid_min_current = -35.0f;   // Plausibility limits for valid_reading (A)
+            float valid_max_current = 35.0f;
+
+            // Float pipeline factors folded from the tunables above in recomputeScale(),
+            // so a sample is a multiply-add instead of two divisions
+            profile::WCSRuntimeScale scale;
+
+            // Optional fixed-point pipeline (scale factors precomputed in recomputeScale())
+            bool fixed_point = false;
+            fixed::WCSFixedScale fixed_scale;
+            fixed::q16_t current_smooth_q16 = 0;
+
+            // Non-blocking zero-point calibration, stepped from update()
+            calibration::ZeroCalibration zero_cal;
+            calibration::ZeroCalibrationConfig zero_cal_config;
+
+            // Per-unit ADC linearization (identity until calibrated or loaded)
+            AdcLinearizer linearizer;
+            ConfigManager* config = nullptr;
+            const char* config_section = "wcs1800";
+
+            // Optional alarm engine, evaluated on every valid sample
+            alarm::AlarmEngine* alarms = nullptr;
+            uint8_t alarm_signal = 0;
+            
+            // AC analysis mode
+            MeasurementMode mode = MeasurementMode::DC;
+            ACAnalyzer ac_analyzer;
+            uint16_t ac_index = 0;              // next slot of the block update() is filling
+            uint32_t ac_block_start_us = 0;
+            
+            // Charge / energy integration; bus voltage from a constant or an analog mux channel
+            EnergyMeter energy_meter;
+            float bus_voltage = NAN;
+            void* voltage_source = nullptr;
+            int voltage_channel = 0;
+            float (*read_voltage_source)(void* source, int channel) = nullptr;
+            // A mux read is a blocking conversion (~8 ms on an ADS1115 at 128 SPS), so the
+            // source is sampled at this cadence and the cached value used in between
+            unsigned long voltage_interval_ms = 1000;
+            unsigned long last_voltage_ms = 0;
+            bool voltage_cached = false;
+            float source_voltage = NAN;
+            float sampleBusVoltage(unsigned long now);
+            // Flash writes stay out of update(); flushEnergy() does them from the slow path
+            bool energy_save_pending = false;
             
-            // Historical data for windowed max calculations
-            std::deque<std::pair<unsigned long, float>> current_history;
-            const std::vector<unsigned long> current_windows = {1, 5, 10, 15, 30, 45, 60, 300, 600, 900, 1800}; // seconds
+            // Windowed max of |current_smooth|; engine, labels and map entries are built
+            // for the configured set only ([wcs1800] windows=1,10,60), in begin()
+            std::vector<unsigned long> current_windows = {1, 5, 10, 15, 30, 45, 60, 300, 600, 900, 1800}; // seconds
+            std::vector<String> current_window_labels;      // "1s", "5s", ...
+            stats::WindowMax current_window_max;
+            void configureWindows();
+            
+            // Optional windowed quantiles of |current|; summaries refreshed at most once per second
+            stats::QuantileWindows current_quantiles;
+            bool quantiles_enabled = false;
+            bool quantiles_published = false;
+            unsigned long last_quantile_refresh_ms = 0;
+            static constexpr unsigned long QUANTILE_REFRESH_MS = 1000;
+            
+            // Publish-on-change reporting (printWCSChanges)
+            report::ChangePublisher reporter;
+            
+            // Optional pre/post-trigger capture of raw current samples
+            capture::TriggerCapture current_capture;
+            void loadCaptureConfig();
             
             // Sample tracking
             uint64_t last_sample_time_ms = 0;
@@ -46,22 +128,113 @@ namespace overseer::device::energy {
             float analogValueToVoltage(int analogValue);
             void updateMax(float &max_val, float &dir_val, float new_val);
             void loadConfiguration();
+            void recomputeScale();
+            void trackMaxAndWindows(WCSData& data);
+            int32_t countsToMicrovolts(int analogValue) const;
+            bool finishZeroCalibration();
+            void updateEnergy(unsigned long now);
+            float rawToCurrent(int analogValue);
+            void sampleACSlice();
+            void stepZeroCalibration(float voltage, unsigned long now);
+            void publishACBlock(unsigned long now, uint32_t elapsed_us);
+            void configureReporter();
+            static std::vector<String> windowLabels(const std::vector<unsigned long>& windows_sec);
             
         public:
+            static constexpr HARDWARE_DEVICE_TYPE DEVICE_TYPE = ENERGY;
+
             WCS1800(uint8_t pin);
             WCS1800();
             bool isInitialized();
             bool begin();
             void update();
             void setData(const WCSData& newData);
-            WCSData getData() const;
+            void setData(WCSData&& newData);
+            const WCSData& getData() const;    // live view, valid until the next update()/setData()
+            const WCSSample& getSample() const { return _data; }   // hot values only, 32 bytes to copy
+            template <typename Fn>
+            void visitData(Fn&& fn) const { visitFields(_data, fn); }
             void smoothAndFilterData(WCSData& data);
             void printWCSData(const WCSData& data);
+            report::PublishResult printWCSChanges(unsigned long now);    // sparse record, keyframe on interval
+            report::ChangePublisher& getReporter() { return reporter; }
             
             // Configuration methods
             void setCalibrationOffset(float offset);
             void setSensitivity(float sens);
-            void calibrateZeroPoint(uint8_t samples = 100);
+            bool calibrateZeroPoint(uint8_t samples = 100);    // blocking, stops early once converged
+            void startZeroCalibration();                       // non-blocking, runs across update() calls
+            void setZeroCalibrationConfig(const calibration::ZeroCalibrationConfig& cfg);
+            bool isCalibrating() const;
+            calibration::CalibrationState getCalibrationState() const;
+            void attachConfig(ConfigManager& cfg, const char* section = "wcs1800");
+            void attachAlarms(alarm::AlarmEngine& engine, uint8_t signal);
+            void setValidRange(float min_current, float max_current);
+            bool calibrateAdcLinearization();
+            bool setAdcLinearization(const AdcLinearizer& table);   // false when its width != ADC resolution
+            const AdcLinearizer& getAdcLinearization() const;
+            void setFixedPointEnabled(bool enabled);
+            bool isFixedPointEnabled() const;
+            template <typename Profile>
+            void applyProfile() {       // WCS1800Static<Profile> tunables, adjustable afterwards; call before begin()
+                typedef profile::WCSStaticScale<Profile> S;
+                analogPin = Profile::pin;
+                sensitivity = Profile::sensitivity_mv_per_a;
+                vccVoltage = Profile::vcc_voltage;
+                adcResolution = Profile::adc_bits;
+                if (linearizer.getBits() != adcResolution) linearizer.clear();
+                zeroCurrentVoltage = S::zero_voltage;
+                zero_point_fixed = Profile::zero_voltage >= 0.0f;
+                calibrationOffset = Profile::calibration_offset;
+                smoothing_alpha = Profile::smoothing_alpha;
+                spike_threshold = Profile::spike_threshold;
+                setValidRange(Profile::valid_min_current, Profile::valid_max_current);
+                setWindows(std::vector<unsigned long>(std::begin(Profile::windows), std::end(Profile::windows)));
+                recomputeScale();
+            }
+            
+            // Windowed quantiles (p50/p95/p99 per tier in WCSData::current_quantiles)
+            void enableQuantiles(const std::vector<unsigned long>& tiers_sec = {60, 300, 1800});
+            void disableQuantiles();
+            bool isQuantilesEnabled() const { return quantiles_enabled; }
+            const stats::QuantileWindows& getQuantiles() const { return current_quantiles; }
+            
+            // Windowed max set (seconds); applied immediately when running, else at begin()
+            bool setWindows(const std::vector<unsigned long>& windows_sec);
+            const std::vector<unsigned long>& getWindows() const { return current_windows; }
+            
+            // Trigger capture of raw current (every DC sample, every AC block sample)
+            bool enableCapture(const capture::TriggerConfig& trigger, uint16_t pre = 128, uint16_t post = 384, uint8_t slots = 2);
+            void disableCapture();
+            void fireCapture() { current_capture.fire(); }
+            capture::TriggerCapture& getCapture() { return current_capture; }
+            
+            // AC analysis
+            void setMeasurementMode(MeasurementMode new_mode);
+            MeasurementMode getMeasurementMode() const { return mode; }
+            void setACConfig(const ACConfig& cfg);
+            const ACConfig& getACConfig() const { return ac_analyzer.getConfig(); }
+            void ingestACBlock(const int* samples, size_t count, unsigned long now);   // fixed-rate block from a DMA/continuous driver
+            
+            // Energy metering
+            void setBusVoltage(float volts);                   // constant bus voltage, clears any source
+            template <typename Mux>
+            void setBusVoltageSource(Mux& mux, int channel, unsigned long interval_ms = 1000) {  // e.g. ads::MPLEX; uses getChannelScaled()
+                voltage_source = &mux;
+                voltage_channel = channel;
+                voltage_interval_ms = interval_ms;
+                voltage_cached = false;
+                read_voltage_source = [](void* source, int ch) {
+                    return static_cast<Mux*>(source)->getChannelScaled(ch);
+                };
+            }
+            float readBusVoltage();                            // direct source read, bypasses the cadence
+            void resetEnergy();
+            bool persistEnergy();                              // writes flash now
+            bool flushEnergy();                                // from the slow path: persists only when update() flagged it due
+            bool isEnergySavePending() const { return energy_save_pending; }
+            EnergyMeter& getEnergyMeter() { return energy_meter; }
+            const EnergyMeter& getEnergyMeter() const { return energy_meter; }
             
             // Direct reading methods (for manual use)
             float readRawVoltage();
@@ -70,6 +243,10 @@ namespace overseer::device::energy {
             bool isValidReading(float current);
             
             // Getters
+            float getCurrent() const { return _data.current; }
+            float getCurrentSmooth() const { return _data.current_smooth; }
+            float getMaxCurrent() const { return _data.max_current; }
+            bool isReadingValid() const { return _data.valid_reading; }
             float getSensitivity() const;
             float getZeroCurrentVoltage() const;
             uint8_t getPin() const;
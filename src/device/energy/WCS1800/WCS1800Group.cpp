@@ -0,0 +1,196 @@
+// WCS1800Group.cpp
+#include "WCS1800Group.h"
+
+using namespace overseer::device::energy::data;
+
+namespace overseer::device::energy {
+
+    WCS1800Group::WCS1800Group(const uint8_t* channel_pins, uint8_t count) {
+        for (uint8_t i = 0; i < count; i++) {
+            addChannel(channel_pins[i]);
+        }
+    }
+
+    int WCS1800Group::addChannel(uint8_t pin, float sensitivity_mv_per_a) {
+        if (channel_count >= MAX_CHANNELS) {
+            Log.error("WCS1800Group: channel limit (%d) reached" CR, MAX_CHANNELS);
+            return -1;
+        }
+        uint8_t ch = channel_count++;
+        pins[ch] = pin;
+        sensitivity[ch] = sensitivity_mv_per_a;
+        zero_voltage[ch] = vccVoltage / 2.0f;
+        offset[ch] = 0.0f;
+        recomputeScale(ch);
+        return ch;
+    }
+
+    bool WCS1800Group::begin() {
+        Log.notice("WCS1800Group::INIT - %d channels" CR, channel_count);
+        if (channel_count == 0) return false;
+
+        analogReadResolution(adcResolution);
+        analogSetAttenuation(ADC_11db);
+
+        for (uint8_t ch = 0; ch < channel_count; ch++) {
+            int testRead = analogRead(pins[ch]);
+            if (testRead < 0 || testRead > ((1 << adcResolution) - 1)) {
+                Log.error("WCS1800Group: ADC test read failed on pin %d" CR, pins[ch]);
+                return false;
+            }
+        }
+
+        windows.configure(window_seconds, channel_count);
+        initialized = true;
+        return true;
+    }
+
+    void WCS1800Group::recomputeScale(uint8_t ch) {
+        const float volts_per_count = vccVoltage / ((1 << adcResolution) - 1);
+        amps_per_count[ch] = volts_per_count * 1000.0f / sensitivity[ch];
+        amps_bias[ch] = offset[ch] - zero_voltage[ch] * 1000.0f / sensitivity[ch];
+    }
+
+    void WCS1800Group::update() {
+        if (!initialized) return;
+
+        // Sweep: all pins back to back, nothing else between conversions
+        int samples[MAX_CHANNELS];
+        for (uint8_t ch = 0; ch < channel_count; ch++) {
+            samples[ch] = analogRead(pins[ch]);
+        }
+        ingest(samples, millis());
+    }
+
+    void WCS1800Group::ingest(const int* samples, unsigned long now) {
+        if (!initialized) return;
+        const uint8_t n = channel_count;
+
+        // Sweep rate, once for the whole group
+        if (total_sweeps > 0) {
+            unsigned long delta = now - last_sweep_ms;
+            if (delta > 0) {
+                sweeps_per_second = smoothing_alpha * (1000.0f / delta) + (1.0f - smoothing_alpha) * sweeps_per_second;
+            }
+        }
+        last_sweep_ms = now;
+        total_sweeps++;
+
+        // Conversion: one multiply-add per channel
+        for (uint8_t ch = 0; ch < n; ch++) {
+            raw[ch] = samples[ch];
+            current[ch] = samples[ch] * amps_per_count[ch] + amps_bias[ch];
+        }
+
+        // Validation
+        for (uint8_t ch = 0; ch < n; ch++) {
+            bool ok = samples[ch] >= 0 && current[ch] >= valid_min_current && current[ch] <= valid_max_current;
+            if (samples[ch] < 0) bad_adc_read++;
+            valid[ch] = ok;
+        }
+
+        // EMA with spike rejection
+        const float alpha = smoothing_alpha;
+        for (uint8_t ch = 0; ch < n; ch++) {
+            if (!valid[ch]) continue;
+            float s = alpha * current[ch] + (1.0f - alpha) * current_smooth[ch];
+            current_smooth[ch] = fabsf(s - current[ch]) > spike_threshold ? current[ch] : s;
+        }
+
+        // Lifetime and windowed max
+        for (uint8_t ch = 0; ch < n; ch++) {
+            if (!valid[ch]) continue;
+            float magnitude = fabsf(current_smooth[ch]);
+            if (magnitude > max_current[ch]) {
+                max_current[ch] = magnitude;
+                max_current_dir[ch] = current_smooth[ch];
+            }
+            windows.add(ch, current_smooth[ch]);
+        }
+        windows.advance(now);
+    }
+
+    void WCS1800Group::setSensitivity(uint8_t channel, float sens) {
+        if (channel >= channel_count) return;
+        sensitivity[channel] = sens;
+        recomputeScale(channel);
+    }
+
+    void WCS1800Group::setCalibrationOffset(uint8_t channel, float offset_a) {
+        if (channel >= channel_count) return;
+        offset[channel] = offset_a;
+        recomputeScale(channel);
+    }
+
+    void WCS1800Group::setZeroVoltage(uint8_t channel, float volts) {
+        if (channel >= channel_count) return;
+        zero_voltage[channel] = volts;
+        recomputeScale(channel);
+    }
+
+    void WCS1800Group::setSmoothing(float alpha, float spike) {
+        smoothing_alpha = alpha;
+        spike_threshold = spike;
+    }
+
+    void WCS1800Group::setValidRange(float min_current, float max_current) {
+        valid_min_current = min_current;
+        valid_max_current = max_current;
+    }
+
+    void WCS1800Group::setWindows(const std::vector<unsigned long>& seconds) {
+        window_seconds = seconds;
+        if (initialized) windows.configure(window_seconds, channel_count);
+    }
+
+    bool WCS1800Group::calibrateZeroPoints(uint8_t sweeps) {
+        Log.notice("WCS1800Group: Calibrating %d zero points over %d sweeps..." CR, channel_count, sweeps);
+        const float volts_per_count = vccVoltage / ((1 << adcResolution) - 1);
+
+        for (uint8_t ch = 0; ch < channel_count; ch++) zero_stats[ch].reset();
+        for (uint8_t s = 0; s < sweeps; s++) {
+            for (uint8_t ch = 0; ch < channel_count; ch++) {
+                int value = analogRead(pins[ch]);
+                if (value >= 0) zero_stats[ch].add(value * volts_per_count);
+            }
+            delay(1);
+        }
+
+        bool all_ok = true;
+        for (uint8_t ch = 0; ch < channel_count; ch++) {
+            if (zero_stats[ch].count == 0) {
+                all_ok = false;
+                continue;
+            }
+            zero_voltage[ch] = zero_stats[ch].mean;
+            recomputeScale(ch);
+            Log.trace("WCS1800Group: CH%d zero %.3fV (stddev %.4fV)" CR,
+                      ch, zero_voltage[ch], zero_stats[ch].stddev());
+        }
+        return all_ok;
+    }
+
+    float WCS1800Group::getWindowMax(uint8_t channel, size_t window) const {
+        if (channel >= channel_count || window >= windows.getWindowCount()) return 0.0f;
+        return windows.get(channel, window);
+    }
+
+    void WCS1800Group::fillData(uint8_t channel, WCSData& data) const {
+        if (channel >= channel_count) return;
+        data.current = current[channel];
+        data.voltage = raw[channel] * (vccVoltage / ((1 << adcResolution) - 1));
+        data.current_smooth = current_smooth[channel];
+        data.max_current = max_current[channel];
+        data.max_current_dir = max_current_dir[channel];
+        data.total_samples = total_sweeps;
+        data.bad_adc_read = bad_adc_read;
+        data.samples_per_second = sweeps_per_second;
+        data.zero_point_voltage = zero_voltage[channel];
+        data.valid_reading = valid[channel];
+        data.last_update_ms = last_sweep_ms;
+        for (size_t w = 0; w < windows.getWindowCount(); w++) {
+            data.max_current_windows[String(windows.getWindowSeconds(w)) + String("s")] = windows.get(channel, w);
+        }
+    }
+
+} // namespace overseer::device::energy
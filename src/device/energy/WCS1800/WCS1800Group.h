@@ -0,0 +1,103 @@
+// WCS1800Group.h
+#pragma once
+#include <config/ConfigManager.h>
+#include <device_types.h>
+
+#include "WCSData.h"
+#include "device/calibration/ZeroCalibration.h"
+#include "device/stats/WindowMax.h"
+
+#include <vector>
+
+using namespace overseer::device::energy::data;
+namespace overseer::device::energy {
+    // Many WCS1800 sensors served by one sweep.
+    // update() reads every configured pin back to back, then runs the conversion,
+    // smoothing and window tracking as tight loops over per-channel arrays (SoA).
+    // Per-sample work is a multiply-add per channel; scale factors, the sample-rate
+    // estimate and the window bookkeeping are computed once per sweep, so the cost
+    // per sensor falls as channels are added. A DMA/continuous ADC driver can hand
+    // a whole pattern-table scan to ingest() instead.
+    class WCS1800Group {
+        public:
+            static constexpr HARDWARE_DEVICE_TYPE DEVICE_TYPE = ENERGY;
+            static constexpr uint8_t MAX_CHANNELS = 16;
+
+        private:
+            bool initialized = false;
+            uint8_t channel_count = 0;
+
+            // Shared configuration
+            float vccVoltage = 3.3f;
+            uint16_t adcResolution = 12;
+            float smoothing_alpha = 0.1f;
+            float spike_threshold = 0.3f;
+            float valid_min_current = -35.0f;
+            float valid_max_current = 35.0f;
+
+            // Per-channel configuration
+            uint8_t pins[MAX_CHANNELS] = {0};
+            float sensitivity[MAX_CHANNELS];        // mV/A
+            float zero_voltage[MAX_CHANNELS];
+            float offset[MAX_CHANNELS];
+
+            // Precomputed per channel: current = raw * amps_per_count + amps_bias
+            float amps_per_count[MAX_CHANNELS];
+            float amps_bias[MAX_CHANNELS];
+
+            // Per-channel state
+            int raw[MAX_CHANNELS] = {0};
+            float current[MAX_CHANNELS] = {0};
+            float current_smooth[MAX_CHANNELS] = {0};
+            float max_current[MAX_CHANNELS] = {0};
+            float max_current_dir[MAX_CHANNELS] = {0};
+            bool valid[MAX_CHANNELS] = {false};
+            calibration::Welford zero_stats[MAX_CHANNELS];
+
+            // Shared window engine and sweep statistics
+            stats::WindowMax windows;
+            std::vector<unsigned long> window_seconds = {1, 5, 10, 15, 30, 45, 60, 300, 600, 900, 1800};
+            uint64_t total_sweeps = 0;
+            uint64_t bad_adc_read = 0;
+            unsigned long last_sweep_ms = 0;
+            float sweeps_per_second = 0.0f;
+
+            void recomputeScale(uint8_t channel);
+
+        public:
+            WCS1800Group() = default;
+            WCS1800Group(const uint8_t* channel_pins, uint8_t count);
+
+            // Channel setup (before begin())
+            int addChannel(uint8_t pin, float sensitivity_mv_per_a = 66.0f);
+            uint8_t getChannelCount() const { return channel_count; }
+
+            bool begin();
+            bool isInitialized() const { return initialized; }
+            void update();                                       // one sweep of every pin
+            void ingest(const int* samples, unsigned long now);  // one sweep supplied by the caller, pin order
+
+            // Configuration
+            void setSensitivity(uint8_t channel, float sens);
+            void setCalibrationOffset(uint8_t channel, float offset_a);
+            void setZeroVoltage(uint8_t channel, float volts);
+            void setSmoothing(float alpha, float spike);
+            void setValidRange(float min_current, float max_current);
+            void setWindows(const std::vector<unsigned long>& seconds);
+            bool calibrateZeroPoints(uint8_t sweeps = 100);      // all channels at once, blocking
+
+            // Per-channel access (no allocation)
+            float getCurrent(uint8_t channel) const { return channel < channel_count ? current[channel] : 0.0f; }
+            float getCurrentSmooth(uint8_t channel) const { return channel < channel_count ? current_smooth[channel] : 0.0f; }
+            float getMaxCurrent(uint8_t channel) const { return channel < channel_count ? max_current[channel] : 0.0f; }
+            bool isReadingValid(uint8_t channel) const { return channel < channel_count && valid[channel]; }
+            float getWindowMax(uint8_t channel, size_t window) const;
+            uint8_t getPin(uint8_t channel) const { return channel < channel_count ? pins[channel] : 0; }
+            const stats::WindowMax& getWindowEngine() const { return windows; }
+            float getSweepsPerSecond() const { return sweeps_per_second; }
+            uint64_t getTotalSweeps() const { return total_sweeps; }
+
+            // Compatibility: fill a WCSData (builds the window map, so not for hot paths)
+            void fillData(uint8_t channel, WCSData& data) const;
+    };
+} // namespace overseer::device::energy
@@ -0,0 +1,83 @@
+// WCS1800Static.h
+#pragma once
+#include <device_types.h>
+
+#include "WCSData.h"
+#include "WCSProfile.h"
+#include "device/stats/WindowMax.h"
+
+using namespace overseer::device::energy::data;
+namespace overseer::device::energy {
+    // WCS1800 with its configuration fixed at compile time by a profile (see
+    // WCSProfile.h): pin, conversion factors, filter coefficients, valid range
+    // and window table are constants, so update() is an analogRead plus one
+    // multiply-add, the EMA and a compare per sample. For tuning builds use
+    // WCS1800, which loads the same tunables from config at begin().
+    //
+    //   struct Bus48V : profile::WCSDefaultProfile { static constexpr uint8_t pin = 34; };
+    //   WCS1800Static<Bus48V> bus_current;
+    template <typename Profile>
+    class WCS1800Static {
+        public:
+            typedef profile::WCSStaticScale<Profile> Scale;
+            static constexpr HARDWARE_DEVICE_TYPE DEVICE_TYPE = ENERGY;
+            static constexpr size_t WINDOW_COUNT = Scale::window_count;
+
+            bool begin() {
+                analogReadResolution(Profile::adc_bits);
+                analogSetAttenuation(ADC_11db);     // 0-3.3 V input range, as WCS1800::configureHardware()
+                int test_read = analogRead(Profile::pin);
+                initialized = test_read >= 0 && test_read <= (int)Scale::max_count;
+                return initialized;
+            }
+
+            bool isInitialized() const { return initialized; }
+
+            void update() {
+                if (!initialized) return;
+                ingest(analogRead(Profile::pin), millis());
+            }
+
+            // One sample supplied by the caller (DMA/continuous drivers, benchmarks)
+            void ingest(int raw, unsigned long now) {
+                total_samples++;
+                if (raw < 0) {
+                    bad_adc_read++;
+                    _sample.valid_reading = false;
+                    return;
+                }
+                _sample.voltage = Scale::toVoltage(raw);
+                _sample.current = Scale::toCurrent(raw);
+                _sample.valid_reading = Scale::isValid(_sample.current);
+                _sample.last_update_ms = now;
+                if (!_sample.valid_reading) return;
+
+                _sample.current_smooth = Scale::smooth(_sample.current_smooth, _sample.current);
+                float magnitude = fabsf(_sample.current_smooth);
+                if (magnitude > _sample.max_current) {
+                    _sample.max_current = magnitude;
+                    _sample.max_current_dir = _sample.current_smooth;
+                }
+                windows.add(_sample.current_smooth);
+                windows.advance(now);
+            }
+
+            const WCSSample& getSample() const { return _sample; }
+            float getCurrent() const { return _sample.current; }
+            float getCurrentSmooth() const { return _sample.current_smooth; }
+            float getMaxCurrent() const { return _sample.max_current; }
+            bool isReadingValid() const { return _sample.valid_reading; }
+            float getWindowMax(size_t window) const { return window < WINDOW_COUNT ? windows.get(window) : 0.0f; }
+            static constexpr unsigned long getWindowSeconds(size_t window) { return Profile::windows[window]; }
+            uint64_t getTotalSamples() const { return total_samples; }
+            uint64_t getBadAdcReads() const { return bad_adc_read; }
+            static constexpr uint8_t getPin() { return Profile::pin; }
+
+        private:
+            bool initialized = false;
+            WCSSample _sample;
+            stats::StaticWindowMax<Profile> windows;
+            uint64_t total_samples = 0;
+            uint64_t bad_adc_read = 0;
+    };
+} // namespace overseer::device::energy
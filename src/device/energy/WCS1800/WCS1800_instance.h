@@ -1,6 +1,7 @@
 // WCS1800_instance.h
 #pragma once
 #include "WCS1800.h"
+#include "WCS1800Group.h"
 
 namespace overseer::device::energy {
 
@@ -11,4 +12,10 @@ inline WCS1800& getInstance() {
     return instance;
 }
 
+// Multi-channel boards: one group sweeps every sensor, add channels before begin()
+inline WCS1800Group& getGroupInstance() {
+    static WCS1800Group instance;
+    return instance;
+}
+
 } // namespace overseer::device::current
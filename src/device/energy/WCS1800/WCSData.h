@@ -2,35 +2,102 @@
 #pragma once
 
 #include <map>
+#include <math.h>
+#include <stdint.h>
+#include "device/stats/QuantileSketch.h"
 
 namespace overseer::device::energy::data {
-    struct WCSData {
-        // Raw measurements
+    // Hot block: the per-sample values every update() rewrites and most readers
+    // want. Exactly one 32-byte line on ESP32, at offset 0 of WCSData, so a
+    // sample touches one line and WCS1800::getSample() copies 32 bytes instead
+    // of the whole struct with its maps.
+    struct alignas(32) WCSSample {
         float current = 0.0f;           // Current in Amps
         float voltage = 0.0f;           // Raw voltage reading
         float current_smooth = 0.0f;    // Smoothed current
-        
-        // Historical max tracking
+        float power = 0.0f;             // Instantaneous power in Watts (see EnergyMeter)
         float max_current = 0.0f;       // Lifetime max current
         float max_current_dir = 0.0f;   // Direction of max current
-        
-        // Windowed max current tracking
-        std::map<String, float> max_current_windows;
-        
+        uint32_t last_update_ms = 0;    // millis() of the last sample
+        bool valid_reading = true;
+    };
+    static_assert(sizeof(WCSSample) == 32, "WCSSample must stay one 32-byte cache line");
+    static_assert(alignof(WCSSample) == 32, "WCSSample must start on a cache line");
+
+    // Cold block: read by reports rather than per sample. Only the counters,
+    // kept on the line after the hot block, change every sample; windows and
+    // analysis results change per block, per second or on calibration.
+    struct WCSData : WCSSample {
         // Sample statistics
         uint64_t total_samples = 0;
         uint64_t dropped_samples = 0;
         uint64_t bad_adc_read = 0;
         float samples_per_second = 0.0f;
         
+        // Windowed max current tracking
+        std::map<String, float> max_current_windows;
+        
+        // Windowed |current| quantiles, filled only after WCS1800::enableQuantiles()
+        std::map<String, overseer::device::stats::QuantileSummary> current_quantiles;
+        
+        // AC analysis (MeasurementMode::AC); current/current_smooth then carry RMS
+        bool ac_mode = false;
+        float ac_rms = 0.0f;            // True RMS over the complete cycles of the last block
+        float ac_peak = 0.0f;           // Largest |current| in those cycles
+        float ac_crest_factor = 0.0f;   // peak / RMS (1.414 for a clean sine)
+        float ac_frequency = 0.0f;      // Hz, 0 when no complete cycle was seen
+        float ac_dc = 0.0f;             // Mean current (DC component)
+        uint16_t ac_cycles = 0;         // Complete cycles in the last block
+        
+        // Energy metering (see EnergyMeter)
+        float bus_voltage = NAN;        // Bus voltage used for power, NAN when unknown
+        float charge_ah = 0.0f;         // Accumulated charge since reset (Ah)
+        float energy_wh = 0.0f;         // Accumulated energy since reset (Wh)
+        std::map<String, float> charge_windows_ah;  // Last complete metering period per window
+        std::map<String, float> energy_windows_wh;
+        
         // Calibration data
         float zero_point_voltage = 0.0f;
+        float zero_point_noise = 0.0f;  // Std deviation seen during the last zero calibration
         bool is_calibrated = false;
-        
-        // Sensor status
-        bool valid_reading = true;
-        unsigned long last_update_ms = 0;
     };
+
+    // Walks every numeric field without copying the struct or building Strings.
+    // fn(name, window, value): window is the max_current_windows key, nullptr for scalars.
+    template <typename Fn>
+    void visitFields(const WCSData& d, Fn&& fn) {
+        fn("current", nullptr, d.current);
+        fn("voltage", nullptr, d.voltage);
+        fn("current_smooth", nullptr, d.current_smooth);
+        fn("max_current", nullptr, d.max_current);
+        fn("max_current_dir", nullptr, d.max_current_dir);
+        for (const auto& entry : d.max_current_windows) {
+            fn("max_current", entry.first.c_str(), entry.second);
+        }
+        for (const auto& entry : d.current_quantiles) {
+            fn("current_p50", entry.first.c_str(), entry.second.p50);
+            fn("current_p95", entry.first.c_str(), entry.second.p95);
+            fn("current_p99", entry.first.c_str(), entry.second.p99);
+        }
+        fn("ac_rms", nullptr, d.ac_rms);
+        fn("ac_peak", nullptr, d.ac_peak);
+        fn("ac_crest_factor", nullptr, d.ac_crest_factor);
+        fn("ac_frequency", nullptr, d.ac_frequency);
+        fn("ac_dc", nullptr, d.ac_dc);
+        fn("bus_voltage", nullptr, d.bus_voltage);
+        fn("power", nullptr, d.power);
+        fn("charge_ah", nullptr, d.charge_ah);
+        fn("energy_wh", nullptr, d.energy_wh);
+        for (const auto& entry : d.charge_windows_ah) {
+            fn("charge_ah", entry.first.c_str(), entry.second);
+        }
+        for (const auto& entry : d.energy_windows_wh) {
+            fn("energy_wh", entry.first.c_str(), entry.second);
+        }
+        fn("samples_per_second", nullptr, d.samples_per_second);
+        fn("zero_point_voltage", nullptr, d.zero_point_voltage);
+        fn("zero_point_noise", nullptr, d.zero_point_noise);
+    }
 } // namespace overseer::device::energy::data
 
 
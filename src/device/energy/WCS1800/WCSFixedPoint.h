@@ -0,0 +1,67 @@
+// WCSFixedPoint.h
+#pragma once
+#include <stdint.h>
+
+// Fixed-point (Q16.16) conversion + filter path for the WCS1800.
+// Every division is folded into reciprocal scale factors when calibration or
+// sensitivity changes; the per-sample path is integer multiply/shift only.
+// Worst-case deviation from the float path is < 1 mA / 10 uV over the full
+// 12-bit ADC range (see test_WCS1800 fixed-point equivalence tests).
+namespace overseer::device::energy::fixed {
+
+    typedef int32_t q16_t;
+    constexpr int Q16_SHIFT = 16;
+    constexpr int32_t Q16_ONE = 1 << Q16_SHIFT;
+
+    inline q16_t toQ16(float value) {
+        return (q16_t)(value * Q16_ONE + (value >= 0.0f ? 0.5f : -0.5f));
+    }
+
+    inline float fromQ16(q16_t value) {
+        return value * (1.0f / Q16_ONE);
+    }
+
+    struct WCSFixedScale {
+        int64_t uv_per_count_q16 = 0;   // ADC count -> microvolts
+        int32_t zero_uv = 0;            // zero-current point, microvolts
+        int64_t amps_per_uv_q32 = 0;    // microvolts -> amps (Q16 result needs >> 16)
+        q16_t offset_q16 = 0;           // calibration offset, amps
+        q16_t alpha_q16 = 0;            // EMA coefficient
+        q16_t spike_q16 = 0;            // spike rejection threshold, amps
+
+        // Called off the hot path whenever any of the inputs change.
+        void configure(float vcc_voltage, uint16_t adc_bits, float sensitivity_mv_per_a,
+                       float zero_voltage, float calibration_offset,
+                       float smoothing_alpha, float spike_threshold) {
+            const float max_count = (float)((1 << adc_bits) - 1);
+            uv_per_count_q16 = (int64_t)((vcc_voltage * 1.0e6f / max_count) * Q16_ONE + 0.5f);
+            zero_uv = (int32_t)(zero_voltage * 1.0e6f + 0.5f);
+            // A per uV = 1 / (mV/A * 1000), kept with 32 fractional bits for precision
+            amps_per_uv_q32 = (int64_t)((double)Q16_ONE * Q16_ONE / (sensitivity_mv_per_a * 1000.0) + 0.5);
+            offset_q16 = toQ16(calibration_offset);
+            alpha_q16 = toQ16(smoothing_alpha);
+            spike_q16 = toQ16(spike_threshold);
+        }
+
+        inline int32_t countsToMicrovolts(int32_t counts) const {
+            return (int32_t)((counts * uv_per_count_q16) >> Q16_SHIFT);
+        }
+
+        inline q16_t microvoltsToCurrent(int32_t uv) const {
+            return (q16_t)((((int64_t)(uv - zero_uv)) * amps_per_uv_q32) >> Q16_SHIFT) + offset_q16;
+        }
+
+        inline q16_t countsToCurrent(int32_t counts) const {
+            return microvoltsToCurrent(countsToMicrovolts(counts));
+        }
+
+        // EMA + spike rejection in Q16, mirrors WCS1800::smoothAndFilterData
+        inline q16_t smooth(q16_t smoothed, q16_t current) const {
+            smoothed += (q16_t)(((int64_t)(current - smoothed) * alpha_q16) >> Q16_SHIFT);
+            q16_t diff = smoothed - current;
+            if (diff > spike_q16 || diff < -spike_q16) smoothed = current;
+            return smoothed;
+        }
+    };
+
+} // namespace overseer::device::energy::fixed
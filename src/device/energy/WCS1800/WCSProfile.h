@@ -0,0 +1,105 @@
+// WCSProfile.h
+#pragma once
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Compile-time WCS1800 configuration.
+// A profile is a struct of static constexpr tunables; WCSStaticScale<Profile>
+// folds them into one multiply-add per sample and constant filter
+// coefficients. WCSRuntimeScale has the same interface with the factors held
+// in members, for tuning builds that load them from config.
+namespace overseer::device::energy::profile {
+
+    // Defaults match WCS1800(pin). Derive and shadow only what differs:
+    //
+    //   struct BatteryShunt : WCSDefaultProfile {
+    //       static constexpr uint8_t pin = 34;
+    //       static constexpr float sensitivity_mv_per_a = 33.0f;
+    //       static constexpr unsigned long windows[] = {1, 60, 900};
+    //   };
+    struct WCSDefaultProfile {
+        static constexpr uint8_t pin = 0;
+        static constexpr float sensitivity_mv_per_a = 66.0f;
+        static constexpr float vcc_voltage = 3.3f;
+        static constexpr uint8_t adc_bits = 12;
+        static constexpr float zero_voltage = -1.0f;        // < 0: vcc_voltage / 2
+        static constexpr float calibration_offset = 0.0f;   // A
+        static constexpr float smoothing_alpha = 0.1f;
+        static constexpr float spike_threshold = 0.3f;      // A
+        static constexpr float valid_min_current = -35.0f;
+        static constexpr float valid_max_current = 35.0f;
+        static constexpr unsigned long windows[] = {1, 5, 10, 15, 30, 45, 60, 300, 600, 900, 1800};   // seconds
+    };
+
+    // current = raw * amps_per_count + amps_bias, every term a compile-time constant
+    template <typename Profile>
+    struct WCSStaticScale {
+        static_assert(Profile::adc_bits >= 1 && Profile::adc_bits <= 16, "adc_bits out of range");
+        static_assert(Profile::sensitivity_mv_per_a > 0.0f, "sensitivity must be positive");
+        static_assert(Profile::smoothing_alpha > 0.0f && Profile::smoothing_alpha <= 1.0f, "smoothing_alpha must be in (0, 1]");
+
+        static constexpr float max_count = (float)((1UL << Profile::adc_bits) - 1);
+        static constexpr float volts_per_count = Profile::vcc_voltage / max_count;
+        static constexpr float zero_voltage = Profile::zero_voltage < 0.0f ? Profile::vcc_voltage / 2.0f : Profile::zero_voltage;
+        static constexpr float amps_per_volt = 1000.0f / Profile::sensitivity_mv_per_a;
+        static constexpr float amps_per_count = volts_per_count * amps_per_volt;
+        static constexpr float amps_bias = Profile::calibration_offset - zero_voltage * 1000.0f / Profile::sensitivity_mv_per_a;
+        static constexpr float alpha = Profile::smoothing_alpha;
+        static constexpr float spike = Profile::spike_threshold;
+        static constexpr size_t window_count = sizeof(Profile::windows) / sizeof(Profile::windows[0]);
+
+        static constexpr float toVoltage(int raw) { return raw * volts_per_count; }
+        static constexpr float toCurrent(int raw) { return raw * amps_per_count + amps_bias; }
+        static constexpr float voltageToCurrent(float volts) { return volts * amps_per_volt + amps_bias; }
+
+        // EMA + spike rejection, mirrors WCS1800::smoothAndFilterData
+        static inline float smooth(float smoothed, float current) {
+            smoothed = alpha * current + (1.0f - alpha) * smoothed;
+            return fabsf(smoothed - current) > spike ? current : smoothed;
+        }
+
+        static constexpr bool isValid(float current) {
+            return current >= Profile::valid_min_current && current <= Profile::valid_max_current;
+        }
+    };
+
+    // Same arithmetic with the factors recomputed in configure(), off the hot path
+    struct WCSRuntimeScale {
+        float volts_per_count = 0.0f;
+        float amps_per_volt = 0.0f;
+        float amps_per_count = 0.0f;
+        float amps_bias = 0.0f;
+        float alpha = 0.1f;
+        float spike = 0.3f;
+
+        void configure(float vcc_voltage, uint16_t adc_bits, float sensitivity_mv_per_a,
+                       float zero_voltage, float calibration_offset,
+                       float smoothing_alpha, float spike_threshold) {
+            volts_per_count = vcc_voltage / (float)((1UL << adc_bits) - 1);
+            amps_per_volt = 1000.0f / sensitivity_mv_per_a;
+            amps_per_count = volts_per_count * amps_per_volt;
+            amps_bias = calibration_offset - zero_voltage * 1000.0f / sensitivity_mv_per_a;
+            alpha = smoothing_alpha;
+            spike = spike_threshold;
+        }
+
+        template <typename Profile>
+        void configure() {
+            typedef WCSStaticScale<Profile> S;
+            configure(Profile::vcc_voltage, Profile::adc_bits, Profile::sensitivity_mv_per_a,
+                      S::zero_voltage, Profile::calibration_offset,
+                      Profile::smoothing_alpha, Profile::spike_threshold);
+        }
+
+        inline float toVoltage(int raw) const { return raw * volts_per_count; }
+        inline float toCurrent(int raw) const { return raw * amps_per_count + amps_bias; }
+        inline float voltageToCurrent(float volts) const { return volts * amps_per_volt + amps_bias; }
+
+        inline float smooth(float smoothed, float current) const {
+            smoothed = alpha * current + (1.0f - alpha) * smoothed;
+            return fabsf(smoothed - current) > spike ? current : smoothed;
+        }
+    };
+
+} // namespace overseer::device::energy::profile
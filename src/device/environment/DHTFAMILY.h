@@ -3,9 +3,12 @@
 #include <deque>
 #include <map>
 #include <vector>
+#include <device_types.h>
+#include "device/stats/QuantileSketch.h"
 #include "device/BaseSensorDevice.h"
 //#include "../BaseSensorDevice.h"  // The base class we designed
 #include "DHTDATA.h"
+#include "DHTReader.h"
 #include <Adafruit_Sensor.h>
 #include <DHT.h>
 #include <DHT_U.h>
@@ -19,11 +22,20 @@ namespace overseer::device::environment {
         DHT _dht;
         uint8_t _pin;
         uint8_t _dhttype;
+
+        // Edge-capture reader (default); the DHT library path blocks ~5 ms with interrupts off
+        dht::DHTReader _reader;
+        bool nonblocking = true;
         
         // Historical data for windowed analysis
         std::deque<std::pair<unsigned long, float>> humidity_history;
         std::deque<std::pair<unsigned long, float>> temperature_history;
         
+        // Optional windowed quantiles (DHTDATA has no slot for them yet: read via getters)
+        stats::QuantileWindows temperature_quantiles;
+        stats::QuantileWindows humidity_quantiles;
+        bool quantiles_enabled = false;
+        
         // DHT-specific configuration
         unsigned long read_interval_ms = 2000;  // DHT sensors need 2s between reads
         unsigned long last_read_attempt = 0;
@@ -35,6 +47,7 @@ namespace overseer::device::environment {
         }
         
         bool readSensorData() override {
+            if (nonblocking) return readSensorDataAsync();
             unsigned long current_time = millis();
             
             // DHT sensors require minimum 2s between readings
@@ -46,7 +59,34 @@ namespace overseer::device::environment {
             
             float h = _dht.readHumidity();
             float t = _dht.readTemperature();
+            return applyReading(h, t, current_time);
+        }
+        
+        // One poll per call: starts a transaction when due, publishes it when the frame is in.
+        // The reader ends the start signal itself, so the update() period does not stretch it
+        bool readSensorDataAsync() {
+            unsigned long current_time = millis();
             
+            if (_reader.isBusy()) {
+                dht::DHTStatus status = _reader.poll(micros());
+                if (status == dht::DHTStatus::BUSY) return false;
+                const dht::DHTReading& reading = _reader.getReading();
+                if (!reading.ok()) {
+                    bad_reads++;
+                    return false;
+                }
+                return applyReading(reading.humidity, reading.temperature, current_time);
+            }
+            
+            // DHT sensors require minimum 2s between readings
+            if (current_time - last_read_attempt >= read_interval_ms) {
+                last_read_attempt = current_time;
+                _reader.start(micros());
+            }
+            return false;
+        }
+        
+        bool applyReading(float h, float t, unsigned long current_time) {
             // Check if reads are valid
             if (isnan(h) || isnan(t)) {
                 bad_reads++;
@@ -75,6 +115,13 @@ namespace overseer::device::environment {
             updateWindowedMax(humidity_history, _data.max_humidity_windows, current_time);
             updateWindowedMax(temperature_history, _data.max_temperature_windows, current_time);
             
+            if (quantiles_enabled) {
+                temperature_quantiles.add(_data.temperature);
+                humidity_quantiles.add(_data.humidity);
+                temperature_quantiles.advance(current_time);
+                humidity_quantiles.advance(current_time);
+            }
+            
             // Update lifetime max values
             updateMax(_data.max_humidity, _data.max_humidity, _data.humidity);
             updateMax(_data.max_temperature, _data.max_temperature, _data.temperature);
@@ -88,9 +135,12 @@ namespace overseer::device::environment {
         }
         
     public:
-        DHTFAMILY() : _dht(2, DHT11), _pin(2), _dhttype(DHT11) {}
-        DHTFAMILY(uint8_t pin, uint8_t dhttype) : _dht(pin, dhttype), _pin(pin), _dhttype(dhttype) {}
-        DHTFAMILY(uint8_t pin) : _dht(pin, DHT11), _pin(pin), _dhttype(DHT11) {}
+        static constexpr HARDWARE_DEVICE_TYPE DEVICE_TYPE = ENVIRONMENT;
+
+        DHTFAMILY() : _dht(2, DHT11), _pin(2), _dhttype(DHT11), _reader(dht::DHTGpioPin{2}, DHT11) {}
+        DHTFAMILY(uint8_t pin, uint8_t dhttype)
+            : _dht(pin, dhttype), _pin(pin), _dhttype(dhttype), _reader(dht::DHTGpioPin{pin}, dhttype) {}
+        DHTFAMILY(uint8_t pin) : _dht(pin, DHT11), _pin(pin), _dhttype(DHT11), _reader(dht::DHTGpioPin{pin}, DHT11) {}
         
         void smoothAndFilterData(DHTDATA& data) override {
             // Apply smoothing to humidity and temperature
@@ -122,5 +172,21 @@ namespace overseer::device::environment {
         void setReadInterval(unsigned long interval_ms) { read_interval_ms = interval_ms; }
         unsigned long getReadInterval() { return read_interval_ms; }
         unsigned long getLastReadAttempt() { return last_read_attempt; }
+        void setNonBlocking(bool enabled) { nonblocking = enabled; }    // false: DHT library reads
+        bool isNonBlocking() const { return nonblocking; }
+        dht::DHTStatus getLastStatus() const { return _reader.getReading().status; }
+        
+        // Windowed quantiles; temperature is signed so sub-zero readings keep their sign
+        void enableQuantiles(const std::vector<unsigned long>& tiers_sec = {60, 300, 1800}) {
+            temperature_quantiles.configure(tiers_sec, -4, true);
+            humidity_quantiles.configure(tiers_sec, -4);
+            quantiles_enabled = true;
+        }
+        stats::QuantileSummary getTemperatureQuantiles(size_t tier) const {
+            return tier < temperature_quantiles.getTierCount() ? temperature_quantiles.summary(tier) : stats::QuantileSummary();
+        }
+        stats::QuantileSummary getHumidityQuantiles(size_t tier) const {
+            return tier < humidity_quantiles.getTierCount() ? humidity_quantiles.summary(tier) : stats::QuantileSummary();
+        }
     };
 }
@@ -0,0 +1,248 @@
+// DHTReader.h
+#pragma once
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+#include <esp_timer.h>
+#endif
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+namespace overseer::device::environment::dht {
+
+    // Sensor families by wire format (values match DHT.h)
+    constexpr uint8_t TYPE_DHT11 = 11;
+    constexpr uint8_t TYPE_DHT12 = 12;
+    constexpr uint8_t TYPE_DHT21 = 21;
+    constexpr uint8_t TYPE_DHT22 = 22;
+
+    constexpr size_t FRAME_BITS = 40;
+    constexpr size_t FRAME_EDGES = 84;          // response low/high/low, 40 x (high, low), release
+    constexpr size_t MAX_EDGES = 96;            // room for a release edge and glitches
+    constexpr uint32_t BIT_ONE_MIN_US = 48;     // data high time: ~26 us = 0, ~70 us = 1
+    constexpr uint32_t BIT_MAX_US = 100;        // a longer high pulse means an edge was lost
+    constexpr uint32_t CAPTURE_TIMEOUT_US = 10000;
+    constexpr uint32_t MAX_WAIT_START_US = 2000;    // start signals up to this long are held inside start()
+
+    enum class DHTStatus : uint8_t {
+        OK,
+        BUSY,           // transaction in flight
+        NO_RESPONSE,    // no pulses at all
+        INCOMPLETE,     // fewer than 40 data bits
+        TIMING,         // a data pulse out of spec
+        CHECKSUM
+    };
+
+    struct DHTEdge {
+        uint32_t us;
+        uint8_t level;      // line level after the edge
+    };
+
+    struct DHTReading {
+        DHTStatus status = DHTStatus::NO_RESPONSE;
+        float humidity = NAN;
+        float temperature = NAN;
+        uint8_t bytes[5] = {0};
+        bool ok() const { return status == DHTStatus::OK; }
+    };
+
+    // Pure decoder over captured edges. Data bits are high pulses, so the frame
+    // is the last 40 high pulses: a host release edge or the 80 us response
+    // pulse ahead of them is skipped without needing to be recognised.
+    inline DHTStatus decodeFrame(const DHTEdge* edges, size_t count, uint8_t bytes[5]) {
+        uint32_t widths[FRAME_BITS];
+        size_t highs = 0;
+        for (size_t i = 0; i + 1 < count; i++) {
+            if (edges[i].level == 0 || edges[i + 1].level != 0) continue;
+            widths[highs % FRAME_BITS] = edges[i + 1].us - edges[i].us;
+            highs++;
+        }
+        if (highs == 0) return DHTStatus::NO_RESPONSE;
+        if (highs < FRAME_BITS) return DHTStatus::INCOMPLETE;
+
+        for (size_t b = 0; b < 5; b++) bytes[b] = 0;
+        for (size_t bit = 0; bit < FRAME_BITS; bit++) {
+            uint32_t width = widths[(highs + bit) % FRAME_BITS];      // oldest first
+            if (width > BIT_MAX_US) return DHTStatus::TIMING;
+            bytes[bit / 8] = (uint8_t)((bytes[bit / 8] << 1) | (width >= BIT_ONE_MIN_US ? 1 : 0));
+        }
+        uint8_t sum = (uint8_t)(bytes[0] + bytes[1] + bytes[2] + bytes[3]);
+        return sum == bytes[4] ? DHTStatus::OK : DHTStatus::CHECKSUM;
+    }
+
+    // Same conversions as the Adafruit DHT library, per wire format
+    inline void convertFrame(uint8_t type, const uint8_t bytes[5], float& humidity, float& temperature) {
+        switch (type) {
+            case TYPE_DHT11:
+                humidity = bytes[0] + bytes[1] * 0.1f;
+                temperature = bytes[2];
+                if (bytes[3] & 0x80) temperature = -1.0f - temperature;
+                temperature += (bytes[3] & 0x0F) * 0.1f;
+                break;
+            case TYPE_DHT12:
+                humidity = bytes[0] + bytes[1] * 0.1f;
+                temperature = bytes[2] + (bytes[3] & 0x0F) * 0.1f;
+                if (bytes[2] & 0x80) temperature = -temperature;
+                break;
+            default:    // DHT21 / DHT22 / AM2301
+                humidity = ((bytes[0] << 8) | bytes[1]) * 0.1f;
+                temperature = (((bytes[2] & 0x7F) << 8) | bytes[3]) * 0.1f;
+                if (bytes[2] & 0x80) temperature = -temperature;
+                break;
+        }
+    }
+
+    // Non-blocking DHT transaction.
+    // start() pulls the line low and ends the start signal on time whatever the
+    // caller's poll rate: DHT21/22 parts reject a low held much past ~20 ms, so
+    // their 1.1 ms signal is held inside start() (bounded wait), while the 20 ms
+    // DHT11/12 signal is ended by a one-shot timer. Then the edge interrupt
+    // timestamps every transition of the ~5 ms reply while interrupts stay
+    // enabled for everyone else; poll() only collects the frame, and may run
+    // late. Humidity and temperature come from that single frame.
+    //
+    // Pin supplies driveLow(), release(), read(), startCapture(fn, arg),
+    // stopCapture(), waitUs(us), armTimer(us, fn, arg) (one-shot) and a static
+    // now_us() clock, so the state machine and ISR run natively against a
+    // simulated line.
+    template <typename Pin>
+    class DHTReaderT {
+        public:
+            DHTReaderT(const Pin& pin, uint8_t type) : _pin(pin), _type(type) {}
+
+            uint8_t getType() const { return _type; }
+
+            // Host start signal: >= 18 ms for DHT11/DHT12, ~1 ms for DHT21/DHT22
+            uint32_t startSignalUs() const {
+                return (_type == TYPE_DHT11 || _type == TYPE_DHT12) ? 20000 : 1100;
+            }
+
+            bool start(uint32_t now_us) {
+                if (_state.load(std::memory_order_acquire) != State::IDLE) return false;
+                _reading.status = DHTStatus::BUSY;
+                _state.store(State::START_SIGNAL, std::memory_order_release);
+                _pin.driveLow();
+                uint32_t signal_us = startSignalUs();
+                if (signal_us <= MAX_WAIT_START_US) {
+                    _pin.waitUs(signal_us);
+                    beginCapture(now_us + signal_us);
+                } else {
+                    _pin.armTimer(signal_us, releaseTimer, this);
+                }
+                return true;
+            }
+
+            // BUSY while the transaction runs, then the final status
+            DHTStatus poll(uint32_t now_us) {
+                if (_state.load(std::memory_order_acquire) == State::CAPTURING &&
+                    (_edge_count >= FRAME_EDGES || now_us - _state_us >= CAPTURE_TIMEOUT_US)) {
+                    _pin.stopCapture();
+                    finish();
+                }
+                return _reading.status;
+            }
+
+            bool isBusy() const { return _state.load(std::memory_order_acquire) != State::IDLE; }
+            const DHTReading& getReading() const { return _reading; }
+            size_t getEdgeCount() const { return _edge_count; }
+
+            void IRAM_ATTR onEdge(uint32_t now_us, uint8_t level) {
+                size_t n = _edge_count;
+                if (n >= MAX_EDGES) return;
+                _edges[n].us = now_us;
+                _edges[n].level = level;
+                _edge_count = n + 1;
+            }
+
+            static void IRAM_ATTR edgeISR(void* arg) {
+                DHTReaderT* self = static_cast<DHTReaderT*>(arg);
+                self->onEdge(Pin::now_us(), self->_pin.read());
+            }
+
+            static void releaseTimer(void* arg) {
+                static_cast<DHTReaderT*>(arg)->beginCapture(Pin::now_us());
+            }
+
+        private:
+            enum class State : uint8_t { IDLE, START_SIGNAL, CAPTURING };
+
+            Pin _pin;
+            uint8_t _type;
+            std::atomic<State> _state{State::IDLE};
+            uint32_t _state_us = 0;
+            DHTEdge _edges[MAX_EDGES];
+            volatile size_t _edge_count = 0;
+            DHTReading _reading;
+
+            // End of the start signal: release the line and timestamp the reply
+            void beginCapture(uint32_t now_us) {
+                _edge_count = 0;
+                _state_us = now_us;
+                _pin.release();
+                _pin.startCapture(edgeISR, this);
+                _state.store(State::CAPTURING, std::memory_order_release);
+            }
+
+            void finish() {
+                DHTReading reading;
+                reading.status = decodeFrame(_edges, _edge_count, reading.bytes);
+                if (reading.ok()) convertFrame(_type, reading.bytes, reading.humidity, reading.temperature);
+                _reading = reading;
+                _state.store(State::IDLE, std::memory_order_release);
+            }
+    };
+
+#ifdef ARDUINO
+    // GPIO edge interrupt on CHANGE: ~84 short interrupts per reading instead
+    // of one 5 ms interrupts-off section
+    struct DHTGpioPin {
+        uint8_t pin;
+
+        static uint32_t IRAM_ATTR now_us() { return micros(); }
+        uint8_t IRAM_ATTR read() const { return (uint8_t)digitalRead(pin); }
+        void driveLow() {
+            pinMode(pin, OUTPUT);
+            digitalWrite(pin, LOW);
+        }
+        void release() { pinMode(pin, INPUT_PULLUP); }
+        void startCapture(void (*fn)(void*), void* arg) {
+            attachInterruptArg(digitalPinToInterrupt(pin), fn, arg, CHANGE);
+        }
+        void stopCapture() { detachInterrupt(digitalPinToInterrupt(pin)); }
+        void waitUs(uint32_t us) { delayMicroseconds(us); }
+#ifdef ARDUINO_ARCH_ESP32
+        esp_timer_handle_t timer = nullptr;
+        void armTimer(uint32_t us, void (*fn)(void*), void* arg) {
+            if (!timer) {
+                esp_timer_create_args_t args = {};
+                args.callback = fn;
+                args.arg = arg;
+                args.name = "dht_start";
+                if (esp_timer_create(&args, &timer) != ESP_OK) {
+                    timer = nullptr;
+                    delayMicroseconds(us);      // no timer: hold the signal here rather than late
+                    fn(arg);
+                    return;
+                }
+            }
+            esp_timer_start_once(timer, us);
+        }
+#else
+        void armTimer(uint32_t us, void (*fn)(void*), void* arg) {
+            delayMicroseconds(us);
+            fn(arg);
+        }
+#endif
+    };
+
+    typedef DHTReaderT<DHTGpioPin> DHTReader;
+#endif
+} // namespace overseer::device::environment::dht
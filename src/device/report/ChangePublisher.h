@@ -0,0 +1,213 @@
+// ChangePublisher.h
+#pragma once
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "FastFormat.h"
+
+namespace overseer::device::report {
+
+    struct PublishResult {
+        bool keyframe = false;
+        uint16_t emitted = 0;       // fields passed to the sink
+        uint16_t suppressed = 0;    // fields inside their deadband
+    };
+
+    // Publish-on-change filter over a visitFields() walk.
+    // Each field is compared with the value it had when it was last *published*,
+    // so slow drift still goes out once it has accumulated past the deadband.
+    // Only changed fields reach the sink (a sparse record); every field goes out
+    // on the first publish, on forceKeyframe() and every keyframe interval, so a
+    // late subscriber or a lost packet is repaired within one interval.
+    //
+    // Fields are tracked by position in the walk, checked by name and window
+    // label, so steady state is one compare per field with no allocation. When
+    // the walk changes shape (a new window appears) the tracking is rebuilt from
+    // that field on and the new fields are published.
+    class ChangePublisher {
+        public:
+            static constexpr unsigned long DEFAULT_KEYFRAME_MS = 60000;
+
+            // Absolute deadband for one field name (all its windows); 0 = any change.
+            // `name` is kept by pointer, like the visitFields() literals it matches.
+            void setDeadband(const char* name, float deadband) {
+                for (Override& o : overrides) {
+                    if (strcmp(o.name, name) == 0) {
+                        o.deadband = deadband;
+                        invalidate();
+                        return;
+                    }
+                }
+                overrides.push_back({name, deadband});
+                invalidate();
+            }
+
+            void setDefaultDeadband(float deadband) {
+                default_deadband = deadband;
+                invalidate();
+            }
+
+            float getDeadband(const char* name) const {
+                for (const Override& o : overrides) {
+                    if (strcmp(o.name, name) == 0) return o.deadband;
+                }
+                return default_deadband;
+            }
+
+            // 0 disables periodic keyframes (first publish and forceKeyframe() only)
+            void setKeyframeInterval(unsigned long ms) { keyframe_interval_ms = ms; }
+            unsigned long getKeyframeInterval() const { return keyframe_interval_ms; }
+            void forceKeyframe() { keyframe_pending = true; }
+            bool isKeyframeDue(unsigned long now) const {
+                return !started || keyframe_pending ||
+                       (keyframe_interval_ms > 0 && now - last_keyframe_ms >= keyframe_interval_ms);
+            }
+
+            void reset() {
+                fields.clear();
+                started = false;
+                keyframe_pending = false;
+            }
+
+            // Walks `data` with visitFields() and calls sink(name, window, value)
+            // for every field to publish.
+            template <typename Data, typename Sink>
+            PublishResult publish(const Data& data, unsigned long now, Sink&& sink) {
+                PublishResult result;
+                result.keyframe = isKeyframeDue(now);
+
+                size_t index = 0;
+                visitFields(data, [&](const char* name, const char* window, float value) {
+                    if (index < fields.size() && !fields[index].matches(name, window)) {
+                        fields.resize(index);       // shape changed: rebuild from here
+                    }
+                    bool is_new = index == fields.size();
+                    if (is_new) fields.push_back(track(name, window));
+
+                    Field& field = fields[index++];
+                    if (result.keyframe || is_new || field.changed(value)) {
+                        field.last = value;
+                        sink(name, window, value);
+                        result.emitted++;
+                    } else {
+                        result.suppressed++;
+                    }
+                });
+                if (index < fields.size()) fields.resize(index);
+
+                if (result.keyframe) {
+                    started = true;
+                    keyframe_pending = false;
+                    last_keyframe_ms = now;
+                    keyframes++;
+                }
+                publishes++;
+                emitted_total += result.emitted;
+                suppressed_total += result.suppressed;
+                return result;
+            }
+
+            uint32_t getPublishCount() const { return publishes; }
+            uint32_t getKeyframeCount() const { return keyframes; }
+            uint32_t getEmittedCount() const { return emitted_total; }
+            uint32_t getSuppressedCount() const { return suppressed_total; }
+
+        private:
+            struct Override {
+                const char* name;
+                float deadband;
+            };
+
+            struct Field {
+                static constexpr size_t WINDOW_LEN = 16;
+
+                const char* name;           // visitFields() names are string literals
+                char window[WINDOW_LEN];    // map keys are not: keep a copy
+                bool has_window;
+                float deadband;
+                float last;
+
+                bool matches(const char* n, const char* w) const {
+                    if (n != name && strcmp(n, name) != 0) return false;
+                    if (!w) return !has_window;
+                    return has_window && strncmp(w, window, WINDOW_LEN - 1) == 0;
+                }
+
+                bool changed(float value) const {
+                    if (isnan(value) || isnan(last)) return isnan(value) != isnan(last);
+                    return fabsf(value - last) > deadband;
+                }
+            };
+
+            std::vector<Override> overrides;
+            std::vector<Field> fields;
+            float default_deadband = 0.0f;
+            unsigned long keyframe_interval_ms = DEFAULT_KEYFRAME_MS;
+            unsigned long last_keyframe_ms = 0;
+            bool started = false;
+            bool keyframe_pending = false;
+            uint32_t publishes = 0;
+            uint32_t keyframes = 0;
+            uint32_t emitted_total = 0;
+            uint32_t suppressed_total = 0;
+
+            Field track(const char* name, const char* window) const {
+                Field field;
+                field.name = name;
+                field.has_window = window != nullptr;
+                strncpy(field.window, window ? window : "", Field::WINDOW_LEN - 1);
+                field.window[Field::WINDOW_LEN - 1] = '\0';
+                field.deadband = getDeadband(name);
+                field.last = NAN;
+                return field;
+            }
+
+            // Deadbands are cached per field; pick up new ones on the next walk
+            void invalidate() {
+                fields.clear();
+                keyframe_pending = true;
+            }
+    };
+
+    // Prints one publish as "<prefix> K|D name[window]=value ..." ("K" = full
+    // keyframe) through out.println(); long records wrap onto "  +" lines.
+    template <typename Data, typename Out>
+    PublishResult printChanges(ChangePublisher& publisher, const Data& data, const char* prefix,
+                               unsigned long now, Out& out) {
+        LineBuffer<128> line;
+        line.append(prefix).append(' ').append(publisher.isKeyframeDue(now) ? "K" : "D");
+        const size_t header = line.length();
+        PublishResult result = publisher.publish(data, now, [&](const char* name, const char* window, float value) {
+            LineBuffer<64> field;
+            field.append(' ').append(name);
+            if (window) field.append('[').append(window).append(']');
+            field.append('=').appendFloat(value);
+            if (field.length() > line.remaining()) {
+                out.println(line.c_str());
+                line.clear();
+                line.append("  +");
+            }
+            line.append(field.c_str());
+        });
+        if (line.length() > header) out.println(line.c_str());
+        return result;
+    }
+
+    // Reads report_keyframe_s, report_deadband and deadband_<field> from a config
+    // section; keys that are absent keep the device defaults.
+    template <typename Config, typename Data>
+    void loadConfig(ChangePublisher& publisher, const Config& config, const char* section, const Data& data) {
+        publisher.setKeyframeInterval((unsigned long)config.getInt(section, "report_keyframe_s",
+                                      (int)(publisher.getKeyframeInterval() / 1000)) * 1000UL);
+        float default_deadband = config.getFloat(section, "report_deadband", NAN);
+        if (!isnan(default_deadband)) publisher.setDefaultDeadband(default_deadband);
+        visitFields(data, [&](const char* name, const char* window, float) {
+            if (window) return;
+            LineBuffer<48> key;
+            key.append("deadband_").append(name);
+            float deadband = config.getFloat(section, key.c_str(), NAN);
+            if (!isnan(deadband)) publisher.setDeadband(name, deadband);
+        });
+    }
+} // namespace overseer::device::report
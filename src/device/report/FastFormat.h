@@ -0,0 +1,167 @@
+// FastFormat.h
+#pragma once
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace overseer::device::report {
+
+    // printf-free number formatting into caller-provided buffers.
+    // No heap, no varargs, no newlib float printf: fixed-point floats are split
+    // into integer and fraction with one multiply, then emitted digit by digit.
+    // Every function NUL-terminates (when size > 0), truncates instead of
+    // overflowing and returns the number of characters written.
+    namespace format {
+        constexpr uint8_t MAX_DECIMALS = 9;
+
+        constexpr uint32_t POW10[MAX_DECIMALS + 1] = {
+            1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL
+        };
+
+        inline size_t copy(char* buf, size_t size, const char* text) {
+            if (size == 0) return 0;
+            size_t n = 0;
+            while (text[n] && n + 1 < size) {
+                buf[n] = text[n];
+                n++;
+            }
+            buf[n] = '\0';
+            return n;
+        }
+
+        // Digits of `value`, left-padded with zeros to at least `min_digits`
+        inline size_t formatUnsigned(char* buf, size_t size, uint64_t value, uint8_t min_digits = 1) {
+            char digits[20];
+            uint8_t count = 0;
+            do {
+                digits[count++] = (char)('0' + value % 10);
+                value /= 10;
+            } while (value > 0 && count < sizeof(digits));
+            while (count < min_digits && count < sizeof(digits)) digits[count++] = '0';
+
+            if (size == 0) return 0;
+            size_t n = 0;
+            while (count > 0 && n + 1 < size) buf[n++] = digits[--count];
+            buf[n] = '\0';
+            return n;
+        }
+
+        inline size_t formatSigned(char* buf, size_t size, int64_t value) {
+            if (value >= 0) return formatUnsigned(buf, size, (uint64_t)value);
+            if (size < 2) return copy(buf, size, "");
+            buf[0] = '-';
+            return 1 + formatUnsigned(buf + 1, size - 1, 0 - (uint64_t)value);
+        }
+
+        // Fixed-point decimal, rounded half away from zero; decimals are capped at
+        // MAX_DECIMALS. Magnitudes below 2^32 (every sensor value here) stay in
+        // float/uint32 arithmetic; larger ones take a double path.
+        inline size_t formatFloat(char* buf, size_t size, float value, uint8_t decimals = 3) {
+            if (isnan(value)) return copy(buf, size, "nan");
+            if (isinf(value)) return copy(buf, size, value < 0 ? "-inf" : "inf");
+            if (decimals > MAX_DECIMALS) decimals = MAX_DECIMALS;
+
+            const uint32_t scale = POW10[decimals];
+            const float magnitude = fabsf(value);
+            uint64_t whole;
+            uint32_t fraction;
+            if (magnitude < 4294967040.0f) {
+                uint32_t integer = (uint32_t)magnitude;
+                float rounded = (magnitude - (float)integer) * (float)scale + 0.5f;    // the subtraction is exact
+                fraction = (uint32_t)rounded;
+                whole = integer;
+            } else {
+                double scaled = floor((double)magnitude * scale + 0.5);
+                if (scaled >= 1.8e19) return copy(buf, size, value < 0 ? "-ovf" : "ovf");
+                uint64_t total = (uint64_t)scaled;
+                whole = total / scale;
+                fraction = (uint32_t)(total % scale);
+            }
+            if (fraction >= scale) {
+                whole++;
+                fraction -= scale;
+            }
+
+            size_t n = 0;
+            if (value < 0 && (whole != 0 || fraction != 0) && size > 1) {
+                buf[n++] = '-';
+            }
+            n += formatUnsigned(buf + n, size - n, whole);
+            if (decimals > 0 && n + 1 < size) {
+                buf[n++] = '.';
+                n += formatUnsigned(buf + n, size - n, fraction, decimals);
+            }
+            return n;
+        }
+    } // namespace format
+
+    // Fixed-capacity line assembled on the stack, then handed to Serial/Log in
+    // one call. Appends past the capacity are dropped and flagged.
+    template <size_t N>
+    class LineBuffer {
+        public:
+            LineBuffer& append(const char* text) {
+                size_t written = format::copy(_buf + _len, N - _len, text);
+                _len += written;
+                if (text[written] != '\0') _truncated = true;
+                return *this;
+            }
+
+            LineBuffer& append(char c) {
+                if (_len + 1 < N) {
+                    _buf[_len++] = c;
+                    _buf[_len] = '\0';
+                } else {
+                    _truncated = true;
+                }
+                return *this;
+            }
+
+            // Numbers are formatted whole first, so a line never ends in half a number
+            LineBuffer& appendFloat(float value, uint8_t decimals = 3) {
+                char digits[NUMBER_LEN];
+                format::formatFloat(digits, sizeof(digits), value, decimals);
+                return appendWhole(digits);
+            }
+
+            LineBuffer& appendUnsigned(uint64_t value) {
+                char digits[NUMBER_LEN];
+                format::formatUnsigned(digits, sizeof(digits), value);
+                return appendWhole(digits);
+            }
+
+            LineBuffer& appendSigned(int64_t value) {
+                char digits[NUMBER_LEN];
+                format::formatSigned(digits, sizeof(digits), value);
+                return appendWhole(digits);
+            }
+
+            void clear() {
+                _len = 0;
+                _buf[0] = '\0';
+                _truncated = false;
+            }
+
+            const char* c_str() const { return _buf; }
+            size_t length() const { return _len; }
+            size_t remaining() const { return N - 1 - _len; }
+            bool isTruncated() const { return _truncated; }
+
+        private:
+            static constexpr size_t NUMBER_LEN = 32;     // sign + 20 digits + '.' + 9 decimals
+
+            char _buf[N] = {0};
+            size_t _len = 0;
+            bool _truncated = false;
+
+            LineBuffer& appendWhole(const char* digits) {
+                size_t length = 0;
+                while (digits[length]) length++;
+                if (_len + length + 1 > N) {
+                    _truncated = true;
+                    return *this;
+                }
+                return append(digits);
+            }
+    };
+} // namespace overseer::device::report
@@ -0,0 +1,218 @@
+// QuantileSketch.h
+#pragma once
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+namespace overseer::device::stats {
+
+    struct QuantileSummary {
+        float p50 = 0.0f;
+        float p95 = 0.0f;
+        float p99 = 0.0f;
+        uint32_t count = 0;
+    };
+
+    // Fixed-size log-linear histogram of |value|.
+    // SUB_BUCKETS linear bins per power of two from 2^min_exponent up through
+    // OCTAVES powers of two. A reported quantile is the midpoint of its bin, so
+    // within the range the relative error is at most 1 / (2 * SUB_BUCKETS)
+    // (6.25%). Smaller values (including 0) share an underflow bin reported as 0;
+    // larger ones clamp to the top edge. Histograms with the same min_exponent
+    // merge by adding counts.
+    class LogHistogram {
+        public:
+            static constexpr uint8_t OCTAVES = 16;
+            static constexpr uint8_t SUB_BUCKETS = 8;
+            static constexpr uint16_t BINS = OCTAVES * SUB_BUCKETS + 2;    // + underflow, overflow
+
+            static inline uint16_t binOf(float value, int8_t min_exponent) {
+                float magnitude = fabsf(value);
+                if (!(magnitude >= ldexpf(1.0f, min_exponent))) return 0;     // also catches NaN
+                int exponent;
+                float mantissa = frexpf(magnitude, &exponent);                  // [0.5, 1)
+                int octave = exponent - 1 - min_exponent;
+                if (octave >= OCTAVES) return BINS - 1;
+                int sub = (int)((mantissa * 2.0f - 1.0f) * SUB_BUCKETS);
+                return (uint16_t)(1 + octave * SUB_BUCKETS + sub);
+            }
+
+            static inline float binValue(uint16_t bin, int8_t min_exponent) {
+                if (bin == 0) return 0.0f;
+                if (bin >= BINS - 1) return ldexpf(1.0f, min_exponent + OCTAVES);
+                int octave = (bin - 1) / SUB_BUCKETS;
+                int sub = (bin - 1) % SUB_BUCKETS;
+                return ldexpf(1.0f + (sub + 0.5f) / SUB_BUCKETS, min_exponent + octave);
+            }
+
+            inline void addBin(uint16_t bin) {
+                counts[bin]++;
+                total++;
+            }
+
+            void clear() {
+                memset(counts, 0, sizeof(counts));
+                total = 0;
+            }
+
+            void merge(const LogHistogram& other) {
+                for (uint16_t b = 0; b < BINS; b++) counts[b] += other.counts[b];
+                total += other.total;
+            }
+
+            float quantile(float q, int8_t min_exponent) const {
+                if (total == 0) return 0.0f;
+                uint32_t rank = (uint32_t)(q * (total - 1));
+                uint32_t cumulative = 0;
+                for (uint16_t b = 0; b < BINS; b++) {
+                    cumulative += counts[b];
+                    if (cumulative > rank) return binValue(b, min_exponent);
+                }
+                return binValue(BINS - 1, min_exponent);
+            }
+
+            uint32_t getCount() const { return total; }
+            uint32_t getBin(uint16_t bin) const { return counts[bin]; }
+
+        private:
+            uint32_t counts[BINS] = {0};
+            uint32_t total = 0;
+    };
+
+    // Rolling quantiles over several time windows ("tiers") for one signal.
+    // Each tier is a ring of SLICES histograms; the oldest slice is cleared as
+    // time moves on, so memory is fixed per tier (~2 KB) whatever the sample
+    // rate or window length. Queries merge the slices on the fly and cover
+    // between (SLICES - 1) and SLICES slice widths of history.
+    // Signed mode keeps negative values in a second histogram per slice (twice
+    // the memory) for signals whose sign matters, e.g. temperature.
+    class QuantileWindows {
+        public:
+            static constexpr uint8_t SLICES = 4;
+
+            // min_exponent sets the smallest resolved magnitude (2^-10 ~ 0.001)
+            void configure(const std::vector<unsigned long>& tiers_sec, int8_t exponent = -10, bool signed_values = false) {
+                min_exponent = exponent;
+                halves = signed_values ? 2 : 1;
+                _tiers = tiers_sec;
+                _width_ms.assign(_tiers.size(), 0);
+                _cursor.assign(_tiers.size(), 0);
+                _slice_start.assign(_tiers.size(), 0);
+                _slices.assign(_tiers.size() * SLICES * halves, LogHistogram());
+                for (size_t t = 0; t < _tiers.size(); t++) {
+                    unsigned long width = _tiers[t] * 1000UL / SLICES;
+                    _width_ms[t] = width > 0 ? width : 1;
+                }
+                _started = false;
+            }
+
+            void reset() {
+                for (LogHistogram& h : _slices) h.clear();
+                _started = false;
+            }
+
+            // Per sample: one bin lookup, one increment per tier
+            inline void add(float value) {
+                uint16_t bin = LogHistogram::binOf(value, min_exponent);
+                size_t half = (halves > 1 && value < 0.0f) ? 1 : 0;
+                for (size_t t = 0; t < _tiers.size(); t++) {
+                    _slices[slice(t, _cursor[t], half)].addBin(bin);
+                }
+            }
+
+            void advance(unsigned long now) {
+                if (!_started) {
+                    _started = true;
+                    for (size_t t = 0; t < _tiers.size(); t++) _slice_start[t] = now;
+                    return;
+                }
+                for (size_t t = 0; t < _tiers.size(); t++) {
+                    unsigned long elapsed = (now - _slice_start[t]) / _width_ms[t];
+                    if (elapsed == 0) continue;
+                    uint8_t steps = elapsed >= SLICES ? SLICES : (uint8_t)elapsed;
+                    for (uint8_t s = 0; s < steps; s++) {
+                        _cursor[t] = (_cursor[t] + 1) % SLICES;
+                        for (uint8_t h = 0; h < halves; h++) _slices[slice(t, _cursor[t], h)].clear();
+                    }
+                    _slice_start[t] += elapsed * _width_ms[t];
+                }
+            }
+
+            // Several quantiles in one pass over the bins; qs must be ascending.
+            // Signed mode walks the negative half from its largest magnitude down first.
+            void quantiles(size_t tier, const float* qs, float* out, size_t n) const {
+                uint32_t total = count(tier);
+                for (size_t i = 0; i < n; i++) out[i] = 0.0f;
+                if (total == 0) return;
+
+                size_t next = 0;
+                uint32_t cumulative = 0;
+                for (uint16_t step = 0; step < halves * LogHistogram::BINS && next < n; step++) {
+                    bool negative = halves > 1 && step < LogHistogram::BINS;
+                    uint16_t b = negative ? LogHistogram::BINS - 1 - step : step % LogHistogram::BINS;
+                    const LogHistogram* ring = &_slices[slice(tier, 0, negative ? 1 : 0)];
+                    for (uint8_t s = 0; s < SLICES; s++) cumulative += ring[s].getBin(b);
+                    while (next < n && cumulative > (uint32_t)(qs[next] * (total - 1))) {
+                        float value = LogHistogram::binValue(b, min_exponent);
+                        out[next++] = negative ? -value : value;
+                    }
+                }
+            }
+
+            float quantile(size_t tier, float q) const {
+                float result = 0.0f;
+                quantiles(tier, &q, &result, 1);
+                return result;
+            }
+
+            QuantileSummary summary(size_t tier) const {
+                static const float qs[3] = {0.50f, 0.95f, 0.99f};
+                float out[3];
+                quantiles(tier, qs, out, 3);
+                QuantileSummary s;
+                s.p50 = out[0];
+                s.p95 = out[1];
+                s.p99 = out[2];
+                s.count = count(tier);
+                return s;
+            }
+
+            // Merged histogram of one tier, e.g. to combine several sensors (|value| in signed mode)
+            LogHistogram merged(size_t tier) const {
+                LogHistogram h;
+                for (uint8_t half = 0; half < halves; half++) {
+                    for (uint8_t s = 0; s < SLICES; s++) h.merge(_slices[slice(tier, s, half)]);
+                }
+                return h;
+            }
+
+            uint32_t count(size_t tier) const {
+                uint32_t total = 0;
+                for (uint8_t half = 0; half < halves; half++) {
+                    for (uint8_t s = 0; s < SLICES; s++) total += _slices[slice(tier, s, half)].getCount();
+                }
+                return total;
+            }
+
+            size_t getTierCount() const { return _tiers.size(); }
+            unsigned long getTierSeconds(size_t tier) const { return _tiers[tier]; }
+            int8_t getMinExponent() const { return min_exponent; }
+            bool isSigned() const { return halves > 1; }
+
+        private:
+            std::vector<unsigned long> _tiers;
+            std::vector<unsigned long> _width_ms;
+            std::vector<uint8_t> _cursor;
+            std::vector<unsigned long> _slice_start;
+            std::vector<LogHistogram> _slices;      // [half][tier][slice], half 1 = negative values
+            int8_t min_exponent = -10;
+            uint8_t halves = 1;
+            bool _started = false;
+
+            inline size_t slice(size_t tier, size_t s, size_t half) const {
+                return (half * _tiers.size() + tier) * SLICES + s;
+            }
+    };
+} // namespace overseer::device::stats
@@ -0,0 +1,236 @@
+// WindowMax.h
+#pragma once
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace overseer::device::stats {
+    // "1,10,60" -> {1, 10, 60} seconds, sorted, duplicates and zeros dropped.
+    // Returns false (out untouched) when the text holds no valid window.
+    inline bool parseWindowList(const char* text, std::vector<unsigned long>& out) {
+        if (!text) return false;
+        std::vector<unsigned long> windows;
+        const char* p = text;
+        while (*p) {
+            char* end = nullptr;
+            unsigned long value = strtoul(p, &end, 10);
+            if (end == p) {
+                p++;                                // separator or junk
+                continue;
+            }
+            if (value > 0) windows.push_back(value);
+            p = end;
+        }
+        if (windows.empty()) return false;
+        std::sort(windows.begin(), windows.end());
+        windows.erase(std::unique(windows.begin(), windows.end()), windows.end());
+        out = windows;
+        return true;
+    }
+
+    constexpr unsigned long gcdMs(unsigned long a, unsigned long b) {
+        while (b) { unsigned long t = a % b; a = b; b = t; }
+        return a;
+    }
+
+    // Rolling maximum of |value| over several time windows for many channels at once.
+    //
+    // Each window keeps a ring of `buckets` sub-bucket maxima, so memory is fixed and
+    // queries never rescan sample history. Samples only touch a per-channel pending
+    // max (one compare); the pending values are folded into every window once per
+    // tick (gcd of the bucket widths), shared by all channels.
+    //
+    // Results are approximate, unlike an exact per-sample rolling max: a window
+    // covers between (buckets - 1) and `buckets` bucket widths of history, e.g. a
+    // "1s" window with 10 buckets reports a sample for 0.9-1.0 s, and results move
+    // in steps of one bucket width. Pending samples are folded into the bucket
+    // they arrived in before it rotates, so none outlives its window (given
+    // advance() is called at least once per tick).
+    //
+    // Storage is structure-of-arrays: [window][bucket][channel], so one tick walks
+    // each bucket row contiguously across channels.
+    class WindowMax {
+        public:
+            void configure(const std::vector<unsigned long>& windows_sec, size_t channels, uint8_t buckets = 10) {
+                _channels = channels;
+                _buckets = buckets < 2 ? 2 : buckets;
+                _windows = windows_sec;
+                _width_ms.assign(_windows.size(), 0);
+                _cursor.assign(_windows.size(), 0);
+                _bucket_start.assign(_windows.size(), 0);
+                _tick_ms = 0;
+                for (size_t w = 0; w < _windows.size(); w++) {
+                    unsigned long width = _windows[w] * 1000UL / _buckets;
+                    _width_ms[w] = width > 0 ? width : 1;
+                    _tick_ms = gcdMs(_tick_ms, _width_ms[w]);
+                }
+                _rings.assign(_windows.size() * _buckets * _channels, 0.0f);
+                _pending.assign(_channels, 0.0f);
+                _started = false;
+            }
+
+            void reset() {
+                for (float& v : _rings) v = 0.0f;
+                for (float& v : _pending) v = 0.0f;
+                _started = false;
+            }
+
+            // Per sample: O(1), independent of the number of windows
+            inline void add(size_t channel, float value) {
+                float magnitude = fabsf(value);
+                if (magnitude > _pending[channel]) _pending[channel] = magnitude;
+            }
+
+            // Once per sweep (or more often): folds pending maxima in on tick boundaries.
+            // True on the first call and on every fold, i.e. when results may have moved
+            // by more than the pending samples.
+            bool advance(unsigned long now) {
+                if (_windows.empty()) return false;
+                if (!_started) {
+                    _started = true;
+                    _last_tick = now;
+                    for (size_t w = 0; w < _windows.size(); w++) _bucket_start[w] = now;
+                    return true;
+                }
+                if (now - _last_tick < _tick_ms) return false;
+                _last_tick = now;
+
+                for (size_t w = 0; w < _windows.size(); w++) {
+                    // Pending samples belong to the bucket they arrived in
+                    float* row = bucket(w, _cursor[w]);
+                    for (size_t c = 0; c < _channels; c++) {
+                        if (_pending[c] > row[c]) row[c] = _pending[c];
+                    }
+                    // Then rotate past every bucket boundary crossed since the last fold
+                    unsigned long elapsed = (now - _bucket_start[w]) / _width_ms[w];
+                    if (elapsed > 0) {
+                        uint8_t steps = elapsed >= _buckets ? _buckets : (uint8_t)elapsed;
+                        for (uint8_t s = 0; s < steps; s++) {
+                            _cursor[w] = (_cursor[w] + 1) % _buckets;
+                            row = bucket(w, _cursor[w]);
+                            for (size_t c = 0; c < _channels; c++) row[c] = 0.0f;
+                        }
+                        _bucket_start[w] += elapsed * _width_ms[w];
+                    }
+                }
+                for (size_t c = 0; c < _channels; c++) _pending[c] = 0.0f;
+                return true;
+            }
+
+            float get(size_t channel, size_t window) const {
+                float result = _pending[channel];
+                for (uint8_t b = 0; b < _buckets; b++) {
+                    float v = _rings[(window * _buckets + b) * _channels + channel];
+                    if (v > result) result = v;
+                }
+                return result;
+            }
+
+            size_t getWindowCount() const { return _windows.size(); }
+            unsigned long getWindowSeconds(size_t window) const { return _windows[window]; }
+            const std::vector<unsigned long>& getWindows() const { return _windows; }
+            size_t getChannelCount() const { return _channels; }
+            unsigned long getTickMs() const { return _tick_ms; }
+
+        private:
+            std::vector<unsigned long> _windows;
+            std::vector<unsigned long> _width_ms;
+            std::vector<uint8_t> _cursor;
+            std::vector<unsigned long> _bucket_start;
+            std::vector<float> _rings;
+            std::vector<float> _pending;
+            size_t _channels = 0;
+            uint8_t _buckets = 10;
+            unsigned long _tick_ms = 0;
+            unsigned long _last_tick = 0;
+            bool _started = false;
+
+            float* bucket(size_t window, uint8_t index) {
+                return &_rings[(window * _buckets + index) * _channels];
+            }
+    };
+
+    // Single-channel WindowMax over a window table fixed at compile time: Table is
+    // any type with `static constexpr unsigned long windows[]` (seconds), e.g. a
+    // WCS1800 profile. Bucket widths and the tick are constants and storage is
+    // inline, so there is no heap and the per-window loops have constant bounds.
+    template <typename Table, uint8_t Buckets = 10>
+    class StaticWindowMax {
+        public:
+            static_assert(Buckets >= 2, "at least two buckets per window");
+            static constexpr size_t WINDOW_COUNT = sizeof(Table::windows) / sizeof(Table::windows[0]);
+
+            static constexpr unsigned long widthMs(size_t window) {
+                return Table::windows[window] * 1000UL / Buckets > 0 ? Table::windows[window] * 1000UL / Buckets : 1;
+            }
+            static constexpr unsigned long tickMs() {
+                unsigned long tick = 0;
+                for (size_t w = 0; w < WINDOW_COUNT; w++) tick = gcdMs(tick, widthMs(w));
+                return tick;
+            }
+            static constexpr unsigned long TICK_MS = tickMs();
+
+            void reset() {
+                _rings.fill(0.0f);
+                _pending = 0.0f;
+                _started = false;
+            }
+
+            inline void add(float value) {
+                float magnitude = fabsf(value);
+                if (magnitude > _pending) _pending = magnitude;
+            }
+
+            // Same folding rules as WindowMax::advance()
+            bool advance(unsigned long now) {
+                if (!_started) {
+                    _started = true;
+                    _last_tick = now;
+                    _bucket_start.fill(now);
+                    return true;
+                }
+                if (now - _last_tick < TICK_MS) return false;
+                _last_tick = now;
+
+                for (size_t w = 0; w < WINDOW_COUNT; w++) {
+                    float& slot = _rings[w * Buckets + _cursor[w]];
+                    if (_pending > slot) slot = _pending;
+                    unsigned long elapsed = (now - _bucket_start[w]) / widthMs(w);
+                    if (elapsed > 0) {
+                        uint8_t steps = elapsed >= Buckets ? Buckets : (uint8_t)elapsed;
+                        for (uint8_t s = 0; s < steps; s++) {
+                            _cursor[w] = (_cursor[w] + 1) % Buckets;
+                            _rings[w * Buckets + _cursor[w]] = 0.0f;
+                        }
+                        _bucket_start[w] += elapsed * widthMs(w);
+                    }
+                }
+                _pending = 0.0f;
+                return true;
+            }
+
+            float get(size_t window) const {
+                float result = _pending;
+                for (uint8_t b = 0; b < Buckets; b++) {
+                    float v = _rings[window * Buckets + b];
+                    if (v > result) result = v;
+                }
+                return result;
+            }
+
+            static constexpr size_t getWindowCount() { return WINDOW_COUNT; }
+            static constexpr unsigned long getWindowSeconds(size_t window) { return Table::windows[window]; }
+
+        private:
+            std::array<float, WINDOW_COUNT * Buckets> _rings{};
+            std::array<uint8_t, WINDOW_COUNT> _cursor{};
+            std::array<unsigned long, WINDOW_COUNT> _bucket_start{};
+            float _pending = 0.0f;
+            unsigned long _last_tick = 0;
+            bool _started = false;
+    };
+} // namespace overseer::device::stats
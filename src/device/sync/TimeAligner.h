@@ -0,0 +1,194 @@
+// TimeAligner.h
+#pragma once
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace overseer::device::sync {
+
+    enum class AlignMode : uint8_t {
+        INTERPOLATE,    // linear between the samples around the frame time; gates emission
+        HOLD            // last sample at or before the frame time (slow sensors, e.g. DHT)
+    };
+
+    template <size_t MAX_STREAMS>
+    struct AlignedFrame {
+        uint32_t t_us = 0;
+        uint8_t stream_count = 0;
+        uint32_t valid_mask = 0;        // bit per stream: value is usable
+        uint32_t held_mask = 0;         // bit per stream: value is the newest sample, not interpolated
+        float values[MAX_STREAMS];
+
+        bool isValid(uint8_t stream) const { return (valid_mask >> stream) & 1u; }
+        float get(uint8_t stream) const { return isValid(stream) ? values[stream] : NAN; }
+    };
+
+    // Resamples independently timestamped sensor streams onto one timebase.
+    // Each stream keeps the last DEPTH (t_us, value) samples in a ring; frames
+    // are emitted every period at multiples of the period, once every
+    // interpolating stream has a sample at or past the frame time (or the frame
+    // is max_latency old, so a dead sensor cannot stall the rest). Timestamps
+    // are micros() and compared wrap-safe. No allocation after construction.
+    // Configure the rate before the first push(); frame times are fixed then.
+    //
+    //   TimeAligner<4> align;
+    //   uint8_t amps = align.addStream("current");
+    //   uint8_t g = align.addStream("gz");
+    //   uint8_t rh = align.addStream("humidity", AlignMode::HOLD, 5000000);
+    //   align.setFrameRate(200);
+    //   ...after each device update: align.push(amps, micros(), wcs.getCurrent());
+    //   align.process(micros(), [](const TimeAligner<4>::Frame& f) { ... });
+    template <size_t MAX_STREAMS = 8, size_t DEPTH = 32>
+    class TimeAligner {
+        static_assert(MAX_STREAMS <= 32, "valid_mask is 32 bits");
+
+        public:
+            typedef AlignedFrame<MAX_STREAMS> Frame;
+
+            // Returns a stream id for push(), or 0xFF when full
+            uint8_t addStream(const char* name, AlignMode mode = AlignMode::INTERPOLATE, uint32_t max_age_us = 1000000) {
+                if (stream_count >= MAX_STREAMS) return 0xFF;
+                Stream& s = streams[stream_count];
+                s = Stream();
+                s.name = name;
+                s.mode = mode;
+                s.max_age_us = max_age_us;
+                return stream_count++;
+            }
+
+            void setFrameRate(float hz) {
+                if (hz > 0.0f) period_us = (uint32_t)lroundf(1000000.0f / hz);
+                if (period_us == 0) period_us = 1;
+            }
+            void setMaxLatency(uint32_t us) { max_latency_us = us; }
+            uint32_t getFramePeriod() const { return period_us; }
+            uint8_t getStreamCount() const { return stream_count; }
+            const char* getStreamName(uint8_t stream) const { return stream < stream_count ? streams[stream].name : ""; }
+
+            // Samples must be pushed in time order per stream; older ones are rejected
+            bool push(uint8_t stream, uint32_t t_us, float value) {
+                if (stream >= stream_count) return false;
+                Stream& s = streams[stream];
+                if (s.count > 0 && (int32_t)(t_us - s.newest().t_us) <= 0) {
+                    s.rejected++;
+                    return false;
+                }
+                if (s.count == DEPTH) {
+                    s.head = (s.head + 1) % DEPTH;
+                    s.count--;
+                    s.overflows++;
+                }
+                s.samples[(s.head + s.count) % DEPTH] = {t_us, value};
+                s.count++;
+                if (!started) {
+                    next_frame_us = t_us - t_us % period_us + period_us;
+                    started = true;
+                }
+                return true;
+            }
+
+            // Emits every frame that is ready at `now_us`; returns how many
+            template <typename Sink>
+            size_t process(uint32_t now_us, Sink&& sink) {
+                if (!started) return 0;
+
+                // Far behind (stalled caller): jump instead of replaying stale frames
+                uint32_t backlog_us = (uint32_t)DEPTH * period_us;
+                if ((int32_t)(now_us - next_frame_us) > (int32_t)(backlog_us + max_latency_us)) {
+                    uint32_t target = now_us - max_latency_us;
+                    uint32_t skip = (target - next_frame_us) / period_us;
+                    next_frame_us += skip * period_us;
+                    skipped += skip;
+                }
+
+                size_t emitted = 0;
+                while ((int32_t)(now_us - next_frame_us) >= 0 && isReady(next_frame_us, now_us)) {
+                    Frame frame;
+                    frame.t_us = next_frame_us;
+                    frame.stream_count = stream_count;
+                    for (uint8_t i = 0; i < stream_count; i++) {
+                        bool held = false;
+                        if (valueAt(streams[i], next_frame_us, frame.values[i], held)) {
+                            frame.valid_mask |= 1u << i;
+                            if (held) frame.held_mask |= 1u << i;
+                        } else {
+                            frame.values[i] = NAN;
+                        }
+                    }
+                    sink(frame);
+                    frames++;
+                    emitted++;
+                    next_frame_us += period_us;
+                }
+                return emitted;
+            }
+
+            uint32_t getFrameCount() const { return frames; }
+            uint32_t getSkippedFrames() const { return skipped; }
+            uint32_t getOverflowCount(uint8_t stream) const { return stream < stream_count ? streams[stream].overflows : 0; }
+            uint32_t getRejectedCount(uint8_t stream) const { return stream < stream_count ? streams[stream].rejected : 0; }
+            size_t getBuffered(uint8_t stream) const { return stream < stream_count ? streams[stream].count : 0; }
+
+        private:
+            struct Sample {
+                uint32_t t_us;
+                float value;
+            };
+
+            struct Stream {
+                const char* name = "";
+                AlignMode mode = AlignMode::INTERPOLATE;
+                uint32_t max_age_us = 1000000;
+                Sample samples[DEPTH];
+                size_t head = 0;            // oldest sample
+                size_t count = 0;
+                uint32_t overflows = 0;
+                uint32_t rejected = 0;
+
+                const Sample& at(size_t i) const { return samples[(head + i) % DEPTH]; }
+                const Sample& newest() const { return at(count - 1); }
+            };
+
+            Stream streams[MAX_STREAMS];
+            uint8_t stream_count = 0;
+            uint32_t period_us = 10000;         // 100 Hz
+            uint32_t max_latency_us = 50000;
+            uint32_t next_frame_us = 0;
+            bool started = false;
+            uint32_t frames = 0;
+            uint32_t skipped = 0;
+
+            bool isReady(uint32_t t_us, uint32_t now_us) const {
+                if (now_us - t_us >= max_latency_us) return true;
+                for (uint8_t i = 0; i < stream_count; i++) {
+                    const Stream& s = streams[i];
+                    if (s.mode != AlignMode::INTERPOLATE || s.count == 0) continue;
+                    if ((int32_t)(s.newest().t_us - t_us) < 0) return false;
+                }
+                return true;
+            }
+
+            // Frame times only move forward, so samples before the one at or
+            // below t_us are dropped as we go
+            bool valueAt(Stream& s, uint32_t t_us, float& value, bool& held) {
+                while (s.count >= 2 && (int32_t)(s.at(1).t_us - t_us) <= 0) {
+                    s.head = (s.head + 1) % DEPTH;
+                    s.count--;
+                }
+                if (s.count == 0 || (int32_t)(s.at(0).t_us - t_us) > 0) return false;
+
+                const Sample& a = s.at(0);
+                if (s.count == 1 || s.mode == AlignMode::HOLD) {
+                    if (t_us - a.t_us > s.max_age_us) return false;
+                    value = a.value;
+                    held = true;
+                    return true;
+                }
+                const Sample& b = s.at(1);
+                if (b.t_us - a.t_us > s.max_age_us) return false;     // dropout: don't bridge it
+                float span = (float)(b.t_us - a.t_us);
+                value = a.value + (b.value - a.value) * ((float)(t_us - a.t_us) / span);
+                return true;
+            }
+    };
+} // namespace overseer::device::sync
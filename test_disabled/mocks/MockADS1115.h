@@ -0,0 +1,124 @@
+#ifndef MOCK_ADS1115_H
+#define MOCK_ADS1115_H
+
+#include <stdint.h>
+#include <cstdlib>
+
+// Simulated multi-device I2C bus for ADS1115 tests.
+// Time is virtual: every transaction advances the bus clock, and each chip
+// finishes a conversion `conversion_us` after it was requested. Like the real
+// ADS1X15 library, gain/rate/mode are cached and only sent with requestADC().
+class MockI2CBus {
+public:
+    struct Device {
+        bool present = false;
+        float volts[4] = {0.0f, 0.0f, 0.0f, 0.0f};  // analog input seen by each pin
+        int16_t noise_lsb = 0;          // uniform +/- noise added to every conversion
+        int8_t pending = -1;            // positive input of the conversion in flight
+        int8_t pending_neg = -1;        // negative input, -1 = GND (single-ended)
+        uint8_t pending_gain = 0;
+        uint32_t ready_at_us = 0;
+        uint32_t conversions = 0;
+    };
+
+    static const uint8_t BASE_ADDRESS = 0x48;
+    Device devices[4];
+    uint32_t now_us = 0;
+    uint32_t transaction_us = 100;      // ~3 bytes at 400 kHz incl. overhead
+    uint32_t conversion_us = 1200;      // 860 SPS
+
+    Device* find(uint8_t address) {
+        if (address < BASE_ADDRESS || address >= BASE_ADDRESS + 4) return nullptr;
+        Device* dev = &devices[address - BASE_ADDRESS];
+        return dev->present ? dev : nullptr;
+    }
+
+    void transaction() { now_us += transaction_us; }
+
+    static float fullScale(uint8_t gain) {
+        switch (gain) {
+            case 1:  return 4.096f;
+            case 2:  return 2.048f;
+            case 4:  return 1.024f;
+            case 8:  return 0.512f;
+            case 16: return 0.256f;
+            default: return 6.144f;
+        }
+    }
+
+    int16_t convert(Device& dev) {
+        float volts = dev.volts[dev.pending] - (dev.pending_neg >= 0 ? dev.volts[dev.pending_neg] : 0.0f);
+        long value = (long)(volts / fullScale(dev.pending_gain) * 32767.0f);
+        if (dev.noise_lsb) value += (rand() % (2 * dev.noise_lsb + 1)) - dev.noise_lsb;
+        if (value > 32767) value = 32767;
+        if (value < -32768) value = -32768;
+        dev.conversions++;
+        return (int16_t)value;
+    }
+};
+
+class MockADS1115 {
+public:
+    MockADS1115(uint8_t address, MockI2CBus* bus) : _address(address), _bus(bus) {}
+
+    bool begin() { return true; }
+    bool isConnected() { _bus->transaction(); return _bus->find(_address) != nullptr; }
+    void setGain(uint8_t gain) { _gain = gain; }
+    uint8_t getGain() { return _gain; }
+    void setDataRate(uint8_t) {}
+    void setMode(uint8_t) {}
+
+    void requestADC(uint8_t input) { requestPair(input, -1); }
+    void requestADC_Differential_0_1() { requestPair(0, 1); }
+    void requestADC_Differential_0_3() { requestPair(0, 3); }
+    void requestADC_Differential_1_3() { requestPair(1, 3); }
+    void requestADC_Differential_2_3() { requestPair(2, 3); }
+
+    bool isReady() {
+        _bus->transaction();
+        MockI2CBus::Device* dev = _bus->find(_address);
+        return dev && dev->pending >= 0 && _bus->now_us >= dev->ready_at_us;
+    }
+
+    bool isBusy() { return !isReady(); }
+
+    int16_t getValue() {
+        _bus->transaction();
+        MockI2CBus::Device* dev = _bus->find(_address);
+        if (!dev || dev->pending < 0) return 0;
+        int16_t value = _bus->convert(*dev);
+        dev->pending = -1;
+        return value;
+    }
+
+    // Blocking reads, wait out the conversion on the virtual clock
+    int16_t readADC(uint8_t input) { requestADC(input); return waitValue(); }
+    int16_t readADC_Differential_0_1() { requestADC_Differential_0_1(); return waitValue(); }
+    int16_t readADC_Differential_0_3() { requestADC_Differential_0_3(); return waitValue(); }
+    int16_t readADC_Differential_1_3() { requestADC_Differential_1_3(); return waitValue(); }
+    int16_t readADC_Differential_2_3() { requestADC_Differential_2_3(); return waitValue(); }
+
+private:
+    void requestPair(int8_t pos, int8_t neg) {
+        _bus->transaction();
+        MockI2CBus::Device* dev = _bus->find(_address);
+        if (!dev) return;
+        dev->pending = pos;
+        dev->pending_neg = neg;
+        dev->pending_gain = _gain;
+        dev->ready_at_us = _bus->now_us + _bus->conversion_us;
+    }
+
+    int16_t waitValue() {
+        MockI2CBus::Device* dev = _bus->find(_address);
+        if (!dev) return 0;
+        if (_bus->now_us < dev->ready_at_us) _bus->now_us = dev->ready_at_us;
+        return getValue();
+    }
+
+    uint8_t _address;
+    MockI2CBus* _bus;
+    uint8_t _gain = 0;
+};
+
+#endif
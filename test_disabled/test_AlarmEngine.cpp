@@ -0,0 +1,210 @@
+// test/test_AlarmEngine.cpp
+#include <unity.h>
+#include "arduino_compat.h"
+#include "device/alarm/AlarmEngine.h"
+
+using namespace overseer::device::alarm;
+
+// Global test objects
+AlarmEngine* engine = nullptr;
+
+static AlarmRule highRule(uint8_t signal, float high, float hysteresis = 0.0f, unsigned long min_duration_ms = 0) {
+    AlarmRule rule;
+    rule.signal = signal;
+    rule.high = high;
+    rule.hysteresis = hysteresis;
+    rule.min_duration_ms = min_duration_ms;
+    return rule;
+}
+
+static int drain(AlarmEngine& alarms) {
+    AlarmEvent event;
+    int count = 0;
+    while (alarms.poll(event)) count++;
+    return count;
+}
+
+void setUp(void) {
+    engine = new AlarmEngine();
+}
+
+void tearDown(void) {
+    delete engine;
+    engine = nullptr;
+}
+
+// ============================================================================
+// THRESHOLD TESTS
+// ============================================================================
+
+void test_high_threshold_raises_on_first_sample(void) {
+    int id = engine->addRule(highRule(0, 10.0f));
+    engine->evaluate(0, 9.0f, 100);
+    TEST_ASSERT_FALSE(engine->isActive(id));
+
+    engine->evaluate(0, 11.0f, 110);
+    AlarmEvent event;
+    TEST_ASSERT_TRUE(engine->poll(event));
+    TEST_ASSERT_EQUAL(id, event.rule);
+    TEST_ASSERT_TRUE(event.type == AlarmType::OVER);
+    TEST_ASSERT_TRUE(event.raised);
+    TEST_ASSERT_EQUAL_UINT32(110, event.timestamp);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 11.0f, event.value);
+    TEST_ASSERT_FALSE(engine->poll(event));
+}
+
+void test_low_threshold_raises_and_clears(void) {
+    AlarmRule rule;
+    rule.signal = 3;
+    rule.low = 1.0f;
+    engine->addRule(rule);
+
+    engine->evaluate(3, 0.5f, 0);
+    engine->evaluate(3, 1.5f, 10);
+
+    AlarmEvent event;
+    TEST_ASSERT_TRUE(engine->poll(event));
+    TEST_ASSERT_TRUE(event.type == AlarmType::UNDER && event.raised);
+    TEST_ASSERT_TRUE(engine->poll(event));
+    TEST_ASSERT_TRUE(event.type == AlarmType::UNDER && !event.raised);
+}
+
+void test_hysteresis_suppresses_chatter(void) {
+    int id = engine->addRule(highRule(0, 10.0f, 1.0f));
+    const float samples[] = {10.5f, 9.8f, 10.2f, 9.5f, 10.4f, 9.1f, 8.9f};
+    for (int i = 0; i < 7; i++) engine->evaluate(0, samples[i], i * 10);
+
+    // One raise, one clear once below 9.0
+    TEST_ASSERT_EQUAL(2, drain(*engine));
+    TEST_ASSERT_FALSE(engine->isActive(id));
+}
+
+void test_other_signals_are_ignored(void) {
+    engine->addRule(highRule(1, 10.0f));
+    engine->evaluate(0, 50.0f, 0);
+    engine->evaluate(2, 50.0f, 0);
+    TEST_ASSERT_EQUAL(0, drain(*engine));
+}
+
+// ============================================================================
+// DURATION / RATE TESTS
+// ============================================================================
+
+void test_min_duration_delays_raise(void) {
+    int id = engine->addRule(highRule(0, 10.0f, 0.0f, 50));
+    engine->evaluate(0, 12.0f, 1000);
+    engine->evaluate(0, 12.0f, 1040);
+    TEST_ASSERT_FALSE(engine->isActive(id));
+
+    engine->evaluate(0, 12.0f, 1050);
+    TEST_ASSERT_TRUE(engine->isActive(id));
+    TEST_ASSERT_EQUAL(1, drain(*engine));
+}
+
+void test_min_duration_restarts_after_dropout(void) {
+    int id = engine->addRule(highRule(0, 10.0f, 0.0f, 50));
+    engine->evaluate(0, 12.0f, 1000);
+    engine->evaluate(0, 8.0f, 1030);      // brief dip resets the timer
+    engine->evaluate(0, 12.0f, 1040);
+    engine->evaluate(0, 12.0f, 1060);
+    TEST_ASSERT_FALSE(engine->isActive(id));
+    engine->evaluate(0, 12.0f, 1090);
+    TEST_ASSERT_TRUE(engine->isActive(id));
+}
+
+void test_rate_of_change_trigger(void) {
+    AlarmRule rule;
+    rule.signal = 0;
+    rule.max_rate = 100.0f;     // units per second
+    int id = engine->addRule(rule);
+
+    engine->evaluate(0, 0.0f, 0);
+    engine->evaluate(0, 0.5f, 10);        // 50/s
+    TEST_ASSERT_FALSE(engine->isActive(id));
+    engine->evaluate(0, 2.5f, 20);        // 200/s
+    TEST_ASSERT_TRUE(engine->isActive(id));
+
+    AlarmEvent event;
+    TEST_ASSERT_TRUE(engine->poll(event));
+    TEST_ASSERT_TRUE(event.type == AlarmType::RATE);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 200.0f, event.value);
+}
+
+// ============================================================================
+// QUEUE TESTS
+// ============================================================================
+
+void test_queue_preserves_order(void) {
+    EventQueue<int, 4> queue;
+    for (int i = 0; i < 4; i++) TEST_ASSERT_TRUE(queue.push(i));
+    int value;
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(queue.pop(value));
+        TEST_ASSERT_EQUAL(i, value);
+    }
+    TEST_ASSERT_FALSE(queue.pop(value));
+}
+
+void test_queue_drops_when_full(void) {
+    EventQueue<int, 4> queue;
+    for (int i = 0; i < 6; i++) queue.push(i);
+    TEST_ASSERT_EQUAL(4, queue.size());
+    TEST_ASSERT_EQUAL_UINT32(2, queue.dropped());
+
+    int value;
+    queue.pop(value);
+    TEST_ASSERT_EQUAL(0, value);          // oldest events are kept
+    TEST_ASSERT_TRUE(queue.push(99));
+}
+
+void test_queue_wraps_indices(void) {
+    EventQueue<int, 2> queue;
+    int value = 0;
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT_TRUE(queue.push(i));
+        TEST_ASSERT_TRUE(queue.pop(value));
+        TEST_ASSERT_EQUAL(i, value);
+    }
+    TEST_ASSERT_TRUE(queue.empty());
+}
+
+void test_rule_table_full(void) {
+    for (int i = 0; i < AlarmEngine::MAX_RULES; i++) {
+        TEST_ASSERT_EQUAL(i, engine->addRule(highRule(0, 1.0f)));
+    }
+    TEST_ASSERT_EQUAL(-1, engine->addRule(highRule(0, 1.0f)));
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void runAllTests(void) {
+    UNITY_BEGIN();
+
+    // Threshold tests
+    RUN_TEST(test_high_threshold_raises_on_first_sample);
+    RUN_TEST(test_low_threshold_raises_and_clears);
+    RUN_TEST(test_hysteresis_suppresses_chatter);
+    RUN_TEST(test_other_signals_are_ignored);
+
+    // Duration / rate tests
+    RUN_TEST(test_min_duration_delays_raise);
+    RUN_TEST(test_min_duration_restarts_after_dropout);
+    RUN_TEST(test_rate_of_change_trigger);
+
+    // Queue tests
+    RUN_TEST(test_queue_preserves_order);
+    RUN_TEST(test_queue_drops_when_full);
+    RUN_TEST(test_queue_wraps_indices);
+    RUN_TEST(test_rule_table_full);
+
+    UNITY_END();
+}
+
+#ifndef ARDUINO
+int main() {
+    runAllTests();
+    return 0;
+}
+#endif
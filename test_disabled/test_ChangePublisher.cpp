@@ -0,0 +1,253 @@
+// test/test_ChangePublisher.cpp
+#include <unity.h>
+#include "arduino_compat.h"
+#include "device/report/ChangePublisher.h"
+#include "device/energy/WCS1800/WCSData.h"
+
+#include <vector>
+
+using namespace overseer::device::report;
+using namespace overseer::device::energy::data;
+
+// Global test objects
+ChangePublisher* publisher = nullptr;
+WCSData* sample = nullptr;
+std::vector<String> sent;
+
+static PublishResult publishAt(unsigned long now) {
+    sent.clear();
+    return publisher->publish(*sample, now, [](const char* name, const char* window, float) {
+        sent.push_back(window ? String(name) + "[" + window + "]" : String(name));
+    });
+}
+
+static bool wasSent(const char* field) {
+    for (const String& s : sent) {
+        if (s == field) return true;
+    }
+    return false;
+}
+
+static size_t scalarFieldCount() {
+    size_t count = 0;
+    visitFields(*sample, [&count](const char*, const char*, float) { count++; });
+    return count;
+}
+
+void setUp(void) {
+    publisher = new ChangePublisher();
+    publisher->setKeyframeInterval(10000);
+    publisher->setDeadband("current", 0.1f);
+    sample = new WCSData();
+    sample->current = 2.0f;
+}
+
+void tearDown(void) {
+    delete publisher;
+    delete sample;
+    publisher = nullptr;
+    sample = nullptr;
+}
+
+// ============================================================================
+// CHANGE DETECTION TESTS
+// ============================================================================
+
+void test_first_publish_is_full_keyframe(void) {
+    PublishResult r = publishAt(0);
+    TEST_ASSERT_TRUE(r.keyframe);
+    TEST_ASSERT_EQUAL(scalarFieldCount(), r.emitted);
+    TEST_ASSERT_EQUAL(0, r.suppressed);
+}
+
+void test_unchanged_snapshot_is_suppressed(void) {
+    publishAt(0);
+    PublishResult r = publishAt(1000);
+    TEST_ASSERT_FALSE(r.keyframe);
+    TEST_ASSERT_EQUAL(0, r.emitted);
+    TEST_ASSERT_EQUAL(scalarFieldCount(), r.suppressed);
+}
+
+void test_only_changed_fields_are_sent(void) {
+    publishAt(0);
+    sample->current = 2.5f;
+    sample->power = 12.0f;
+    PublishResult r = publishAt(1000);
+    TEST_ASSERT_EQUAL(2, r.emitted);
+    TEST_ASSERT_TRUE(wasSent("current"));
+    TEST_ASSERT_TRUE(wasSent("power"));
+}
+
+void test_deadband_compares_against_last_published(void) {
+    publishAt(0);
+
+    // Three 0.04 A steps: each inside the 0.1 A deadband, together past it
+    sample->current = 2.04f;
+    TEST_ASSERT_EQUAL(0, publishAt(1000).emitted);
+    sample->current = 2.08f;
+    TEST_ASSERT_EQUAL(0, publishAt(2000).emitted);
+    sample->current = 2.12f;
+    TEST_ASSERT_EQUAL(1, publishAt(3000).emitted);
+    TEST_ASSERT_TRUE(wasSent("current"));
+
+    // Reference moved to 2.12
+    sample->current = 2.05f;
+    TEST_ASSERT_EQUAL(0, publishAt(4000).emitted);
+}
+
+void test_nan_transitions_are_changes(void) {
+    sample->bus_voltage = NAN;
+    publishAt(0);
+    TEST_ASSERT_EQUAL(0, publishAt(1000).emitted);      // NaN -> NaN is not a change
+
+    sample->bus_voltage = 12.0f;
+    publishAt(2000);
+    TEST_ASSERT_TRUE(wasSent("bus_voltage"));
+
+    sample->bus_voltage = NAN;
+    publishAt(3000);
+    TEST_ASSERT_TRUE(wasSent("bus_voltage"));
+}
+
+// ============================================================================
+// KEYFRAME TESTS
+// ============================================================================
+
+void test_keyframe_interval_resends_everything(void) {
+    publishAt(0);
+    TEST_ASSERT_FALSE(publishAt(9999).keyframe);
+    PublishResult r = publishAt(10000);
+    TEST_ASSERT_TRUE(r.keyframe);
+    TEST_ASSERT_EQUAL(scalarFieldCount(), r.emitted);
+    TEST_ASSERT_EQUAL(2, publisher->getKeyframeCount());
+}
+
+void test_force_keyframe(void) {
+    publishAt(0);
+    publisher->forceKeyframe();
+    TEST_ASSERT_TRUE(publisher->isKeyframeDue(1));
+    TEST_ASSERT_TRUE(publishAt(1).keyframe);
+    TEST_ASSERT_FALSE(publishAt(2).keyframe);
+}
+
+void test_new_window_is_published_without_keyframe(void) {
+    sample->max_current_windows["1s"] = 3.0f;
+    publishAt(0);
+
+    sample->max_current_windows["5s"] = 3.0f;
+    PublishResult r = publishAt(1000);
+    TEST_ASSERT_FALSE(r.keyframe);
+    TEST_ASSERT_TRUE(wasSent("max_current[5s]"));
+    TEST_ASSERT_FALSE(wasSent("max_current[1s]"));
+
+    // Tracking settled on the new shape
+    TEST_ASSERT_EQUAL(0, publishAt(2000).emitted);
+}
+
+void test_steady_state_bandwidth(void) {
+    publishAt(0);
+    // One minute at 10 Hz with sensor noise inside the deadband
+    for (unsigned long t = 100; t < 60000; t += 100) {
+        sample->current = 2.0f + ((t / 100) % 2 ? 0.03f : -0.03f);
+        publishAt(t);
+    }
+    // 6 keyframes' worth of fields instead of 600 snapshots
+    TEST_ASSERT_EQUAL(6, publisher->getKeyframeCount());
+    TEST_ASSERT_EQUAL(6 * scalarFieldCount(), publisher->getEmittedCount());
+}
+
+// ============================================================================
+// PRINT AND CONFIG TESTS
+// ============================================================================
+
+// Collects println() lines like Serial would print them
+struct LineCollector {
+    std::vector<String> lines;
+    void println(const char* line) { lines.push_back(String(line)); }
+};
+
+// Answers the reporting keys of one section, defaults for everything else
+struct ReportConfig {
+    int getInt(const char* section, const char* key, int defaultValue) const {
+        if (strcmp(section, "wcs1800") == 0 && strcmp(key, "report_keyframe_s") == 0) return 5;
+        return defaultValue;
+    }
+    float getFloat(const char* section, const char* key, float defaultValue) const {
+        if (strcmp(section, "wcs1800") != 0) return defaultValue;
+        if (strcmp(key, "report_deadband") == 0) return 0.5f;
+        if (strcmp(key, "deadband_current") == 0) return 1.0f;
+        return defaultValue;
+    }
+};
+
+void test_print_changes_formats_sparse_record(void) {
+    LineCollector out;
+    printChanges(*publisher, *sample, "WCS1800", 0, out);
+    TEST_ASSERT_TRUE(out.lines.size() > 1);                     // a keyframe wraps
+    TEST_ASSERT_EQUAL(0, strncmp(out.lines[0].c_str(), "WCS1800 K current=2.000", 23));
+    TEST_ASSERT_EQUAL(0, strncmp(out.lines[1].c_str(), "  + ", 4));
+
+    out.lines.clear();
+    sample->current = 2.5f;
+    sample->voltage = 1.25f;
+    PublishResult r = printChanges(*publisher, *sample, "WCS1800", 100, out);
+    TEST_ASSERT_EQUAL(2, r.emitted);
+    TEST_ASSERT_EQUAL(1, out.lines.size());
+    TEST_ASSERT_EQUAL_STRING("WCS1800 D current=2.500 voltage=1.250", out.lines[0].c_str());
+
+    // Nothing moved: no line at all
+    out.lines.clear();
+    printChanges(*publisher, *sample, "WCS1800", 200, out);
+    TEST_ASSERT_EQUAL(0, out.lines.size());
+}
+
+void test_load_config_reads_reporting_keys(void) {
+    ReportConfig config;
+    loadConfig(*publisher, config, "wcs1800", *sample);
+    TEST_ASSERT_EQUAL(5000, publisher->getKeyframeInterval());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, publisher->getDeadband("current"));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f, publisher->getDeadband("voltage"));
+
+    // Absent keys keep what the device set
+    ChangePublisher other;
+    other.setKeyframeInterval(10000);
+    other.setDeadband("current", 0.1f);
+    loadConfig(other, config, "mpu6000", *sample);
+    TEST_ASSERT_EQUAL(10000, other.getKeyframeInterval());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.1f, other.getDeadband("current"));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, other.getDeadband("voltage"));
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void runAllTests(void) {
+    UNITY_BEGIN();
+
+    // Change detection tests
+    RUN_TEST(test_first_publish_is_full_keyframe);
+    RUN_TEST(test_unchanged_snapshot_is_suppressed);
+    RUN_TEST(test_only_changed_fields_are_sent);
+    RUN_TEST(test_deadband_compares_against_last_published);
+    RUN_TEST(test_nan_transitions_are_changes);
+
+    // Keyframe tests
+    RUN_TEST(test_keyframe_interval_resends_everything);
+    RUN_TEST(test_force_keyframe);
+    RUN_TEST(test_new_window_is_published_without_keyframe);
+    RUN_TEST(test_steady_state_bandwidth);
+
+    // Print and config tests
+    RUN_TEST(test_print_changes_formats_sparse_record);
+    RUN_TEST(test_load_config_reads_reporting_keys);
+
+    UNITY_END();
+}
+
+#ifndef ARDUINO
+int main() {
+    runAllTests();
+    return 0;
+}
+#endif
@@ -0,0 +1,274 @@
+// test/test_DHTReader.cpp
+#include <unity.h>
+#include "arduino_compat.h"
+#include "device/environment/DHTReader.h"
+
+#include <vector>
+
+using namespace overseer::device::environment::dht;
+
+// Simulated data line: the reader's ISR is invoked for every edge of a pulse train
+struct FakePin {
+    static uint32_t clock_us;
+    static uint8_t level;
+    static bool driven_low;
+    static void (*isr)(void*);
+    static void* isr_arg;
+    static void (*timer)(void*);
+    static void* timer_arg;
+    static uint32_t timer_due_us;
+
+    static uint32_t now_us() { return clock_us; }
+    uint8_t read() const { return level; }
+    void driveLow() { driven_low = true; level = 0; }
+    void release() { driven_low = false; level = 1; }
+    void startCapture(void (*fn)(void*), void* arg) { isr = fn; isr_arg = arg; }
+    void stopCapture() { isr = nullptr; isr_arg = nullptr; }
+    void waitUs(uint32_t us) { clock_us += us; }
+    void armTimer(uint32_t us, void (*fn)(void*), void* arg) {
+        timer = fn;
+        timer_arg = arg;
+        timer_due_us = clock_us + us;
+    }
+};
+
+uint32_t FakePin::clock_us = 0;
+uint8_t FakePin::level = 1;
+bool FakePin::driven_low = false;
+void (*FakePin::isr)(void*) = nullptr;
+void* FakePin::isr_arg = nullptr;
+void (*FakePin::timer)(void*) = nullptr;
+void* FakePin::timer_arg = nullptr;
+uint32_t FakePin::timer_due_us = 0;
+
+// Advances the clock, firing the one-shot timer on its deadline like esp_timer would
+static void runClockTo(uint32_t us) {
+    if (FakePin::timer && us >= FakePin::timer_due_us) {
+        FakePin::clock_us = FakePin::timer_due_us;
+        void (*fn)(void*) = FakePin::timer;
+        FakePin::timer = nullptr;
+        fn(FakePin::timer_arg);
+    }
+    FakePin::clock_us = us;
+}
+
+// Sensor reply as (time, level) edges: response 80 us low / 80 us high, then per
+// bit 50 us low + 26 us (0) or 70 us (1) high, then release. `jitter` skews
+// every pulse by up to +/- jitter us.
+static std::vector<DHTEdge> pulseTrain(const uint8_t bytes[5], uint32_t start_us, int jitter = 0) {
+    std::vector<DHTEdge> edges;
+    uint32_t seed = 12345;
+    auto skew = [&](uint32_t us) {
+        if (jitter == 0) return us;
+        seed = seed * 1664525u + 1013904223u;
+        return (uint32_t)((int)us + (int)(seed >> 16) % (2 * jitter + 1) - jitter);
+    };
+    uint32_t t = start_us + 30;
+    edges.push_back({t, 0});
+    t += skew(80);
+    edges.push_back({t, 1});
+    t += skew(80);
+    edges.push_back({t, 0});
+    for (int bit = 0; bit < 40; bit++) {
+        t += skew(50);
+        edges.push_back({t, 1});
+        bool one = (bytes[bit / 8] >> (7 - bit % 8)) & 1;
+        t += skew(one ? 70 : 26);
+        edges.push_back({t, 0});
+    }
+    t += 50;
+    edges.push_back({t, 1});
+    return edges;
+}
+
+static void frame(uint8_t out[5], uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3) {
+    out[0] = b0;
+    out[1] = b1;
+    out[2] = b2;
+    out[3] = b3;
+    out[4] = (uint8_t)(b0 + b1 + b2 + b3);
+}
+
+static void play(const std::vector<DHTEdge>& edges) {
+    for (const DHTEdge& e : edges) {
+        runClockTo(e.us);
+        FakePin::level = e.level;
+        if (FakePin::isr) FakePin::isr(FakePin::isr_arg);
+    }
+}
+
+// Global test objects; heap-allocated so FakePin::isr_arg never points into a finished stack frame
+DHTReaderT<FakePin>* testReader = nullptr;
+
+static DHTReaderT<FakePin>& makeReader(uint8_t type) {
+    delete testReader;
+    testReader = new DHTReaderT<FakePin>(FakePin(), type);
+    return *testReader;
+}
+
+void setUp(void) {
+    FakePin::clock_us = 0;
+    FakePin::level = 1;
+    FakePin::driven_low = false;
+    FakePin::isr = nullptr;
+    FakePin::timer = nullptr;
+}
+
+void tearDown(void) {
+    FakePin::isr = nullptr;
+    FakePin::isr_arg = nullptr;
+    FakePin::timer = nullptr;
+    FakePin::timer_arg = nullptr;
+    delete testReader;
+    testReader = nullptr;
+}
+
+// ============================================================================
+// DECODER TESTS
+// ============================================================================
+
+void test_decode_dht22_negative_temperature(void) {
+    uint8_t sent[5], got[5];
+    frame(sent, 0x02, 0x8D, 0x80, 0x65);            // 65.3 %, -10.1 C
+    std::vector<DHTEdge> edges = pulseTrain(sent, 0);
+    TEST_ASSERT_EQUAL(FRAME_EDGES, edges.size());
+    TEST_ASSERT_TRUE(decodeFrame(edges.data(), edges.size(), got) == DHTStatus::OK);
+    TEST_ASSERT_EQUAL_MEMORY(sent, got, 5);
+
+    float h, t;
+    convertFrame(TYPE_DHT22, got, h, t);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 65.3f, h);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -10.1f, t);
+}
+
+void test_decode_dht11(void) {
+    uint8_t sent[5], got[5];
+    frame(sent, 45, 0, 23, 4);                      // 45 %, 23.4 C
+    std::vector<DHTEdge> edges = pulseTrain(sent, 0);
+    TEST_ASSERT_TRUE(decodeFrame(edges.data(), edges.size(), got) == DHTStatus::OK);
+    float h, t;
+    convertFrame(TYPE_DHT11, got, h, t);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 45.0f, h);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 23.4f, t);
+}
+
+void test_decode_tolerates_jitter_and_leading_edges(void) {
+    uint8_t sent[5], got[5];
+    frame(sent, 0x01, 0xF4, 0x00, 0xFA);
+    std::vector<DHTEdge> edges = pulseTrain(sent, 100, 15);     // ISR latency skews every pulse
+    edges.insert(edges.begin(), DHTEdge{100, 1});               // host release captured first
+    TEST_ASSERT_TRUE(decodeFrame(edges.data(), edges.size(), got) == DHTStatus::OK);
+    TEST_ASSERT_EQUAL_MEMORY(sent, got, 5);
+}
+
+void test_decode_rejects_bad_frames(void) {
+    uint8_t sent[5], got[5];
+    frame(sent, 0x02, 0x8D, 0x00, 0xE0);
+    std::vector<DHTEdge> edges = pulseTrain(sent, 0);
+
+    sent[4] ^= 0x01;
+    std::vector<DHTEdge> corrupt = pulseTrain(sent, 0);
+    TEST_ASSERT_TRUE(decodeFrame(corrupt.data(), corrupt.size(), got) == DHTStatus::CHECKSUM);
+
+    TEST_ASSERT_TRUE(decodeFrame(edges.data(), 40, got) == DHTStatus::INCOMPLETE);
+    TEST_ASSERT_TRUE(decodeFrame(edges.data(), 0, got) == DHTStatus::NO_RESPONSE);
+
+    // A lost falling edge merges two bits into one long high pulse
+    std::vector<DHTEdge> lost = edges;
+    lost.erase(lost.begin() + 40, lost.begin() + 42);
+    TEST_ASSERT_TRUE(decodeFrame(lost.data(), lost.size(), got) == DHTStatus::TIMING);
+}
+
+// ============================================================================
+// READER TESTS
+// ============================================================================
+
+void test_reader_runs_without_blocking(void) {
+    DHTReaderT<FakePin>& reader = makeReader(TYPE_DHT22);
+    TEST_ASSERT_TRUE(reader.start(0));
+    TEST_ASSERT_FALSE(reader.start(10));            // one transaction at a time
+
+    // The 1.1 ms start signal is held inside start(), which returns capturing
+    TEST_ASSERT_EQUAL_UINT32(1100, FakePin::clock_us);
+    TEST_ASSERT_FALSE(FakePin::driven_low);
+    TEST_ASSERT_TRUE(FakePin::isr != nullptr);
+    TEST_ASSERT_TRUE(reader.poll(1100) == DHTStatus::BUSY);
+
+    uint8_t sent[5];
+    frame(sent, 0x01, 0x90, 0x00, 0xEB);            // 40.0 %, 23.5 C
+    play(pulseTrain(sent, 1100, 10));
+    TEST_ASSERT_EQUAL(FRAME_EDGES, reader.getEdgeCount());
+
+    TEST_ASSERT_TRUE(reader.poll(FakePin::clock_us) == DHTStatus::OK);
+    TEST_ASSERT_FALSE(reader.isBusy());
+    TEST_ASSERT_TRUE(FakePin::isr == nullptr);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 40.0f, reader.getReading().humidity);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 23.5f, reader.getReading().temperature);
+}
+
+void test_reader_times_out_without_sensor(void) {
+    DHTReaderT<FakePin>& reader = makeReader(TYPE_DHT11);
+    TEST_ASSERT_EQUAL(20000, reader.startSignalUs());
+    reader.start(0);
+    TEST_ASSERT_TRUE(FakePin::driven_low);          // 20 ms signal: ended by the timer, not by start()
+    runClockTo(20000);
+    TEST_ASSERT_FALSE(FakePin::driven_low);
+    TEST_ASSERT_TRUE(reader.poll(20000 + CAPTURE_TIMEOUT_US - 1) == DHTStatus::BUSY);
+    TEST_ASSERT_TRUE(reader.poll(20000 + CAPTURE_TIMEOUT_US) == DHTStatus::NO_RESPONSE);
+    TEST_ASSERT_FALSE(reader.isBusy());
+    TEST_ASSERT_TRUE(isnan(reader.getReading().humidity));
+
+    // Next transaction starts clean
+    FakePin::clock_us = 40000;
+    TEST_ASSERT_TRUE(reader.start(40000));
+    TEST_ASSERT_TRUE(reader.poll(40001) == DHTStatus::BUSY);
+}
+
+void test_reader_decodes_when_polled_late(void) {
+    // An application polling every few hundred ms must not stretch the start signal
+    uint8_t sent[5];
+    frame(sent, 0x01, 0x90, 0x00, 0xEB);            // 40.0 %, 23.5 C
+
+    DHTReaderT<FakePin>& dht22 = makeReader(TYPE_DHT22);
+    dht22.start(0);
+    play(pulseTrain(sent, FakePin::clock_us, 10));
+    TEST_ASSERT_TRUE(dht22.poll(500000) == DHTStatus::OK);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 23.5f, dht22.getReading().temperature);
+
+    FakePin::clock_us = 1000000;
+    DHTReaderT<FakePin>& dht11 = makeReader(TYPE_DHT11);
+    frame(sent, 45, 0, 23, 4);                      // 45 %, 23.4 C
+    dht11.start(FakePin::clock_us);
+    play(pulseTrain(sent, 1020000, 10));            // timer releases the line at 20 ms, no poll() in between
+    TEST_ASSERT_EQUAL(FRAME_EDGES, dht11.getEdgeCount());
+    TEST_ASSERT_TRUE(dht11.poll(1600000) == DHTStatus::OK);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 45.0f, dht11.getReading().humidity);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void runAllTests(void) {
+    UNITY_BEGIN();
+
+    // Decoder tests
+    RUN_TEST(test_decode_dht22_negative_temperature);
+    RUN_TEST(test_decode_dht11);
+    RUN_TEST(test_decode_tolerates_jitter_and_leading_edges);
+    RUN_TEST(test_decode_rejects_bad_frames);
+
+    // Reader tests
+    RUN_TEST(test_reader_runs_without_blocking);
+    RUN_TEST(test_reader_times_out_without_sensor);
+    RUN_TEST(test_reader_decodes_when_polled_late);
+
+    UNITY_END();
+}
+
+#ifndef ARDUINO
+int main() {
+    runAllTests();
+    return 0;
+}
+#endif
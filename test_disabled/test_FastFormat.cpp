@@ -0,0 +1,178 @@
+// test/test_FastFormat.cpp
+#include <unity.h>
+#include "arduino_compat.h"
+#include "device/report/FastFormat.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+using namespace overseer::device::report;
+using namespace overseer::device::report::format;
+
+typedef LineBuffer<16> SmallLine;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static const char* fmt(float value, uint8_t decimals) {
+    static char buf[40];
+    formatFloat(buf, sizeof(buf), value, decimals);
+    return buf;
+}
+
+// ============================================================================
+// FLOAT TESTS
+// ============================================================================
+
+void test_float_basic_values(void) {
+    TEST_ASSERT_EQUAL_STRING("0.000", fmt(0.0f, 3));
+    TEST_ASSERT_EQUAL_STRING("1.500", fmt(1.5f, 3));
+    TEST_ASSERT_EQUAL_STRING("-12.25", fmt(-12.25f, 2));
+    TEST_ASSERT_EQUAL_STRING("3", fmt(3.4f, 0));
+    TEST_ASSERT_EQUAL_STRING("0.050", fmt(0.05f, 3));
+    TEST_ASSERT_EQUAL_STRING("1.650000", fmt(1.65f, 6));
+}
+
+void test_float_rounding_carries(void) {
+    TEST_ASSERT_EQUAL_STRING("1.000", fmt(0.9996f, 3));
+    TEST_ASSERT_EQUAL_STRING("10.0", fmt(9.96f, 1));
+    TEST_ASSERT_EQUAL_STRING("-1.00", fmt(-0.999f, 2));
+    TEST_ASSERT_EQUAL_STRING("0.000", fmt(-0.0001f, 3));     // no "-0.000"
+}
+
+void test_float_special_values(void) {
+    TEST_ASSERT_EQUAL_STRING("nan", fmt(NAN, 3));
+    TEST_ASSERT_EQUAL_STRING("inf", fmt(INFINITY, 3));
+    TEST_ASSERT_EQUAL_STRING("-inf", fmt(-INFINITY, 3));
+    TEST_ASSERT_EQUAL_STRING("10000000000.00", fmt(1.0e10f, 2));
+}
+
+void test_float_matches_printf(void) {
+    // Same digits as printf, or one unit off in the last place on exact-half ties
+    char ours[40], theirs[40];
+    uint32_t seed = 7;
+    int exact = 0;
+    const int count = 20000;
+    for (int i = 0; i < count; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        float value = ((int32_t)seed / 2147483648.0f) * ((i % 3 == 0) ? 40.0f : 4000.0f);
+        uint8_t decimals = (uint8_t)(i % 7);
+        formatFloat(ours, sizeof(ours), value, decimals);
+        snprintf(theirs, sizeof(theirs), "%.*f", decimals, value);
+        if (strcmp(ours, theirs) == 0) {
+            exact++;
+            continue;
+        }
+        double unit = 1.0;
+        for (uint8_t d = 0; d < decimals; d++) unit /= 10.0;
+        TEST_ASSERT_TRUE(fabs(strtod(ours, nullptr) - strtod(theirs, nullptr)) <= unit * 1.001);
+    }
+    TEST_ASSERT_TRUE(exact > count * 99 / 100);
+}
+
+// ============================================================================
+// INTEGER / BUFFER TESTS
+// ============================================================================
+
+void test_integers(void) {
+    char buf[24];
+    formatUnsigned(buf, sizeof(buf), 18446744073709551615ULL);
+    TEST_ASSERT_EQUAL_STRING("18446744073709551615", buf);
+    formatSigned(buf, sizeof(buf), -9223372036854775807LL - 1);
+    TEST_ASSERT_EQUAL_STRING("-9223372036854775808", buf);
+    formatUnsigned(buf, sizeof(buf), 42, 5);
+    TEST_ASSERT_EQUAL_STRING("00042", buf);
+}
+
+void test_small_buffers_truncate_safely(void) {
+    char buf[4] = {'x', 'x', 'x', 'x'};
+    TEST_ASSERT_EQUAL(3, formatFloat(buf, sizeof(buf), 123.456f, 3));
+    TEST_ASSERT_EQUAL_STRING("123", buf);
+    TEST_ASSERT_EQUAL(0, formatFloat(buf, 0, 1.0f, 3));
+    TEST_ASSERT_EQUAL(0, formatFloat(buf, 1, -1.0f, 3));
+    TEST_ASSERT_EQUAL_STRING("", buf);
+}
+
+void test_line_buffer_keeps_numbers_whole(void) {
+    SmallLine line;
+    line.append("I=").appendFloat(1.25f, 2).append(" A");
+    TEST_ASSERT_EQUAL_STRING("I=1.25 A", line.c_str());
+    TEST_ASSERT_FALSE(line.isTruncated());
+
+    line.append(' ').appendFloat(12345.678f, 3);          // would need 9 more, 7 left
+    TEST_ASSERT_EQUAL_STRING("I=1.25 A ", line.c_str());
+    TEST_ASSERT_TRUE(line.isTruncated());
+
+    line.clear();
+    line.append("n=").appendUnsigned(1234567890123ULL);
+    TEST_ASSERT_EQUAL_STRING("n=1234567890123", line.c_str());
+    TEST_ASSERT_EQUAL(0, line.remaining());
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+#ifndef ARDUINO
+void test_format_benchmark(void) {
+    const int iterations = 1000000;
+    char buf[32];
+    volatile size_t sink = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        sink += snprintf(buf, sizeof(buf), "%.3f", (i - 500000) * 0.00137f);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        sink += formatFloat(buf, sizeof(buf), (i - 500000) * 0.00137f, 3);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double printf_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+    double fast_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / iterations;
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%%.3f: snprintf %.1f ns, formatFloat %.1f ns (%.1fx)", printf_ns, fast_ns, printf_ns / fast_ns);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(fast_ns < printf_ns);
+    (void)sink;
+}
+#endif
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void runAllTests(void) {
+    UNITY_BEGIN();
+
+    // Float tests
+    RUN_TEST(test_float_basic_values);
+    RUN_TEST(test_float_rounding_carries);
+    RUN_TEST(test_float_special_values);
+    RUN_TEST(test_float_matches_printf);
+
+    // Integer / buffer tests
+    RUN_TEST(test_integers);
+    RUN_TEST(test_small_buffers_truncate_safely);
+    RUN_TEST(test_line_buffer_keeps_numbers_whole);
+
+    // Performance tests
+#ifndef ARDUINO
+    RUN_TEST(test_format_benchmark);
+#endif
+
+    UNITY_END();
+}
+
+#ifndef ARDUINO
+int main() {
+    runAllTests();
+    return 0;
+}
+#endif
@@ -0,0 +1,265 @@
+// test/test_I2CBus.cpp
+#include <unity.h>
+#include "arduino_compat.h"
+#include "device/bus/I2CBus.h"
+
+#include <string.h>
+
+using namespace overseer::device::bus;
+
+// Register file per address; counts physical transfers
+class FakeTransport : public I2CTransport {
+    public:
+        uint8_t regs[2][256];
+        uint8_t addresses[2] = {0x68, 0x48};
+        int reads = 0;
+        int writes = 0;
+        size_t last_length = 0;
+        bool fail = false;
+
+        FakeTransport() {
+            for (int d = 0; d < 2; d++) {
+                for (int r = 0; r < 256; r++) regs[d][r] = (uint8_t)(r + d * 100);
+            }
+        }
+
+        bool begin(const I2CBusConfig&) override { return true; }
+
+        bool readRegisters(uint8_t address, uint8_t reg, uint8_t* buffer, size_t length) override {
+            reads++;
+            last_length = length;
+            if (fail) return false;
+            memcpy(buffer, &regs[index(address)][reg], length);
+            return true;
+        }
+
+        bool writeRegisters(uint8_t address, uint8_t reg, const uint8_t* data, size_t length) override {
+            writes++;
+            if (fail) return false;
+            memcpy(&regs[index(address)][reg], data, length);
+            return true;
+        }
+
+    private:
+        int index(uint8_t address) const { return address == addresses[0] ? 0 : 1; }
+};
+
+// Global test objects
+FakeTransport* transport = nullptr;
+I2CBus* bus = nullptr;
+uint8_t imu = 0;
+uint8_t adc = 0;
+
+void setUp(void) {
+    transport = new FakeTransport();
+    bus = new I2CBus(*transport);
+    bus->begin();
+    imu = bus->addClient("mpu6000", 0x68);
+    adc = bus->addClient("ads1115", 0x48);
+}
+
+void tearDown(void) {
+    delete bus;
+    delete transport;
+    bus = nullptr;
+    transport = nullptr;
+}
+
+static void prepare(I2CRequest& request, uint8_t client, uint8_t reg, uint8_t* buffer, uint8_t length, bool write = false) {
+    request.client = client;
+    request.reg = reg;
+    request.length = length;
+    request.data = buffer;
+    request.write = write;
+}
+
+// ============================================================================
+// MERGING TESTS
+// ============================================================================
+
+void test_contiguous_reads_merge_into_one_transfer(void) {
+    uint8_t accel[6], temp[2], gyro[6];
+    I2CRequest a, t, g;
+    prepare(a, imu, 0x3B, accel, 6);
+    prepare(g, imu, 0x43, gyro, 6);
+    prepare(t, imu, 0x41, temp, 2);      // bridges the other two, queued last
+    TEST_ASSERT_TRUE(bus->submit(a));
+    TEST_ASSERT_TRUE(bus->submit(g));
+    TEST_ASSERT_TRUE(bus->submit(t));
+
+    TEST_ASSERT_EQUAL(1, bus->process());
+    TEST_ASSERT_EQUAL(1, transport->reads);
+    TEST_ASSERT_EQUAL(14, transport->last_length);
+    TEST_ASSERT_TRUE(a.status == I2CStatus::OK && t.status == I2CStatus::OK && g.status == I2CStatus::OK);
+    TEST_ASSERT_EQUAL(0x3B, accel[0]);
+    TEST_ASSERT_EQUAL(0x41, temp[0]);
+    TEST_ASSERT_EQUAL(0x48, gyro[5]);
+
+    const I2CClientStats& stats = bus->getClientStats(imu);
+    TEST_ASSERT_EQUAL(3, stats.requests);
+    TEST_ASSERT_EQUAL(1, stats.transfers);
+    TEST_ASSERT_EQUAL(14, stats.bytes);
+}
+
+void test_gap_and_other_client_are_not_merged(void) {
+    uint8_t b1[2], b2[2], b3[2];
+    I2CRequest r1, r2, r3;
+    prepare(r1, imu, 0x10, b1, 2);
+    prepare(r2, imu, 0x20, b2, 2);      // gap
+    prepare(r3, adc, 0x12, b3, 2);      // adjacent register, other device
+    bus->submit(r1);
+    bus->submit(r2);
+    bus->submit(r3);
+
+    TEST_ASSERT_EQUAL(3, bus->process());
+    TEST_ASSERT_EQUAL(3, transport->reads);
+    TEST_ASSERT_EQUAL(0x12 + 100, b3[0]);
+}
+
+void test_write_is_a_barrier(void) {
+    uint8_t before[2], after[2];
+    uint8_t value = 0xAA;
+    I2CRequest r1, w, r2;
+    prepare(r1, imu, 0x40, before, 2);
+    prepare(w, imu, 0x41, &value, 1, true);
+    prepare(r2, imu, 0x42, after, 2);
+    bus->submit(r1);
+    bus->submit(w);
+    bus->submit(r2);
+
+    TEST_ASSERT_EQUAL(3, bus->process());
+    TEST_ASSERT_EQUAL(2, transport->reads);
+    TEST_ASSERT_EQUAL(1, transport->writes);
+    TEST_ASSERT_EQUAL(0x41, before[1]);        // read before the write saw the old value
+    TEST_ASSERT_EQUAL(0x42, after[0]);
+}
+
+void test_bursts_respect_max_burst(void) {
+    I2CBusConfig config;
+    config.max_burst = 8;
+    bus->begin(config);
+
+    uint8_t b[3][6];
+    I2CRequest r[3];
+    for (int i = 0; i < 3; i++) {
+        prepare(r[i], imu, (uint8_t)(0x3B + i * 6), b[i], 6);
+        bus->submit(r[i]);
+    }
+    TEST_ASSERT_EQUAL(3, bus->process());
+    TEST_ASSERT_EQUAL(6, transport->last_length);
+}
+
+// ============================================================================
+// QUEUE / ERROR TESTS
+// ============================================================================
+
+void test_full_queue_drops(void) {
+    uint8_t buffer[I2CBus::QUEUE_SIZE + 1];
+    I2CRequest r[I2CBus::QUEUE_SIZE + 1];
+    for (size_t i = 0; i < I2CBus::QUEUE_SIZE; i++) {
+        prepare(r[i], imu, (uint8_t)(i * 4), &buffer[i], 1);
+        TEST_ASSERT_TRUE(bus->submit(r[i]));
+    }
+    prepare(r[I2CBus::QUEUE_SIZE], imu, 0, &buffer[I2CBus::QUEUE_SIZE], 1);
+    TEST_ASSERT_FALSE(bus->submit(r[I2CBus::QUEUE_SIZE]));
+    TEST_ASSERT_TRUE(r[I2CBus::QUEUE_SIZE].status == I2CStatus::DROPPED);
+    TEST_ASSERT_EQUAL(1, bus->getDroppedCount());
+    TEST_ASSERT_EQUAL(I2CBus::QUEUE_SIZE, bus->pending());
+
+    bus->process();
+    TEST_ASSERT_EQUAL(0, bus->pending());
+}
+
+void test_failure_marks_every_merged_request(void) {
+    transport->fail = true;
+    uint8_t b1[2], b2[2];
+    I2CRequest r1, r2;
+    prepare(r1, imu, 0x3B, b1, 2);
+    prepare(r2, imu, 0x3D, b2, 2);
+    bus->submit(r1);
+    bus->submit(r2);
+    bus->process();
+
+    TEST_ASSERT_TRUE(r1.status == I2CStatus::FAILED);
+    TEST_ASSERT_TRUE(r2.status == I2CStatus::FAILED);
+    TEST_ASSERT_EQUAL(1, bus->getClientStats(imu).errors);
+    TEST_ASSERT_FALSE(bus->read(imu, 0x00, b1, 2));
+}
+
+void test_completion_callback(void) {
+    static int calls = 0;
+    calls = 0;
+    uint8_t buffer[2];
+    I2CRequest request;
+    prepare(request, adc, 0x00, buffer, 2);
+    request.on_complete = [](I2CRequest& r, void* context) {
+        calls++;
+        TEST_ASSERT_EQUAL_PTR(&calls, context);
+        TEST_ASSERT_EQUAL(101, r.data[1]);
+    };
+    request.context = &calls;
+    bus->submit(request);
+    bus->process();
+    TEST_ASSERT_EQUAL(1, calls);
+}
+
+// ============================================================================
+// SYNCHRONOUS / ACCOUNTING TESTS
+// ============================================================================
+
+void test_sync_read_and_write_run_inline(void) {
+    uint8_t value[2] = {0x12, 0x34};
+    TEST_ASSERT_TRUE(bus->write(adc, 0x01, value, 2));
+    uint8_t back[2] = {0, 0};
+    TEST_ASSERT_TRUE(bus->read(adc, 0x01, back, 2));
+    TEST_ASSERT_EQUAL(0x12, back[0]);
+    TEST_ASSERT_EQUAL(0x34, back[1]);
+    TEST_ASSERT_EQUAL(0, bus->pending());
+}
+
+void test_lock_accounts_direct_wire_users(void) {
+    {
+        I2CBus::Lock lock(bus, adc);
+    }
+    {
+        I2CBus::Lock lock(nullptr, adc);     // no bus attached: no-op
+    }
+    TEST_ASSERT_EQUAL(1, bus->getClientStats(adc).requests);
+    TEST_ASSERT_EQUAL(1, bus->getClientStats(adc).transfers);
+
+    bus->resetStats();
+    TEST_ASSERT_EQUAL(0, bus->getClientStats(adc).requests);
+    TEST_ASSERT_EQUAL_STRING("ads1115", bus->getClientStats(adc).name);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void runAllTests(void) {
+    UNITY_BEGIN();
+
+    // Merging tests
+    RUN_TEST(test_contiguous_reads_merge_into_one_transfer);
+    RUN_TEST(test_gap_and_other_client_are_not_merged);
+    RUN_TEST(test_write_is_a_barrier);
+    RUN_TEST(test_bursts_respect_max_burst);
+
+    // Queue / error tests
+    RUN_TEST(test_full_queue_drops);
+    RUN_TEST(test_failure_marks_every_merged_request);
+    RUN_TEST(test_completion_callback);
+
+    // Synchronous / accounting tests
+    RUN_TEST(test_sync_read_and_write_run_inline);
+    RUN_TEST(test_lock_accounts_direct_wire_users);
+
+    UNITY_END();
+}
+
+#ifndef ARDUINO
+int main() {
+    runAllTests();
+    return 0;
+}
+#endif
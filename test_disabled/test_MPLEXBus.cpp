@@ -0,0 +1,536 @@
+// test/test_MPLEXBus.cpp
+#include <unity.h>
+#include <vector>
+#include "arduino_compat.h"
+#include "mocks/MockADS1115.h"
+#include "device/ads/MPLEXBus.h"
+
+using namespace overseer::device::ads;
+
+typedef MPLEXBusT<MockADS1115, MockI2CBus*> MockMPLEXBus;
+
+// Global test objects
+MockI2CBus* mockBus = nullptr;
+MockMPLEXBus* testBus = nullptr;
+
+static void fitDevices(MockI2CBus& bus, uint8_t count) {
+    for (uint8_t d = 0; d < 4; d++) {
+        bus.devices[d].present = d < count;
+        for (uint8_t ch = 0; ch < 4; ch++) {
+            bus.devices[d].volts[ch] = 0.1f * (d + 1) + 0.01f * ch;
+        }
+    }
+}
+
+// Runs the interleaved scan for `duration_us` of virtual bus time
+static uint32_t runFor(MockMPLEXBus& adcBus, MockI2CBus& bus, uint32_t duration_us) {
+    uint32_t end = bus.now_us + duration_us;
+    while (bus.now_us < end) {
+        uint32_t before = bus.now_us;
+        adcBus.update();
+        if (bus.now_us == before) bus.now_us += 10;   // nothing to talk to, let time pass
+    }
+    return adcBus.getTotalConversions();
+}
+
+void setUp(void) {
+    mockBus = new MockI2CBus();
+    testBus = new MockMPLEXBus(mockBus);
+}
+
+void tearDown(void) {
+    delete testBus;
+    delete mockBus;
+    testBus = nullptr;
+    mockBus = nullptr;
+}
+
+// ============================================================================
+// DISCOVERY TESTS
+// ============================================================================
+
+void test_discover_finds_fitted_devices(void) {
+    mockBus->devices[0].present = true;
+    mockBus->devices[2].present = true;
+
+    TEST_ASSERT_EQUAL(2, testBus->discover());
+    TEST_ASSERT_TRUE(testBus->isDevicePresent(0));
+    TEST_ASSERT_FALSE(testBus->isDevicePresent(1));
+    TEST_ASSERT_TRUE(testBus->isDevicePresent(2));
+    TEST_ASSERT_FALSE(testBus->isDevicePresent(3));
+}
+
+void test_discover_probes_only_ads_addresses(void) {
+    fitDevices(*mockBus, 4);
+    uint32_t before = mockBus->now_us;
+    testBus->discover();
+
+    // One probe per ADS1115 address, nothing else
+    TEST_ASSERT_EQUAL_UINT32(4 * mockBus->transaction_us, mockBus->now_us - before);
+}
+
+void test_channel_count_is_sixteen(void) {
+    TEST_ASSERT_EQUAL(16, testBus->getChannelCount());
+}
+
+// ============================================================================
+// SCAN TESTS
+// ============================================================================
+
+void test_logical_channels_map_to_device_inputs(void) {
+    fitDevices(*mockBus, 4);
+    testBus->discover();
+    runFor(*testBus, *mockBus, 20000);
+
+    for (int channel = 0; channel < 16; channel++) {
+        const ChannelData& data = testBus->getChannelData(channel);
+        TEST_ASSERT_TRUE(data.valid);
+        TEST_ASSERT_FLOAT_WITHIN(0.0002f, 0.1f * (channel / 4 + 1) + 0.01f * (channel % 4), data.voltage);
+    }
+}
+
+void test_missing_device_channels_are_invalid(void) {
+    fitDevices(*mockBus, 1);
+    testBus->discover();
+    runFor(*testBus, *mockBus, 20000);
+
+    TEST_ASSERT_TRUE(testBus->isValidChannel(3));
+    TEST_ASSERT_FALSE(testBus->isValidChannel(4));
+    TEST_ASSERT_FALSE(testBus->isValidChannel(15));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, testBus->getChannelVoltage(8));
+}
+
+void test_disabled_channels_are_skipped(void) {
+    fitDevices(*mockBus, 1);
+    testBus->enableChannel(1, false);
+    testBus->enableChannel(2, false);
+    testBus->discover();
+    runFor(*testBus, *mockBus, 20000);
+
+    TEST_ASSERT_TRUE(testBus->getChannelData(0).valid);
+    TEST_ASSERT_FALSE(testBus->getChannelData(1).valid);
+    TEST_ASSERT_FALSE(testBus->getChannelData(2).valid);
+    TEST_ASSERT_TRUE(testBus->getChannelData(3).valid);
+}
+
+void test_update_never_blocks_on_conversion(void) {
+    fitDevices(*mockBus, 1);
+    testBus->discover();
+    testBus->update();                      // request only
+
+    uint32_t before = mockBus->now_us;
+    TEST_ASSERT_EQUAL(0, testBus->update()); // conversion still running
+    TEST_ASSERT_LESS_THAN_UINT32(mockBus->conversion_us, mockBus->now_us - before);
+}
+
+void test_throughput_scales_with_device_count(void) {
+    const uint32_t window_us = 1000000;
+
+    MockI2CBus singleBus;
+    fitDevices(singleBus, 1);
+    MockMPLEXBus single(&singleBus);
+    single.discover();
+    uint32_t singleRate = runFor(single, singleBus, window_us);
+
+    MockI2CBus quadBus;
+    fitDevices(quadBus, 4);
+    MockMPLEXBus quad(&quadBus);
+    quad.discover();
+    uint32_t quadRate = runFor(quad, quadBus, window_us);
+
+    char msg[80];
+    snprintf(msg, sizeof(msg), "1 chip: %u conv/s, 4 chips: %u conv/s", (unsigned)singleRate, (unsigned)quadRate);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_GREATER_THAN_UINT32(3 * singleRate, quadRate);
+}
+
+void test_snapshot_matches_channel_getters(void) {
+    fitDevices(*mockBus, 2);
+    testBus->discover();
+    runFor(*testBus, *mockBus, 20000);
+
+    const auto& snap = testBus->snapshot();
+    for (int channel = 0; channel < 8; channel++) {
+        TEST_ASSERT_TRUE(snap[channel].valid);
+        TEST_ASSERT_EQUAL_INT16(testBus->getChannelData(channel).raw_value, snap[channel].raw_value);
+    }
+    TEST_ASSERT_FALSE(snap[8].valid);
+}
+
+// ADS1X15 drives Wire itself; the shared bus only has to hand out its Lock
+class NullTransport : public overseer::device::bus::I2CTransport {
+    public:
+        bool begin(const overseer::device::bus::I2CBusConfig&) override { return true; }
+        bool readRegisters(uint8_t, uint8_t, uint8_t*, size_t) override { return true; }
+        bool writeRegisters(uint8_t, uint8_t, const uint8_t*, size_t) override { return true; }
+};
+
+void test_shared_bus_lock_taken_per_chip(void) {
+    NullTransport transport;
+    overseer::device::bus::I2CBus i2c(transport);
+    TEST_ASSERT_TRUE(testBus->attachBus(i2c));
+    uint8_t client = i2c.getClientCount() - 1;
+
+    fitDevices(*mockBus, 2);
+    testBus->discover();
+    TEST_ASSERT_EQUAL_UINT32(4, i2c.getClientStats(client).requests);     // one section per probed address
+
+    testBus->update();
+    TEST_ASSERT_EQUAL_UINT32(6, i2c.getClientStats(client).requests);     // one per fitted chip serviced
+    TEST_ASSERT_EQUAL_STRING("ads1115_bus", i2c.getClientStats(client).name);
+}
+
+// ============================================================================
+// STALENESS TESTS
+// ============================================================================
+
+void test_stale_when_never_read(void) {
+    ChannelData data;
+    TEST_ASSERT_TRUE(isStale(data, 1000, 0));
+}
+
+void test_fresh_within_max_age(void) {
+    ChannelData data;
+    data.valid = true;
+    data.last_update = 1000;
+    TEST_ASSERT_FALSE(isStale(data, 50, 1049));
+    TEST_ASSERT_TRUE(isStale(data, 50, 1050));
+}
+
+void test_zero_max_age_always_stale(void) {
+    ChannelData data;
+    data.valid = true;
+    data.last_update = 1000;
+    TEST_ASSERT_TRUE(isStale(data, 0, 1000));
+}
+
+void test_staleness_survives_millis_wrap(void) {
+    ChannelData data;
+    data.valid = true;
+    data.last_update = (unsigned long)-16;     // 16 ms before millis() wraps
+    TEST_ASSERT_FALSE(isStale(data, 50, 0x10UL));
+    TEST_ASSERT_TRUE(isStale(data, 50, 0x30UL));
+}
+
+// ============================================================================
+// AUTO-RANGE TESTS
+// ============================================================================
+
+void test_level_for_range_picks_narrowest_cover(void) {
+    TEST_ASSERT_EQUAL(0, PgaAutoRange::gainCode(PgaAutoRange::levelForRange(5.0f)));
+    TEST_ASSERT_EQUAL(2, PgaAutoRange::gainCode(PgaAutoRange::levelForRange(2.0f)));
+    TEST_ASSERT_EQUAL(16, PgaAutoRange::gainCode(PgaAutoRange::levelForRange(0.1f)));
+}
+
+void test_auto_range_narrows_on_small_signal(void) {
+    fitDevices(*mockBus, 1);
+    mockBus->devices[0].volts[0] = 0.05f;
+    testBus->setChannelAutoRange(0);
+    testBus->discover();
+    runFor(*testBus, *mockBus, 500000);
+
+    const ChannelData& data = testBus->getChannelData(0);
+    TEST_ASSERT_EQUAL(16, data.pga_gain);          // +/-0.256 V
+    TEST_ASSERT_FLOAT_WITHIN(0.00005f, 0.05f, data.voltage);
+    TEST_ASSERT_GREATER_THAN_INT(1000, data.raw_value);   // vs ~266 counts at +/-6.144 V
+}
+
+void test_auto_range_widens_immediately_on_clipping(void) {
+    fitDevices(*mockBus, 1);
+    mockBus->devices[0].volts[0] = 0.05f;
+    testBus->setChannelAutoRange(0);
+    testBus->discover();
+    runFor(*testBus, *mockBus, 500000);
+
+    // One level per clipped conversion until 3 V fits: +/-4.096 V
+    mockBus->devices[0].volts[0] = 3.0f;
+    runFor(*testBus, *mockBus, 50000);
+
+    const ChannelData& data = testBus->getChannelData(0);
+    TEST_ASSERT_EQUAL(1, data.pga_gain);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 3.0f, data.voltage);
+}
+
+void test_auto_range_hysteresis_holds_gain(void) {
+    PgaAutoRange range;
+    range.begin(0.3f);   // +/-0.512 V
+    TEST_ASSERT_EQUAL(8, range.getGain());
+
+    // 0.09 V sits just under the 0.4 * 0.256 V downshift point but fluctuates above it
+    bool changed = false;
+    for (int i = 0; i < 100; i++) {
+        float volts = (i % 4 == 0) ? 0.11f : 0.09f;
+        changed |= range.update((int16_t)(volts / 0.512f * 32767.0f));
+    }
+    TEST_ASSERT_FALSE(changed);
+    TEST_ASSERT_EQUAL(8, range.getGain());
+}
+
+void test_fixed_gain_channels_ignore_auto_range(void) {
+    fitDevices(*mockBus, 1);
+    mockBus->devices[0].volts[1] = 0.05f;
+    testBus->discover();
+    runFor(*testBus, *mockBus, 200000);
+
+    TEST_ASSERT_EQUAL(0, testBus->getChannelData(1).pga_gain);
+}
+
+// ============================================================================
+// DIFFERENTIAL / DECIMATION TESTS
+// ============================================================================
+
+// Standard deviation of `count` published voltages on `channel` (the only enabled channel)
+static float publishedStdDev(MockMPLEXBus& adcBus, MockI2CBus& bus, int channel, int count, uint8_t factor) {
+    std::vector<float> samples;
+    for (int n = 0; n < count; n++) {
+        uint32_t target = adcBus.getTotalConversions() + factor;
+        while (adcBus.getTotalConversions() < target) {
+            adcBus.update();
+            bus.now_us += 10;
+        }
+        samples.push_back(adcBus.getChannelData(channel).voltage);
+    }
+    float mean = 0.0f;
+    for (float v : samples) mean += v / count;
+    float var = 0.0f;
+    for (float v : samples) var += (v - mean) * (v - mean) / count;
+    return sqrtf(var);
+}
+
+void test_differential_pair_reads_difference(void) {
+    fitDevices(*mockBus, 1);
+    mockBus->devices[0].volts[0] = 2.50f;
+    mockBus->devices[0].volts[1] = 2.38f;
+    testBus->setChannelInput(0, InputMode::DIFF_0_1);
+    testBus->enableChannel(1, false);
+    testBus->discover();
+    runFor(*testBus, *mockBus, 20000);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.0005f, 0.12f, testBus->getChannelVoltage(0));
+}
+
+void test_differential_pair_reads_negative(void) {
+    fitDevices(*mockBus, 1);
+    mockBus->devices[0].volts[2] = 1.00f;
+    mockBus->devices[0].volts[3] = 1.25f;
+    testBus->setChannelInput(2, InputMode::DIFF_2_3);
+    testBus->discover();
+    runFor(*testBus, *mockBus, 20000);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.0005f, -0.25f, testBus->getChannelVoltage(2));
+}
+
+void test_input_change_invalidates_cached_result(void) {
+    fitDevices(*mockBus, 1);
+    mockBus->devices[0].volts[0] = 2.50f;
+    mockBus->devices[0].volts[1] = 2.38f;
+    testBus->discover();
+    runFor(*testBus, *mockBus, 20000);
+    TEST_ASSERT_TRUE(testBus->getChannelData(0).valid);
+
+    // A single-ended result must never be served as the differential reading
+    testBus->setChannelInput(0, InputMode::DIFF_0_1);
+    TEST_ASSERT_FALSE(testBus->getChannelData(0).valid);
+    runFor(*testBus, *mockBus, 20000);
+    TEST_ASSERT_FLOAT_WITHIN(0.0005f, 0.12f, testBus->getChannelVoltage(0));
+
+    testBus->enableChannel(0, false);
+    TEST_ASSERT_FALSE(testBus->getChannelData(0).valid);
+    TEST_ASSERT_EQUAL(0, testBus->getChannelConfig(99).label.length());     // out of range: defaults, no overrun
+}
+
+void test_boxcar_decimator_averages_exactly(void) {
+    Decimator decimator;
+    decimator.begin(4);
+    TEST_ASSERT_FALSE(decimator.push(10));
+    TEST_ASSERT_FALSE(decimator.push(11));
+    TEST_ASSERT_FALSE(decimator.push(11));
+    TEST_ASSERT_TRUE(decimator.push(11));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 10.75f, decimator.getValue());
+}
+
+void test_cic_decimator_settles_to_dc(void) {
+    Decimator decimator;
+    decimator.begin(8, DecimationFilter::CIC2);
+    int outputs = 0;
+    for (int i = 0; i < 8 * 5; i++) {
+        if (decimator.push(-1234)) {
+            outputs++;
+            TEST_ASSERT_FLOAT_WITHIN(0.0001f, -1234.0f, decimator.getValue());
+        }
+    }
+    TEST_ASSERT_EQUAL(4, outputs);   // first period is discarded while the combs fill
+}
+
+void test_cic_decimator_handles_integrator_wrap(void) {
+    Decimator decimator;
+    decimator.begin(128, DecimationFilter::CIC2);
+    float last = 0.0f;
+    for (int i = 0; i < 128 * 300; i++) {
+        if (decimator.push(32767)) last = decimator.getValue();
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 32767.0f, last);
+}
+
+void test_decimation_reduces_noise(void) {
+    srand(1);
+    fitDevices(*mockBus, 1);
+    mockBus->devices[0].noise_lsb = 8;
+    mockBus->devices[0].volts[0] = 1.0f;
+    for (int ch = 1; ch < 4; ch++) testBus->enableChannel(ch, false);
+    testBus->discover();
+    float single = publishedStdDev(*testBus, *mockBus, 0, 64, 1);
+
+    testBus->setChannelDecimation(0, 16);
+    float decimated = publishedStdDev(*testBus, *mockBus, 0, 64, 16);
+
+    // sqrt(16) = 4x less noise in theory, allow some slack for 64 samples
+    TEST_ASSERT_TRUE(decimated < single / 2.5f);
+    TEST_ASSERT_FLOAT_WITHIN(0.0005f, 1.0f, testBus->getChannelVoltage(0));
+}
+
+void test_decimation_keeps_i2c_cost_per_conversion(void) {
+    fitDevices(*mockBus, 1);
+    testBus->discover();
+    uint32_t plain = runFor(*testBus, *mockBus, 100000);
+
+    testBus->setChannelDecimation(0, 16);
+    uint32_t decimated = runFor(*testBus, *mockBus, 100000) - plain;
+    TEST_ASSERT_UINT32_WITHIN(2, plain, decimated);
+}
+
+void test_blocking_conversion_settles_within_budget(void) {
+    fitDevices(*mockBus, 1);
+    MockADS1115 adc(0x48, mockBus);
+    ChannelConfig cfg;
+    Decimator decimator;
+    decimator.begin(8, DecimationFilter::CIC2);
+    PgaAutoRange range;
+    range.begin(expectedRange(cfg));
+
+    // A cold CIC2 needs two full periods for its first result
+    int16_t raw;
+    bool changed;
+    uint32_t conversions = 0;
+    TEST_ASSERT_TRUE(convertBounded(decimator, [&] {
+        conversions++;
+        return convertDecimated(adc, cfg, 0, range.getGain(), decimator, range, raw, changed);
+    }));
+    TEST_ASSERT_EQUAL_UINT32(decimator.settleConversions(), conversions);
+    TEST_ASSERT_EQUAL_UINT32(16, conversions);
+}
+
+void test_blocking_conversion_bounded_when_auto_range_keeps_switching(void) {
+    fitDevices(*mockBus, 1);
+    MockADS1115 adc(0x48, mockBus);
+    ChannelConfig cfg;
+    cfg.auto_range = true;
+    Decimator decimator;
+    decimator.begin(8, DecimationFilter::CIC2);
+    AutoRangeConfig fast;
+    fast.downshift_scans = 1;
+    fast.envelope_decay = 0.0f;
+    PgaAutoRange range;
+    range.begin(expectedRange(cfg), fast);
+
+    // Signal alternating around a PGA threshold: every conversion switches the
+    // range in the middle of the decimation period and restarts the decimator
+    uint32_t conversions = 0, switches = 0;
+    int16_t raw;
+    bool changed;
+    bool ready = convertBounded(decimator, [&] {
+        mockBus->devices[0].volts[0] = (conversions++ % 2) ? 3.0f : 0.1f;
+        bool result = convertDecimated(adc, cfg, 0, range.getGain(), decimator, range, raw, changed);
+        if (changed) switches++;
+        return result;
+    });
+    TEST_ASSERT_FALSE(ready);
+    TEST_ASSERT_EQUAL_UINT32(2 * 8 + 1, conversions);      // gives up instead of spinning forever
+    TEST_ASSERT_EQUAL_UINT32(2 * 8 + 1, mockBus->devices[0].conversions);
+    TEST_ASSERT_TRUE(switches > 8);
+}
+
+// ============================================================================
+// ALARM TESTS
+// ============================================================================
+
+void test_alarm_raised_from_scan(void) {
+    overseer::device::alarm::AlarmEngine alarms;
+    overseer::device::alarm::AlarmRule rule;
+    rule.signal = 100 + 5;      // chip 1, input 1
+    rule.high = 1.0f;
+    alarms.addRule(rule);
+
+    fitDevices(*mockBus, 2);
+    testBus->attachAlarms(alarms, 100);
+    testBus->discover();
+    runFor(*testBus, *mockBus, 20000);
+    TEST_ASSERT_EQUAL(0, alarms.getActiveCount());
+
+    mockBus->devices[1].volts[1] = 1.5f;
+    runFor(*testBus, *mockBus, 20000);
+
+    overseer::device::alarm::AlarmEvent event;
+    TEST_ASSERT_TRUE(alarms.poll(event));
+    TEST_ASSERT_EQUAL(105, event.signal);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.5f, event.value);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void runAllTests(void) {
+    UNITY_BEGIN();
+
+    // Discovery tests
+    RUN_TEST(test_discover_finds_fitted_devices);
+    RUN_TEST(test_discover_probes_only_ads_addresses);
+    RUN_TEST(test_channel_count_is_sixteen);
+
+    // Scan tests
+    RUN_TEST(test_logical_channels_map_to_device_inputs);
+    RUN_TEST(test_missing_device_channels_are_invalid);
+    RUN_TEST(test_disabled_channels_are_skipped);
+    RUN_TEST(test_update_never_blocks_on_conversion);
+    RUN_TEST(test_throughput_scales_with_device_count);
+    RUN_TEST(test_snapshot_matches_channel_getters);
+    RUN_TEST(test_shared_bus_lock_taken_per_chip);
+
+    // Staleness tests
+    RUN_TEST(test_stale_when_never_read);
+    RUN_TEST(test_fresh_within_max_age);
+    RUN_TEST(test_zero_max_age_always_stale);
+    RUN_TEST(test_staleness_survives_millis_wrap);
+
+    // Auto-range tests
+    RUN_TEST(test_level_for_range_picks_narrowest_cover);
+    RUN_TEST(test_auto_range_narrows_on_small_signal);
+    RUN_TEST(test_auto_range_widens_immediately_on_clipping);
+    RUN_TEST(test_auto_range_hysteresis_holds_gain);
+    RUN_TEST(test_fixed_gain_channels_ignore_auto_range);
+
+    // Differential / decimation tests
+    RUN_TEST(test_differential_pair_reads_difference);
+    RUN_TEST(test_differential_pair_reads_negative);
+    RUN_TEST(test_input_change_invalidates_cached_result);
+    RUN_TEST(test_boxcar_decimator_averages_exactly);
+    RUN_TEST(test_cic_decimator_settles_to_dc);
+    RUN_TEST(test_cic_decimator_handles_integrator_wrap);
+    RUN_TEST(test_decimation_reduces_noise);
+    RUN_TEST(test_decimation_keeps_i2c_cost_per_conversion);
+    RUN_TEST(test_blocking_conversion_settles_within_budget);
+    RUN_TEST(test_blocking_conversion_bounded_when_auto_range_keeps_switching);
+
+    // Alarm tests
+    RUN_TEST(test_alarm_raised_from_scan);
+
+    UNITY_END();
+}
+
+#ifndef ARDUINO
+int main() {
+    runAllTests();
+    return 0;
+}
+#endif
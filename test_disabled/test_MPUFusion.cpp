@@ -0,0 +1,189 @@
+// test/test_MPUFusion.cpp
+#include <unity.h>
+#include "arduino_compat.h"
+#include "device/IMU/MPU6000/MPUFusion.h"
+
+using namespace overseer::device::imu::fusion;
+
+static const float DT = 0.01f;           // 100 Hz
+static const float TOLERANCE_DEG = 0.5f;
+
+static ComplementaryFilter* complementary = nullptr;
+static MadgwickFilter* madgwick = nullptr;
+
+void setUp(void) {
+    complementary = new ComplementaryFilter();
+    madgwick = new MadgwickFilter();
+}
+
+void tearDown(void) {
+    delete complementary;
+    delete madgwick;
+    complementary = nullptr;
+    madgwick = nullptr;
+}
+
+// Gravity vector (in g) seen by a sensor pitched then rolled by the given angles,
+// with pitch positive when +X points up
+static void gravity(float pitch_deg, float roll_deg, float& ax, float& ay, float& az) {
+    float p = pitch_deg * DEG_TO_RAD_F;
+    float r = roll_deg * DEG_TO_RAD_F;
+    ax = sinf(p);
+    ay = cosf(p) * sinf(r);
+    az = cosf(p) * cosf(r);
+}
+
+// Feeds a static attitude with the given gyro rates for n samples
+template <typename Filter>
+static void feed(Filter& f, float pitch_deg, float roll_deg, float gx, float gy, float gz, int n) {
+    float ax, ay, az;
+    gravity(pitch_deg, roll_deg, ax, ay, az);
+    for (int i = 0; i < n; i++) {
+        f.update(ax, ay, az, gx, gy, gz, DT);
+    }
+}
+
+// ============================================================================
+// STATIC TILT TESTS
+// ============================================================================
+
+void test_complementary_static_tilt_from_accel(void) {
+    const float angles[] = { 30.0f, -30.0f };
+    for (float a : angles) {
+        complementary->reset();
+        feed(*complementary, a, 0.0f, 0, 0, 0, 1);
+        TEST_ASSERT_FLOAT_WITHIN(TOLERANCE_DEG, a, complementary->getPitch());
+        TEST_ASSERT_FLOAT_WITHIN(TOLERANCE_DEG, 0.0f, complementary->getRoll());
+
+        complementary->reset();
+        feed(*complementary, 0.0f, a, 0, 0, 0, 1);
+        TEST_ASSERT_FLOAT_WITHIN(TOLERANCE_DEG, 0.0f, complementary->getPitch());
+        TEST_ASSERT_FLOAT_WITHIN(TOLERANCE_DEG, a, complementary->getRoll());
+    }
+}
+
+void test_madgwick_static_tilt_matches_accel_pitch(void) {
+    // asin(2(q1q3 - q0q2)) must land on the same sign and value as the accel-only pitch
+    const float angles[] = { 30.0f, -30.0f };
+    for (float a : angles) {
+        complementary->reset();
+        feed(*complementary, a, 0.0f, 0, 0, 0, 1);
+
+        madgwick->reset();
+        feed(*madgwick, a, 0.0f, 0, 0, 0, 2000);
+        TEST_ASSERT_FLOAT_WITHIN(TOLERANCE_DEG, complementary->getPitch(), madgwick->getPitch());
+        TEST_ASSERT_FLOAT_WITHIN(TOLERANCE_DEG, a, madgwick->getPitch());
+        TEST_ASSERT_FLOAT_WITHIN(TOLERANCE_DEG, 0.0f, madgwick->getRoll());
+
+        madgwick->reset();
+        feed(*madgwick, 0.0f, a, 0, 0, 0, 2000);
+        TEST_ASSERT_FLOAT_WITHIN(TOLERANCE_DEG, 0.0f, madgwick->getPitch());
+        TEST_ASSERT_FLOAT_WITHIN(TOLERANCE_DEG, a, madgwick->getRoll());
+    }
+}
+
+// ============================================================================
+// GYRO INTEGRATION TESTS
+// ============================================================================
+
+void test_complementary_gyro_integration_sign(void) {
+    // Gyro only: pitch integrates -gy, roll integrates +gx
+    complementary->setGain(1.0f);
+    feed(*complementary, 0.0f, 0.0f, 0, 0, 0, 1);  // seed level
+    feed(*complementary, 0.0f, 0.0f, 0.0f, 10.0f, 0.0f, 100);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, -10.0f, complementary->getPitch());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, complementary->getRoll());
+
+    complementary->reset();
+    feed(*complementary, 0.0f, 0.0f, 0, 0, 0, 1);
+    feed(*complementary, 0.0f, 0.0f, 10.0f, 0.0f, 0.0f, 100);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, complementary->getPitch());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 10.0f, complementary->getRoll());
+}
+
+void test_madgwick_gyro_integration_sign(void) {
+    // Zero gain disables the accel correction, leaving pure quaternion integration
+    madgwick->setGain(0.0f);
+    feed(*madgwick, 0.0f, 0.0f, 0.0f, 10.0f, 0.0f, 100);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, -10.0f, madgwick->getPitch());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, madgwick->getRoll());
+
+    madgwick->reset();
+    feed(*madgwick, 0.0f, 0.0f, 10.0f, 0.0f, 0.0f, 100);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, madgwick->getPitch());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 10.0f, madgwick->getRoll());
+}
+
+// ============================================================================
+// CONVERGENCE TESTS
+// ============================================================================
+
+void test_complementary_converges_from_wrong_state(void) {
+    // Seeded level, then held at 30 deg: error decays by alpha per sample,
+    // 0.98^n * 30 < 0.5 after ~203 samples
+    feed(*complementary, 0.0f, 0.0f, 0, 0, 0, 1);
+    feed(*complementary, 30.0f, -30.0f, 0, 0, 0, 100);
+    TEST_ASSERT_TRUE(complementary->getPitch() < 30.0f - TOLERANCE_DEG);
+
+    feed(*complementary, 30.0f, -30.0f, 0, 0, 0, 150);
+    TEST_ASSERT_FLOAT_WITHIN(TOLERANCE_DEG, 30.0f, complementary->getPitch());
+    TEST_ASSERT_FLOAT_WITHIN(TOLERANCE_DEG, -30.0f, complementary->getRoll());
+}
+
+void test_madgwick_converges_from_wrong_state(void) {
+    // Starts at identity (level); the default gain settles in ~380 samples at 100 Hz
+    feed(*madgwick, 30.0f, -30.0f, 0, 0, 0, 100);
+    TEST_ASSERT_TRUE(madgwick->getPitch() < 30.0f - TOLERANCE_DEG);
+
+    feed(*madgwick, 30.0f, -30.0f, 0, 0, 0, 400);
+    TEST_ASSERT_FLOAT_WITHIN(TOLERANCE_DEG, 30.0f, madgwick->getPitch());
+    TEST_ASSERT_FLOAT_WITHIN(TOLERANCE_DEG, -30.0f, madgwick->getRoll());
+}
+
+// ============================================================================
+// INVSQRT TESTS
+// ============================================================================
+
+void test_inv_sqrt_error_bound(void) {
+    // One Newton step after the magic-constant guess: relative error stays under 0.2%
+    float worst = 0.0f;
+    for (float x = 1e-4f; x < 1e4f; x *= 1.01f) {
+        float exact = 1.0f / sqrtf(x);
+        float err = fabsf(invSqrt(x) - exact) / exact;
+        if (err > worst) worst = err;
+    }
+    TEST_ASSERT_TRUE(worst < 0.002f);
+    TEST_ASSERT_TRUE(worst > 0.0f);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void runAllTests(void) {
+    UNITY_BEGIN();
+
+    // Static tilt tests
+    RUN_TEST(test_complementary_static_tilt_from_accel);
+    RUN_TEST(test_madgwick_static_tilt_matches_accel_pitch);
+
+    // Gyro integration tests
+    RUN_TEST(test_complementary_gyro_integration_sign);
+    RUN_TEST(test_madgwick_gyro_integration_sign);
+
+    // Convergence tests
+    RUN_TEST(test_complementary_converges_from_wrong_state);
+    RUN_TEST(test_madgwick_converges_from_wrong_state);
+
+    // InvSqrt tests
+    RUN_TEST(test_inv_sqrt_error_bound);
+
+    UNITY_END();
+}
+
+#ifndef ARDUINO
+int main() {
+    runAllTests();
+    return 0;
+}
+#endif
@@ -0,0 +1,194 @@
+// test/test_MPUVibration.cpp
+#include <unity.h>
+#include "arduino_compat.h"
+#include "device/IMU/MPU6000/MPUVibration.h"
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+using namespace overseer::device::imu::vibration;
+
+typedef VibrationAnalyzer<256> Analyzer256;
+
+static const float FS = 1000.0f;
+
+static Analyzer256* analyzer = nullptr;
+
+void setUp(void) {
+    analyzer = new Analyzer256();
+    VibrationConfig cfg;
+    cfg.sample_rate_hz = FS;
+    analyzer->configure(cfg);
+}
+
+void tearDown(void) {
+    delete analyzer;
+    analyzer = nullptr;
+}
+
+// Pushes one block of gravity + tones sampled at FS
+static void pushBlock(Analyzer256& a, float dc, float f1, float a1, float f2 = 0.0f, float a2 = 0.0f, size_t offset = 0) {
+    for (size_t n = 0; n < 256; n++) {
+        float t = (n + offset) / FS;
+        a.push(dc + a1 * sinf(2.0f * (float)M_PI * f1 * t) + a2 * sinf(2.0f * (float)M_PI * f2 * t + 0.7f));
+    }
+}
+
+// ============================================================================
+// FFT TESTS
+// ============================================================================
+
+void test_real_fft_matches_naive_dft(void) {
+    const size_t N = 64;
+    RealFFT<N> fft;
+    float input[N], data[N];
+    uint32_t seed = 12345;
+    for (size_t n = 0; n < N; n++) {
+        seed = seed * 1103515245u + 12345u;
+        input[n] = ((seed >> 8) & 0xFFFF) / 32768.0f - 1.0f;
+        data[n] = input[n];
+    }
+    fft.transform(data);
+
+    float worst = 0.0f;
+    for (size_t k = 0; k <= N / 2; k++) {
+        double re = 0.0, im = 0.0;
+        for (size_t n = 0; n < N; n++) {
+            re += input[n] * cos(2.0 * M_PI * k * n / N);
+            im -= input[n] * sin(2.0 * M_PI * k * n / N);
+        }
+        float got_re, got_im;
+        if (k == 0) { got_re = data[0]; got_im = 0.0f; }
+        else if (k == N / 2) { got_re = data[1]; got_im = 0.0f; }
+        else { got_re = data[2 * k]; got_im = data[2 * k + 1]; }
+        worst = fmaxf(worst, fabsf(got_re - (float)re));
+        worst = fmaxf(worst, fabsf(got_im - (float)im));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, worst);
+}
+
+// ============================================================================
+// SPECTRUM TESTS
+// ============================================================================
+
+void test_single_tone_peak_and_band(void) {
+    pushBlock(*analyzer, 1.0f, 120.0f, 0.5f);       // 1 g gravity, 0.5 g at 120 Hz
+    TEST_ASSERT_TRUE(analyzer->process());
+
+    const VibrationSpectrum& s = analyzer->getSpectrum();
+    TEST_ASSERT_GREATER_OR_EQUAL(1, s.peak_count);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 120.0f, s.peak_hz[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 0.5f, s.peak_g[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.3536f, s.rms);        // gravity removed
+
+    // 120 Hz lands in the 100-200 Hz band
+    TEST_ASSERT_EQUAL(5, s.band_count);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.3536f, s.band_rms[3]);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.0f, s.band_rms[1]);
+}
+
+void test_two_tones_sorted_by_amplitude(void) {
+    pushBlock(*analyzer, 0.0f, 40.0f, 0.2f, 310.0f, 0.8f);
+    TEST_ASSERT_TRUE(analyzer->process());
+
+    const VibrationSpectrum& s = analyzer->getSpectrum();
+    TEST_ASSERT_GREATER_OR_EQUAL(2, s.peak_count);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 310.0f, s.peak_hz[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 40.0f, s.peak_hz[1]);
+    TEST_ASSERT_TRUE(s.peak_g[0] > s.peak_g[1]);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, sqrtf(0.02f + 0.32f), s.rms);
+}
+
+void test_still_sensor_reports_no_vibration(void) {
+    for (size_t n = 0; n < 256; n++) analyzer->push(1.0f);
+    TEST_ASSERT_TRUE(analyzer->process());
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.0f, analyzer->getSpectrum().rms);
+}
+
+// ============================================================================
+// DOUBLE BUFFER TESTS
+// ============================================================================
+
+void test_process_without_block_returns_false(void) {
+    TEST_ASSERT_FALSE(analyzer->process());
+    for (size_t n = 0; n < 255; n++) analyzer->push(0.0f);
+    TEST_ASSERT_FALSE(analyzer->isBlockReady());
+    analyzer->push(0.0f);
+    TEST_ASSERT_TRUE(analyzer->isBlockReady());
+}
+
+void test_acquisition_continues_during_transform(void) {
+    // Block 1 ready; samples keep landing in the other buffer while it waits
+    pushBlock(*analyzer, 0.0f, 50.0f, 0.3f);
+    for (size_t n = 0; n < 100; n++) analyzer->push(0.0f);
+    TEST_ASSERT_TRUE(analyzer->process());
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 50.0f, analyzer->getSpectrum().peak_hz[0]);
+    TEST_ASSERT_FALSE(analyzer->process());
+
+    for (size_t n = 100; n < 256; n++) analyzer->push(0.0f);
+    TEST_ASSERT_TRUE(analyzer->isBlockReady());
+    TEST_ASSERT_EQUAL_UINT32(0, analyzer->getOverruns());
+
+    // Another full block before the consumer runs: dropped and counted, never blocking
+    pushBlock(*analyzer, 0.0f, 50.0f, 0.3f);
+    TEST_ASSERT_EQUAL_UINT32(1, analyzer->getOverruns());
+    TEST_ASSERT_TRUE(analyzer->process());
+    TEST_ASSERT_EQUAL_UINT32(2, analyzer->getBlockCount());
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+#ifndef ARDUINO
+void test_block_analysis_benchmark(void) {
+    const int blocks = 2000;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int b = 0; b < blocks; b++) {
+        pushBlock(*analyzer, 1.0f, 120.0f, 0.5f);
+        analyzer->process();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "256-point block (push + FFT + bands + peaks): %.1f us, %u bytes",
+             std::chrono::duration<double, std::micro>(t1 - t0).count() / blocks, (unsigned)sizeof(Analyzer256));
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL_UINT32(blocks, analyzer->getBlockCount());
+}
+#endif
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void runAllTests(void) {
+    UNITY_BEGIN();
+
+    // FFT tests
+    RUN_TEST(test_real_fft_matches_naive_dft);
+
+    // Spectrum tests
+    RUN_TEST(test_single_tone_peak_and_band);
+    RUN_TEST(test_two_tones_sorted_by_amplitude);
+    RUN_TEST(test_still_sensor_reports_no_vibration);
+
+    // Double buffer tests
+    RUN_TEST(test_process_without_block_returns_false);
+    RUN_TEST(test_acquisition_continues_during_transform);
+
+    // Performance tests
+#ifndef ARDUINO
+    RUN_TEST(test_block_analysis_benchmark);
+#endif
+
+    UNITY_END();
+}
+
+#ifndef ARDUINO
+int main() {
+    runAllTests();
+    return 0;
+}
+#endif
@@ -0,0 +1,171 @@
+// test/test_QuantileSketch.cpp
+#include <unity.h>
+#include "arduino_compat.h"
+#include "device/stats/QuantileSketch.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace overseer::device::stats;
+
+static const float MAX_RELATIVE_ERROR = 1.0f / (2 * LogHistogram::SUB_BUCKETS);
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static uint32_t rngState = 1;
+static float nextUniform() {
+    rngState = rngState * 1664525u + 1013904223u;
+    return (rngState >> 8) / 16777216.0f;
+}
+
+// Exact quantile with the same rank convention as the sketch
+static float exactQuantile(std::vector<float> values, float q) {
+    std::sort(values.begin(), values.end());
+    return values[(size_t)(q * (values.size() - 1))];
+}
+
+// ============================================================================
+// HISTOGRAM TESTS
+// ============================================================================
+
+void test_bin_midpoint_error_is_bounded(void) {
+    float worst = 0.0f;
+    for (float v = 0.002f; v < 60.0f; v *= 1.003f) {
+        float reported = LogHistogram::binValue(LogHistogram::binOf(v, -10), -10);
+        worst = fmaxf(worst, fabsf(reported - v) / v);
+    }
+    TEST_ASSERT_TRUE(worst <= MAX_RELATIVE_ERROR);
+}
+
+void test_out_of_range_values(void) {
+    TEST_ASSERT_EQUAL(0, LogHistogram::binOf(0.0f, -10));
+    TEST_ASSERT_EQUAL(0, LogHistogram::binOf(NAN, -10));
+    TEST_ASSERT_EQUAL(LogHistogram::BINS - 1, LogHistogram::binOf(1.0e6f, -10));
+    TEST_ASSERT_EQUAL(LogHistogram::binOf(3.0f, -10), LogHistogram::binOf(-3.0f, -10));
+}
+
+void test_quantiles_track_exact_values(void) {
+    QuantileWindows q;
+    q.configure({60});
+    q.advance(0);
+
+    // Skewed load current: mostly 2-4 A with rare 20-30 A inrush
+    std::vector<float> values;
+    for (int i = 0; i < 20000; i++) {
+        float v = nextUniform() < 0.97f ? 2.0f + 2.0f * nextUniform() : 20.0f + 10.0f * nextUniform();
+        values.push_back(v);
+        q.add(v);
+    }
+
+    QuantileSummary s = q.summary(0);
+    TEST_ASSERT_EQUAL_UINT32(20000, s.count);
+    TEST_ASSERT_FLOAT_WITHIN(exactQuantile(values, 0.50f) * MAX_RELATIVE_ERROR, exactQuantile(values, 0.50f), s.p50);
+    TEST_ASSERT_FLOAT_WITHIN(exactQuantile(values, 0.95f) * MAX_RELATIVE_ERROR, exactQuantile(values, 0.95f), s.p95);
+    TEST_ASSERT_FLOAT_WITHIN(exactQuantile(values, 0.99f) * MAX_RELATIVE_ERROR, exactQuantile(values, 0.99f), s.p99);
+}
+
+void test_histograms_merge(void) {
+    LogHistogram a, b, both;
+    for (int i = 1; i <= 1000; i++) {
+        uint16_t bin = LogHistogram::binOf(i * 0.01f, -10);
+        (i % 2 ? a : b).addBin(bin);
+        both.addBin(bin);
+    }
+    a.merge(b);
+    TEST_ASSERT_EQUAL_UINT32(both.getCount(), a.getCount());
+    TEST_ASSERT_EQUAL_FLOAT(both.quantile(0.95f, -10), a.quantile(0.95f, -10));
+    for (uint16_t bin = 0; bin < LogHistogram::BINS; bin++) {
+        TEST_ASSERT_EQUAL_UINT32(both.getBin(bin), a.getBin(bin));
+    }
+}
+
+// ============================================================================
+// WINDOW TESTS
+// ============================================================================
+
+void test_old_samples_expire_per_tier(void) {
+    QuantileWindows q;
+    q.configure({1, 10});
+    q.advance(0);
+    for (int i = 0; i < 100; i++) q.add(25.0f);
+
+    // 1.5 s later: the 1 s tier has forgotten the burst, the 10 s tier has not
+    for (unsigned long t = 250; t <= 1500; t += 250) q.advance(t);
+    q.add(1.0f);
+    TEST_ASSERT_EQUAL_UINT32(1, q.count(0));
+    TEST_ASSERT_FLOAT_WITHIN(1.0f * MAX_RELATIVE_ERROR, 1.0f, q.quantile(0, 0.99f));
+    TEST_ASSERT_FLOAT_WITHIN(25.0f * MAX_RELATIVE_ERROR, 25.0f, q.quantile(1, 0.99f));
+
+    q.advance(60000);
+    TEST_ASSERT_EQUAL_UINT32(0, q.count(1));
+}
+
+void test_signed_quantiles_keep_sign(void) {
+    QuantileWindows q;
+    q.configure({60, 300}, -4, true);
+    q.advance(0);
+
+    // Outdoor temperature straddling zero: -15..+5 C
+    std::vector<float> values;
+    for (int i = 0; i < 5000; i++) {
+        float v = -15.0f + 20.0f * nextUniform();
+        values.push_back(v);
+        q.add(v);
+    }
+
+    QuantileSummary s = q.summary(1);
+    TEST_ASSERT_EQUAL_UINT32(5000, s.count);
+    TEST_ASSERT_TRUE(s.p50 < 0.0f);
+    TEST_ASSERT_TRUE(s.p99 > 0.0f);
+    float p05 = q.quantile(0, 0.05f);
+    TEST_ASSERT_FLOAT_WITHIN(fabsf(exactQuantile(values, 0.05f)) * MAX_RELATIVE_ERROR, exactQuantile(values, 0.05f), p05);
+    TEST_ASSERT_FLOAT_WITHIN(fabsf(exactQuantile(values, 0.50f)) * MAX_RELATIVE_ERROR, exactQuantile(values, 0.50f), s.p50);
+    TEST_ASSERT_FLOAT_WITHIN(fabsf(exactQuantile(values, 0.99f)) * MAX_RELATIVE_ERROR, exactQuantile(values, 0.99f), s.p99);
+
+    // Expiry clears both halves
+    q.advance(600000);
+    TEST_ASSERT_EQUAL_UINT32(0, q.count(0));
+    TEST_ASSERT_EQUAL_UINT32(0, q.count(1));
+}
+
+void test_memory_is_fixed_per_tier(void) {
+    QuantileWindows q;
+    q.configure({60, 300, 1800});
+    q.advance(0);
+    for (unsigned long i = 0; i < 200000; i++) {
+        q.add((i % 1000) * 0.03f);
+        q.advance(i * 10);
+    }
+    // Histogram storage does not grow with samples: SLICES fixed-size histograms per tier
+    TEST_ASSERT_LESS_OR_EQUAL(2200, sizeof(LogHistogram) * QuantileWindows::SLICES);
+    TEST_ASSERT_TRUE(q.count(2) > 0);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void runAllTests(void) {
+    UNITY_BEGIN();
+
+    // Histogram tests
+    RUN_TEST(test_bin_midpoint_error_is_bounded);
+    RUN_TEST(test_out_of_range_values);
+    RUN_TEST(test_quantiles_track_exact_values);
+    RUN_TEST(test_histograms_merge);
+
+    // Window tests
+    RUN_TEST(test_old_samples_expire_per_tier);
+    RUN_TEST(test_signed_quantiles_keep_sign);
+    RUN_TEST(test_memory_is_fixed_per_tier);
+
+    UNITY_END();
+}
+
+#ifndef ARDUINO
+int main() {
+    runAllTests();
+    return 0;
+}
+#endif
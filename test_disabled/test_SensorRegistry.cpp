@@ -0,0 +1,146 @@
+// test/test_SensorRegistry.cpp
+#include <unity.h>
+#include "arduino_compat.h"
+#include "device/SensorRegistry.h"
+
+using namespace overseer::device;
+
+// Minimal devices with the begin()/update() shape the registry expects
+struct FakeImu {
+    static constexpr HARDWARE_DEVICE_TYPE DEVICE_TYPE = IMU;
+    int begins = 0;
+    int updates = 0;
+    bool begin() { begins++; return true; }
+    void update() { updates++; }
+};
+
+struct FakeCurrent {
+    static constexpr HARDWARE_DEVICE_TYPE DEVICE_TYPE = ENERGY;
+    uint8_t pin = 0;
+    bool fail = false;
+    int updates = 0;
+    FakeCurrent() = default;
+    explicit FakeCurrent(uint8_t p) : pin(p) {}
+    bool begin() { return !fail; }
+    void update() { updates++; }
+};
+
+struct UntypedDevice {
+    int updates = 0;
+    bool begin() { return true; }
+    void update() { updates++; }
+};
+
+typedef std::array<FakeCurrent, 4> CurrentBank;
+typedef SensorRegistry<FakeImu, FakeCurrent, CurrentBank, UntypedDevice> TestNode;
+
+// Registry is a plain value type: no vtable, no heap, nothing beyond the devices themselves
+static_assert(!std::is_polymorphic<TestNode>::value, "registry must not be polymorphic");
+static_assert(sizeof(TestNode) == sizeof(std::tuple<FakeImu, FakeCurrent, CurrentBank, UntypedDevice>),
+              "registry must not add storage");
+static_assert(TestNode::slotCount() == 4, "slot count");
+static_assert(TestNode::deviceCount() == 7, "arrays count per element");
+static_assert(TestNode::countOfType<ENERGY>() == 5, "energy devices");
+static_assert(TestNode::countOfType<ENVIRONMENT>() == 0, "no environment devices");
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// ============================================================================
+// LOOKUP TESTS
+// ============================================================================
+
+void test_typed_lookup_returns_same_instance(void) {
+    TestNode node;
+    node.get<FakeImu>().updates = 42;
+    TEST_ASSERT_EQUAL(42, node.get<0>().updates);
+    TEST_ASSERT_EQUAL_PTR(&node.get<FakeImu>(), &node.get<0>());
+}
+
+void test_constructor_forwards_per_slot(void) {
+    TestNode node(FakeImu(), FakeCurrent(34),
+                  CurrentBank{FakeCurrent(1), FakeCurrent(2), FakeCurrent(3), FakeCurrent(4)},
+                  UntypedDevice());
+    TEST_ASSERT_EQUAL(34, node.get<FakeCurrent>().pin);
+    TEST_ASSERT_EQUAL(3, node.get<CurrentBank>()[2].pin);
+}
+
+// ============================================================================
+// DISPATCH TESTS
+// ============================================================================
+
+void test_update_all_reaches_every_device(void) {
+    TestNode node;
+    node.updateAll();
+    node.updateAll();
+
+    TEST_ASSERT_EQUAL(2, node.get<FakeImu>().updates);
+    TEST_ASSERT_EQUAL(2, node.get<FakeCurrent>().updates);
+    for (const FakeCurrent& c : node.get<CurrentBank>()) {
+        TEST_ASSERT_EQUAL(2, c.updates);
+    }
+    TEST_ASSERT_EQUAL(2, node.get<UntypedDevice>().updates);
+}
+
+void test_begin_all_counts_failures_and_continues(void) {
+    TestNode node;
+    node.get<FakeCurrent>().fail = true;
+    node.get<CurrentBank>()[1].fail = true;
+
+    TEST_ASSERT_EQUAL(5, node.beginAll());
+    TEST_ASSERT_EQUAL(1, node.get<FakeImu>().begins);
+}
+
+void test_for_each_visits_in_declaration_order(void) {
+    TestNode node;
+    int order = 0;
+    int imuIndex = -1, untypedIndex = -1;
+    node.forEach([&](auto& device) {
+        using Device = std::decay_t<decltype(device)>;
+        if (std::is_same<Device, FakeImu>::value) imuIndex = order;
+        if (std::is_same<Device, UntypedDevice>::value) untypedIndex = order;
+        order++;
+    });
+    TEST_ASSERT_EQUAL(7, order);
+    TEST_ASSERT_EQUAL(0, imuIndex);
+    TEST_ASSERT_EQUAL(6, untypedIndex);
+}
+
+void test_for_each_of_type_filters_by_category(void) {
+    TestNode node;
+    int visited = 0;
+    node.forEachOfType<ENERGY>([&](auto& device) {
+        device.update();
+        visited++;
+    });
+    TEST_ASSERT_EQUAL(5, visited);
+    TEST_ASSERT_EQUAL(0, node.get<FakeImu>().updates);
+    TEST_ASSERT_EQUAL(0, node.get<UntypedDevice>().updates);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void runAllTests(void) {
+    UNITY_BEGIN();
+
+    // Lookup tests
+    RUN_TEST(test_typed_lookup_returns_same_instance);
+    RUN_TEST(test_constructor_forwards_per_slot);
+
+    // Dispatch tests
+    RUN_TEST(test_update_all_reaches_every_device);
+    RUN_TEST(test_begin_all_counts_failures_and_continues);
+    RUN_TEST(test_for_each_visits_in_declaration_order);
+    RUN_TEST(test_for_each_of_type_filters_by_category);
+
+    UNITY_END();
+}
+
+#ifndef ARDUINO
+int main() {
+    runAllTests();
+    return 0;
+}
+#endif
@@ -0,0 +1,166 @@
+// test/test_TimeAligner.cpp
+#include <unity.h>
+#include "arduino_compat.h"
+#include "device/sync/TimeAligner.h"
+
+#include <vector>
+
+using namespace overseer::device::sync;
+
+typedef TimeAligner<4, 16> Aligner;
+
+// Global test objects
+Aligner* aligner = nullptr;
+std::vector<Aligner::Frame> frames;
+
+static size_t run(uint32_t now_us) {
+    return aligner->process(now_us, [](const Aligner::Frame& f) { frames.push_back(f); });
+}
+
+void setUp(void) {
+    aligner = new Aligner();
+    frames.clear();
+}
+
+void tearDown(void) {
+    delete aligner;
+    aligner = nullptr;
+}
+
+// ============================================================================
+// ALIGNMENT TESTS
+// ============================================================================
+
+void test_streams_interpolate_onto_common_timebase(void) {
+    uint8_t fast = aligner->addStream("gz");
+    uint8_t slow = aligner->addStream("current");
+    aligner->setFrameRate(200);                         // 5 ms frames
+
+    // gz = t/1000 sampled every 1 ms at +300 us; current = 2 * t/1000 every 10 ms at +7 ms
+    for (uint32_t t = 300; t < 40000; t += 1000) {
+        aligner->push(fast, t, t / 1000.0f);
+        if (t % 10000 == 300) aligner->push(slow, t + 6700, 2.0f * (t + 6700) / 1000.0f);
+        run(t);
+    }
+    TEST_ASSERT_TRUE(frames.size() >= 6);
+    for (const Aligner::Frame& f : frames) {
+        TEST_ASSERT_EQUAL(0, f.t_us % 5000);
+        TEST_ASSERT_TRUE(f.isValid(fast));
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, f.t_us / 1000.0f, f.get(fast));
+        if (f.isValid(slow)) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-3f, 2.0f * f.t_us / 1000.0f, f.get(slow));
+        }
+    }
+    // Once both streams run, every frame has both
+    TEST_ASSERT_TRUE(frames.back().isValid(slow));
+    TEST_ASSERT_EQUAL(0, frames.back().held_mask);
+}
+
+void test_frames_wait_for_lagging_stream(void) {
+    uint8_t a = aligner->addStream("a");
+    uint8_t b = aligner->addStream("b");
+    aligner->setFrameRate(100);
+    aligner->setMaxLatency(50000);
+
+    aligner->push(a, 1000, 1.0f);
+    aligner->push(b, 1000, 1.0f);
+    aligner->push(a, 25000, 2.0f);
+    TEST_ASSERT_EQUAL(0, run(25000));                   // b has nothing past 10 ms yet
+
+    aligner->push(b, 21000, 3.0f);
+    TEST_ASSERT_EQUAL(2, run(25000));                   // 10 ms and 20 ms
+    TEST_ASSERT_EQUAL(20000, frames.back().t_us);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 2.9f, frames.back().get(b));
+
+    // b goes silent: frames still come out once they are max_latency old
+    TEST_ASSERT_EQUAL(0, run(70000 - 1));
+    TEST_ASSERT_EQUAL(1, run(80000));
+    TEST_ASSERT_EQUAL(30000, frames.back().t_us);
+    TEST_ASSERT_TRUE(frames.back().held_mask != 0);
+}
+
+void test_hold_stream_does_not_gate_and_expires(void) {
+    uint8_t g = aligner->addStream("g");
+    uint8_t rh = aligner->addStream("humidity", AlignMode::HOLD, 20000);
+    aligner->setFrameRate(100);
+
+    aligner->push(rh, 500, 55.0f);
+    for (uint32_t t = 1000; t <= 41000; t += 1000) {
+        aligner->push(g, t, 0.0f);
+        run(t);
+    }
+    TEST_ASSERT_EQUAL(4, frames.size());                // 10..40 ms
+    TEST_ASSERT_EQUAL_FLOAT(55.0f, frames[0].get(rh));
+    TEST_ASSERT_TRUE(frames[1].isValid(rh));            // 19.5 ms old
+    TEST_ASSERT_FALSE(frames[2].isValid(rh));           // 29.5 ms old
+    TEST_ASSERT_TRUE(isnan(frames[3].values[rh]));
+}
+
+// ============================================================================
+// BUFFER TESTS
+// ============================================================================
+
+void test_buffers_are_bounded(void) {
+    uint8_t s = aligner->addStream("s");
+    aligner->setFrameRate(10);
+    for (uint32_t t = 1; t <= 100; t++) aligner->push(s, t * 100, (float)t);
+    TEST_ASSERT_EQUAL(16, aligner->getBuffered(s));
+    TEST_ASSERT_EQUAL(84, aligner->getOverflowCount(s));
+
+    TEST_ASSERT_FALSE(aligner->push(s, 5000, 0.0f));    // out of order
+    TEST_ASSERT_EQUAL(1, aligner->getRejectedCount(s));
+}
+
+void test_stalled_caller_skips_ahead(void) {
+    uint8_t s = aligner->addStream("s");
+    aligner->setFrameRate(1000);
+    aligner->setMaxLatency(5000);
+    aligner->push(s, 100, 1.0f);
+    aligner->push(s, 1000000, 1.0f);
+    run(1000000);
+    TEST_ASSERT_TRUE(aligner->getSkippedFrames() > 900);
+    TEST_ASSERT_TRUE(frames.size() <= 6);
+    TEST_ASSERT_EQUAL(1000000, frames.back().t_us);
+}
+
+void test_timestamps_wrap(void) {
+    uint8_t s = aligner->addStream("s");
+    aligner->setFrameRate(1000);
+    uint32_t t0 = 0xFFFFF000u;
+    for (uint32_t i = 0; i < 10; i++) {
+        aligner->push(s, t0 + i * 1000, (float)i);
+        run(t0 + i * 1000);
+    }
+    TEST_ASSERT_EQUAL(9, frames.size());
+    for (size_t i = 1; i < frames.size(); i++) {
+        TEST_ASSERT_EQUAL(1000, frames[i].t_us - frames[i - 1].t_us);
+        TEST_ASSERT_TRUE(frames[i].get(s) > frames[i - 1].get(s));
+    }
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void runAllTests(void) {
+    UNITY_BEGIN();
+
+    // Alignment tests
+    RUN_TEST(test_streams_interpolate_onto_common_timebase);
+    RUN_TEST(test_frames_wait_for_lagging_stream);
+    RUN_TEST(test_hold_stream_does_not_gate_and_expires);
+
+    // Buffer tests
+    RUN_TEST(test_buffers_are_bounded);
+    RUN_TEST(test_stalled_caller_skips_ahead);
+    RUN_TEST(test_timestamps_wrap);
+
+    UNITY_END();
+}
+
+#ifndef ARDUINO
+int main() {
+    runAllTests();
+    return 0;
+}
+#endif
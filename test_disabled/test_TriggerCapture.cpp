@@ -0,0 +1,163 @@
+// test/test_TriggerCapture.cpp
+#include <unity.h>
+#include "arduino_compat.h"
+#include "device/capture/TriggerCapture.h"
+
+#include <vector>
+
+using namespace overseer::device::capture;
+
+// Global test objects
+TriggerCapture* cap = nullptr;
+std::vector<CaptureSample> drained;
+Capture last;
+
+static bool drainOne() {
+    return cap->drain([](const Capture& c) {
+        last = c;
+        drained.assign(c.samples, c.samples + c.count);
+    });
+}
+
+// 1 kHz stream: value(t) for sample index i
+static void feed(uint32_t from, uint32_t to, float (*value)(uint32_t)) {
+    for (uint32_t i = from; i < to; i++) cap->push(i * 1000, value(i));
+}
+
+static float spikeAt100(uint32_t i) { return i == 100 ? 5.0f : 0.0f; }
+
+void setUp(void) {
+    cap = new TriggerCapture();
+    cap->configure(8, 4, 2);
+    drained.clear();
+}
+
+void tearDown(void) {
+    delete cap;
+    cap = nullptr;
+}
+
+// ============================================================================
+// TRIGGER TESTS
+// ============================================================================
+
+void test_level_trigger_freezes_pre_and_post(void) {
+    TriggerConfig trigger;
+    trigger.type = TriggerType::CROSS_ABOVE;
+    trigger.threshold = 1.0f;
+    cap->setTrigger(trigger);
+
+    feed(0, 104, spikeAt100);
+    TEST_ASSERT_TRUE(cap->isCollecting());              // one post sample short
+    feed(104, 105, spikeAt100);
+    TEST_ASSERT_FALSE(cap->isCollecting());
+    TEST_ASSERT_EQUAL(1, cap->readyCount());
+
+    TEST_ASSERT_TRUE(drainOne());
+    TEST_ASSERT_TRUE(last.reason == TriggerType::CROSS_ABOVE);
+    TEST_ASSERT_EQUAL(8, last.pre_count);
+    TEST_ASSERT_EQUAL(13, last.count);
+    TEST_ASSERT_EQUAL(92000, drained[0].t_us);
+    TEST_ASSERT_EQUAL(100000, last.trigger_us);
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, drained[8].value);
+    TEST_ASSERT_EQUAL(104000, drained[12].t_us);
+    TEST_ASSERT_EQUAL(0, cap->readyCount());
+}
+
+void test_magnitude_and_slope_triggers(void) {
+    TriggerConfig trigger;
+    trigger.type = TriggerType::MAGNITUDE;
+    trigger.threshold = 2.0f;
+    cap->setTrigger(trigger);
+    feed(0, 50, [](uint32_t i) { return i >= 20 ? -3.0f : 0.0f; });     // negative current step
+    TEST_ASSERT_EQUAL(1, cap->getCaptureCount());           // level stays high: no re-trigger
+
+    trigger.type = TriggerType::SLOPE;
+    trigger.threshold = 1500.0f;                            // units per second
+    cap->setTrigger(trigger);
+    feed(50, 80, [](uint32_t i) { return (i - 50) * 1.0f - 3.0f; });   // 1000/s ramp, below threshold
+    TEST_ASSERT_EQUAL(1, cap->getTriggerCount());
+    feed(80, 90, [](uint32_t i) { return (i - 50) * 2.0f; });          // jump, then 2000/s
+    TEST_ASSERT_EQUAL(2, cap->getTriggerCount());
+}
+
+void test_external_trigger_and_short_pre_ring(void) {
+    feed(0, 3, [](uint32_t) { return 1.0f; });
+    cap->fire();
+    feed(3, 8, [](uint32_t i) { return (float)i; });
+    TEST_ASSERT_TRUE(drainOne());
+    TEST_ASSERT_TRUE(last.reason == TriggerType::EXTERNAL);
+    TEST_ASSERT_EQUAL(3, last.pre_count);                   // ring was not full yet
+    TEST_ASSERT_EQUAL(8, last.count);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, last.trigger_value);
+}
+
+// ============================================================================
+// SLOT TESTS
+// ============================================================================
+
+void test_full_slots_count_missed_and_drain_in_order(void) {
+    cap->setTrigger(TriggerConfig());
+    for (int n = 0; n < 3; n++) {
+        cap->fire();
+        feed(n * 10, n * 10 + 10, [](uint32_t i) { return (float)i; });
+    }
+    TEST_ASSERT_EQUAL(3, cap->getTriggerCount());
+    TEST_ASSERT_EQUAL(2, cap->getCaptureCount());
+    TEST_ASSERT_EQUAL(1, cap->getMissedCount());
+
+    TEST_ASSERT_TRUE(drainOne());
+    TEST_ASSERT_EQUAL(0, last.sequence);
+    TEST_ASSERT_TRUE(drainOne());
+    TEST_ASSERT_EQUAL(1, last.sequence);
+    TEST_ASSERT_FALSE(drainOne());
+}
+
+void test_holdoff_delays_rearm(void) {
+    TriggerConfig trigger;
+    trigger.type = TriggerType::CROSS_ABOVE;
+    trigger.threshold = 0.5f;
+    trigger.holdoff_us = 20000;
+    cap->setTrigger(trigger);
+
+    // Square wave, period 4 ms: a rising crossing every 4 samples
+    feed(0, 60, [](uint32_t i) { return (i % 4) >= 2 ? 1.0f : 0.0f; });
+    // First capture completes at 6 ms, re-arms at 26 ms; second completes at 34 ms, third would wait to 54 ms
+    TEST_ASSERT_EQUAL(2, cap->getCaptureCount());
+}
+
+void test_unconfigured_capture_is_inert(void) {
+    TriggerCapture idle;
+    idle.fire();
+    idle.push(0, 1.0f);
+    TEST_ASSERT_FALSE(idle.isConfigured());
+    TEST_ASSERT_EQUAL(0, idle.getTriggerCount());
+    TEST_ASSERT_FALSE(idle.drain([](const Capture&) {}));
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void runAllTests(void) {
+    UNITY_BEGIN();
+
+    // Trigger tests
+    RUN_TEST(test_level_trigger_freezes_pre_and_post);
+    RUN_TEST(test_magnitude_and_slope_triggers);
+    RUN_TEST(test_external_trigger_and_short_pre_ring);
+
+    // Slot tests
+    RUN_TEST(test_full_slots_count_missed_and_drain_in_order);
+    RUN_TEST(test_holdoff_delays_rearm);
+    RUN_TEST(test_unconfigured_capture_is_inert);
+
+    UNITY_END();
+}
+
+#ifndef ARDUINO
+int main() {
+    runAllTests();
+    return 0;
+}
+#endif
@@ -6,6 +6,7 @@
 
 using namespace overseer::device::energy;
 using namespace overseer::device::energy::data;
+using namespace overseer::device;
 
 // Mock filesystem for native testing
 #ifndef ARDUINO
@@ -19,7 +20,7 @@ MockFS mockFS;
 #endif
 
 // Test fixtures and mocks
-class MockConfigManager : public config::ConfigManager {
+class MockConfigManager final : public config::ConfigManager {
 public:
 #ifdef ARDUINO
     MockConfigManager() : config::ConfigManager(SPIFFS, "/test_config.ini") {}
@@ -60,6 +61,49 @@ int analogRead(uint8_t pin) {
     if (mockAdcFail) return -1;
     return mockAdcValue;
 }
+
+// Heap allocation counter for the data access tests
+static bool countAllocations = false;
+static size_t allocationCount = 0;
+
+// Every replaceable form (plain/array, sized, aligned) goes through these two, so
+// alignas(32) types are counted too and each pointer is freed by its own allocator
+static void* countedAlloc(size_t size, size_t alignment) {
+    if (countAllocations) allocationCount++;
+    if (size == 0) size = 1;
+    void* p;
+    if (alignment <= alignof(std::max_align_t)) {
+        p = malloc(size);
+    } else {
+        p = aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    }
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+// Out of line so the compiler never pairs free() with a new-expression it can see
+__attribute__((noinline)) static void countedFree(void* p) noexcept { free(p); }
+
+void* operator new(size_t size) { return countedAlloc(size, 0); }
+void* operator new[](size_t size) { return countedAlloc(size, 0); }
+void* operator new(size_t size, std::align_val_t al) { return countedAlloc(size, (size_t)al); }
+void* operator new[](size_t size, std::align_val_t al) { return countedAlloc(size, (size_t)al); }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, size_t) noexcept { countedFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { countedFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { countedFree(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { countedFree(p); }
+
+template <typename Fn>
+static size_t allocationsDuring(Fn&& fn) {
+    allocationCount = 0;
+    countAllocations = true;
+    fn();
+    countAllocations = false;
+    return allocationCount;
+}
 #endif
 
 void setUp(void) {
@@ -219,6 +263,54 @@ void test_invalid_reading_out_of_range(void) {
     TEST_ASSERT_FALSE(testSensor->isValidReading(100.0f));
 }
 
+void test_valid_range_is_configurable(void) {
+    testSensor->begin();
+    testSensor->setValidRange(-5.0f, 20.0f);
+
+    TEST_ASSERT_TRUE(testSensor->isValidReading(19.0f));
+    TEST_ASSERT_FALSE(testSensor->isValidReading(-6.0f));
+    TEST_ASSERT_FALSE(testSensor->isValidReading(25.0f));
+}
+
+void test_alarm_raised_inline_on_update(void) {
+    alarm::AlarmEngine alarms;
+    alarm::AlarmRule rule;
+    rule.signal = 7;
+    rule.high = 5.0f;
+    alarms.addRule(rule);
+
+    testSensor->begin();
+    testSensor->attachAlarms(alarms, 7);
+    testSensor->update();
+    TEST_ASSERT_EQUAL(0, alarms.getActiveCount());
+
+    // ~10 A on a 66 mV/A sensor; raised by the very sample that crossed the limit
+    mockAdcValue = 2048 + (int)(0.66f / 3.3f * 4095);
+    testSensor->update();
+
+    alarm::AlarmEvent event;
+    TEST_ASSERT_TRUE(alarms.poll(event));
+    TEST_ASSERT_EQUAL(7, event.signal);
+    TEST_ASSERT_TRUE(event.raised);
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 10.0f, event.value);
+}
+
+void test_invalid_readings_skip_alarms(void) {
+    alarm::AlarmEngine alarms;
+    alarm::AlarmRule rule;
+    rule.high = 5.0f;
+    alarms.addRule(rule);
+
+    testSensor->begin();
+    testSensor->setValidRange(-1.0f, 1.0f);
+    testSensor->attachAlarms(alarms, 0);
+    mockAdcValue = 2048 + (int)(0.66f / 3.3f * 4095);
+    testSensor->update();
+
+    TEST_ASSERT_FALSE(testSensor->getData().valid_reading);
+    TEST_ASSERT_EQUAL(0, alarms.getActiveCount());
+}
+
 // ============================================================================
 // CALIBRATION TESTS
 // ============================================================================
@@ -234,6 +326,97 @@ void test_zero_point_calibration(void) {
     TEST_ASSERT_FLOAT_WITHIN(0.01f, expectedVoltage, testSensor->getZeroCurrentVoltage());
 }
 
+void test_zero_calibration_stops_early_on_clean_signal(void) {
+    calibration::ZeroCalibration cal;
+    calibration::ZeroCalibrationConfig cfg;
+    cfg.max_samples = 200;
+    cal.start(cfg);
+
+    unsigned long now = 0;
+    for (int i = 0; i < 200 && cal.isRunning(); i++) {
+        now += cfg.sample_interval_ms;
+        TEST_ASSERT_TRUE(cal.isDue(now));
+        cal.addSample(1.65f + ((i % 3) - 1) * 0.0005f, now);
+    }
+
+    TEST_ASSERT_TRUE(cal.getState() == calibration::CalibrationState::DONE);
+    TEST_ASSERT_LESS_THAN_UINT32(cfg.max_samples, cal.getSampleCount());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.65f, cal.getMean());
+}
+
+void test_zero_calibration_rejects_noisy_signal(void) {
+    calibration::ZeroCalibration cal;
+    cal.start();
+
+    for (int i = 0; i < 200 && cal.isRunning(); i++) {
+        cal.addSample(1.65f + ((i & 1) ? 0.1f : -0.1f), i * 10);
+    }
+
+    TEST_ASSERT_TRUE(cal.getState() == calibration::CalibrationState::REJECTED);
+}
+
+void test_zero_calibration_accepts_adc_noise_at_max_samples(void) {
+    // ~6 mV of ESP32 ADC noise never gets the 99% CI under 1 mV in 100 samples,
+    // but is well inside max_stddev: the mean is still applied
+    calibration::ZeroCalibration cal;
+    calibration::ZeroCalibrationConfig cfg;
+    cfg.max_samples = 100;
+    cal.start(cfg);
+
+    uint32_t seed = 3;
+    for (int i = 0; i < 100 && cal.isRunning(); i++) {
+        seed = seed * 1664525u + 1013904223u;
+        cal.addSample(1.65f + ((int32_t)seed / 2147483648.0f) * 0.01f, i * 10);
+    }
+
+    TEST_ASSERT_TRUE(cal.getState() == calibration::CalibrationState::DONE);
+    TEST_ASSERT_EQUAL(100, cal.getSampleCount());
+    TEST_ASSERT_FLOAT_WITHIN(0.003f, 1.65f, cal.getMean());
+}
+
+void test_nonblocking_zero_calibration_via_update(void) {
+    testSensor->begin();
+    calibration::ZeroCalibrationConfig cfg;
+    cfg.sample_interval_ms = 0;
+    testSensor->setZeroCalibrationConfig(cfg);
+    testSensor->startZeroCalibration();
+    TEST_ASSERT_TRUE(testSensor->isCalibrating());
+
+    mockAdcValue = 2100;
+    int updates = 0;
+    while (testSensor->isCalibrating() && updates < 500) {
+        testSensor->update();
+        updates++;
+    }
+
+    float expectedVoltage = (2100 * 3.3f) / 4095.0f;
+    TEST_ASSERT_TRUE(testSensor->getCalibrationState() == calibration::CalibrationState::DONE);
+    TEST_ASSERT_EQUAL(cfg.min_samples, updates);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, expectedVoltage, testSensor->getZeroCurrentVoltage());
+    TEST_ASSERT_TRUE(testSensor->getData().is_calibrated);
+}
+
+struct OffsetZeroProfile : profile::WCSDefaultProfile {
+    static constexpr uint8_t pin = 34;
+    static constexpr float zero_voltage = 1.6f;
+};
+
+void test_explicit_zero_point_survives_begin(void) {
+    // A profile's explicit zero is not re-derived as vcc/2 by begin()
+    WCS1800 sensor;
+    sensor.applyProfile<OffsetZeroProfile>();
+    TEST_ASSERT_TRUE(sensor.begin());
+    TEST_ASSERT_FLOAT_WITHIN(1.0e-6f, 1.6f, sensor.getZeroCurrentVoltage());
+
+    // Neither is a calibrated one when begin() runs again
+    testSensor->begin();
+    mockAdcValue = 2100;
+    testSensor->calibrateZeroPoint(10);
+    float calibrated = testSensor->getZeroCurrentVoltage();
+    testSensor->begin();
+    TEST_ASSERT_EQUAL_FLOAT(calibrated, testSensor->getZeroCurrentVoltage());
+}
+
 void test_sensitivity_configuration(void) {
     testSensor->begin();
     testSensor->setSensitivity(100.0f); // Custom sensitivity
@@ -276,6 +459,86 @@ void test_data_injection(void) {
     TEST_ASSERT_EQUAL_UINT64(100, retrievedData.total_samples);
 }
 
+#ifndef ARDUINO
+void test_get_data_is_copy_free(void) {
+    testSensor->begin();
+    testSensor->update();
+    TEST_ASSERT_EQUAL(11, testSensor->getData().max_current_windows.size());
+
+    float sink = 0.0f;
+    size_t byRef = allocationsDuring([&] {
+        const WCSData& data = testSensor->getData();
+        sink += data.current + data.max_current_windows.begin()->second;
+        sink += testSensor->getCurrent() + testSensor->getMaxCurrent();
+    });
+    size_t byValue = allocationsDuring([&] {
+        WCSData copy = testSensor->getData();
+        sink += copy.current;
+    });
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "allocations: const-ref %u, by-value copy %u", (unsigned)byRef, (unsigned)byValue);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL(0, byRef);
+    TEST_ASSERT_GREATER_OR_EQUAL(11, byValue);     // one map node per window at least
+    (void)sink;
+}
+
+void test_visit_data_is_copy_free(void) {
+    testSensor->begin();
+    testSensor->update();
+
+    int scalars = 0, windows = 0;
+    size_t allocations = allocationsDuring([&] {
+        testSensor->visitData([&](const char* name, const char* window, float value) {
+            (void)name; (void)value;
+            if (window) windows++; else scalars++;
+        });
+    });
+    TEST_ASSERT_EQUAL(0, allocations);
+    TEST_ASSERT_EQUAL(17, scalars);
+    TEST_ASSERT_EQUAL(11, windows);
+}
+
+void test_set_data_moves_windows(void) {
+    testSensor->begin();
+    WCSData data;
+    data.current = 3.0f;
+    data.max_current_windows["1s"] = 1.0f;
+    data.max_current_windows["10s"] = 2.0f;
+
+    size_t allocations = allocationsDuring([&] { testSensor->setData(std::move(data)); });
+    TEST_ASSERT_EQUAL(0, allocations);
+    TEST_ASSERT_EQUAL(2, testSensor->getData().max_current_windows.size());
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, testSensor->getCurrent());
+}
+
+void test_hot_sample_leads_the_struct(void) {
+    WCSData data;
+    const WCSSample& sample = data;
+    TEST_ASSERT_EQUAL_PTR(&data, &sample);
+    TEST_ASSERT_EQUAL(32, sizeof(WCSSample));
+    TEST_ASSERT_EQUAL(0, (uintptr_t)&data % 32);
+
+    testSensor->begin();
+    testSensor->update();
+    TEST_ASSERT_EQUAL_FLOAT(testSensor->getData().current, testSensor->getSample().current);
+}
+
+void test_steady_state_update_does_not_allocate(void) {
+    testSensor->begin();
+    testSensor->update();
+
+    // Window rings are sized at begin() and map entries are overwritten in place
+    size_t allocations = allocationsDuring([&] {
+        for (int i = 0; i < 100; i++) testSensor->update();
+    });
+    TEST_ASSERT_EQUAL(0, allocations);
+    TEST_ASSERT_EQUAL(11, testSensor->getData().max_current_windows.size());
+}
+
+#endif
+
 // ============================================================================
 // UPDATE MECHANISM TESTS
 // ============================================================================
@@ -377,6 +640,31 @@ void test_windowed_maximum_calculation(void) {
     TEST_ASSERT_FLOAT_WITHIN(0.01f, 8.0f, data.max_current_windows["1s"]);
 }
 
+void test_window_set_is_configurable(void) {
+    std::vector<unsigned long> parsed;
+    TEST_ASSERT_TRUE(overseer::device::stats::parseWindowList("60, 1,10,0,10", parsed));
+    TEST_ASSERT_EQUAL(3, parsed.size());
+    TEST_ASSERT_FALSE(overseer::device::stats::parseWindowList("", parsed));
+    TEST_ASSERT_EQUAL(3, parsed.size());        // left untouched on an empty list
+
+    TEST_ASSERT_TRUE(testSensor->setWindows({60, 1, 10, 10}));
+    TEST_ASSERT_EQUAL(3, testSensor->getWindows().size());
+    TEST_ASSERT_EQUAL(1, testSensor->getWindows().front());
+    TEST_ASSERT_EQUAL(3, testSensor->getData().max_current_windows.size());
+    TEST_ASSERT_TRUE(testSensor->getData().max_current_windows.count("60s") > 0);
+    TEST_ASSERT_FALSE(testSensor->setWindows({}));
+
+    // Values, not just keys: every configured window reports the sample
+    testSensor->begin();
+    mockAdcValue = 2300;
+    testSensor->update();
+    const WCSData& data = testSensor->getData();
+    TEST_ASSERT_TRUE(data.current_smooth > 1.0f);
+    for (const char* label : {"1s", "10s", "60s"}) {
+        TEST_ASSERT_FLOAT_WITHIN(0.001f, data.current_smooth, data.max_current_windows.at(String(label)));
+    }
+}
+
 // ============================================================================
 // INTEGRATION TESTS
 // ============================================================================
@@ -452,6 +740,541 @@ void test_update_performance(void) {
     TEST_ASSERT_LESS_THAN_UINT32(1000, avgTime);
 }
 
+// ============================================================================
+// FIXED-POINT PIPELINE TESTS
+// ============================================================================
+
+// Stated tolerance of the Q16 path against the float path
+static const float FIXED_CURRENT_TOLERANCE_A = 0.001f;
+static const float FIXED_VOLTAGE_TOLERANCE_V = 0.00001f;
+
+static fixed::WCSFixedScale defaultFixedScale() {
+    fixed::WCSFixedScale scale;
+    scale.configure(3.3f, 12, 66.0f, 1.65f, 0.0f, 0.1f, 0.3f);
+    return scale;
+}
+
+void test_fixed_point_conversion_equivalence(void) {
+    testSensor->begin();
+    fixed::WCSFixedScale scale = defaultFixedScale();
+
+    for (int raw = 0; raw <= 4095; raw++) {
+        mockAdcValue = raw;
+        float expectedVoltage = testSensor->readRawVoltage();
+        float expectedCurrent = testSensor->readCurrent();
+
+        int32_t uv = scale.countsToMicrovolts(raw);
+        TEST_ASSERT_FLOAT_WITHIN(FIXED_VOLTAGE_TOLERANCE_V, expectedVoltage, uv * 1.0e-6f);
+        TEST_ASSERT_FLOAT_WITHIN(FIXED_CURRENT_TOLERANCE_A, expectedCurrent,
+                                 fixed::fromQ16(scale.microvoltsToCurrent(uv)));
+    }
+}
+
+void test_fixed_point_update_matches_float(void) {
+    WCS1800 floatSensor(34);
+    WCS1800 fixedSensor(34);
+    floatSensor.begin();
+    fixedSensor.begin();
+    fixedSensor.setFixedPointEnabled(true);
+    TEST_ASSERT_TRUE(fixedSensor.isFixedPointEnabled());
+
+    const int sequence[] = {2048, 2060, 2100, 2129, 2129, 2200, 2150, 2048, 1967, 1900, 2000, 2048};
+    for (int raw : sequence) {
+        mockAdcValue = raw;
+        floatSensor.update();
+        fixedSensor.update();
+
+        WCSData f = floatSensor.getData();
+        WCSData q = fixedSensor.getData();
+        TEST_ASSERT_FLOAT_WITHIN(FIXED_VOLTAGE_TOLERANCE_V, f.voltage, q.voltage);
+        TEST_ASSERT_FLOAT_WITHIN(FIXED_CURRENT_TOLERANCE_A, f.current, q.current);
+        TEST_ASSERT_FLOAT_WITHIN(FIXED_CURRENT_TOLERANCE_A, f.current_smooth, q.current_smooth);
+    }
+}
+
+void test_fixed_point_rescales_on_config_change(void) {
+    testSensor->begin();
+    testSensor->setFixedPointEnabled(true);
+    testSensor->setSensitivity(100.0f);
+    testSensor->setCalibrationOffset(0.25f);
+
+    mockAdcValue = 2300;
+    float expected = testSensor->readCurrent();
+    testSensor->update();
+
+    TEST_ASSERT_FLOAT_WITHIN(FIXED_CURRENT_TOLERANCE_A, expected, testSensor->getData().current);
+}
+
+// ============================================================================
+// ADC LINEARIZATION TESTS
+// ============================================================================
+
+// ESP32-like characteristic: offset at the bottom, compression near the top rail
+static int32_t nonlinearAdcMicrovolts(int32_t raw) {
+    float x = raw / 4095.0f;
+    float volts = 0.075f + 3.0f * x - 0.35f * x * x * x;
+    return (int32_t)(volts * 1.0e6f);
+}
+
+void test_linearizer_identity_matches_linear_conversion(void) {
+    AdcLinearizer lut;
+    lut.buildLinear(12, 3.3f);
+    TEST_ASSERT_TRUE(lut.isValid());
+
+    for (int raw = 0; raw <= 4095; raw++) {
+        float expected = (raw * 3.3f) / 4095.0f;
+        TEST_ASSERT_FLOAT_WITHIN(0.00001f, expected, lut.toMicrovolts(raw) * 1.0e-6f);
+    }
+}
+
+void test_linearizer_tracks_nonlinear_curve(void) {
+    AdcLinearizer lut;
+    lut.build(12, nonlinearAdcMicrovolts);
+
+    int32_t worst = 0;
+    for (int raw = 0; raw <= 4095; raw++) {
+        int32_t err = lut.toMicrovolts(raw) - nonlinearAdcMicrovolts(raw);
+        if (err < 0) err = -err;
+        if (err > worst) worst = err;
+    }
+    // 33 breakpoints keep interpolation error well under one LSB (~800 uV)
+    TEST_ASSERT_LESS_THAN_INT(500, worst);
+}
+
+void test_linearizer_serialize_roundtrip(void) {
+    AdcLinearizer lut;
+    lut.build(12, nonlinearAdcMicrovolts);
+
+    AdcLinearizer restored;
+    TEST_ASSERT_TRUE(restored.deserialize(lut.serialize().c_str()));
+    for (uint8_t i = 0; i < AdcLinearizer::POINTS; i++) {
+        TEST_ASSERT_EQUAL_INT32(lut.getPoint(i), restored.getPoint(i));
+    }
+    TEST_ASSERT_EQUAL_INT32(lut.toMicrovolts(1234), restored.toMicrovolts(1234));
+}
+
+void test_linearizer_rejects_malformed_table(void) {
+    AdcLinearizer lut;
+    TEST_ASSERT_FALSE(lut.deserialize(""));
+    TEST_ASSERT_FALSE(lut.deserialize("12:1,2,3"));
+    TEST_ASSERT_FALSE(lut.deserialize("garbage"));
+    TEST_ASSERT_FALSE(lut.isValid());
+}
+
+void test_linearizer_width_must_match_adc(void) {
+    AdcLinearizer lut;
+    lut.buildLinear(10, 3.3f);
+    TEST_ASSERT_EQUAL(10, lut.getBits());
+    // 12-bit counts on a 10-bit table clamp to the last segment instead of reading past it
+    TEST_ASSERT_EQUAL_INT32(lut.toMicrovolts(1023), lut.toMicrovolts(4095));
+
+    AdcLinearizer restored;
+    TEST_ASSERT_TRUE(restored.deserialize(lut.serialize().c_str()));
+    TEST_ASSERT_EQUAL(10, restored.getBits());
+
+    testSensor->begin();
+    TEST_ASSERT_FALSE(testSensor->setAdcLinearization(lut));
+    TEST_ASSERT_FALSE(testSensor->getAdcLinearization().isValid());
+}
+
+void test_update_applies_linearization(void) {
+    testSensor->begin();
+    AdcLinearizer lut;
+    lut.build(12, nonlinearAdcMicrovolts);
+    testSensor->setAdcLinearization(lut);
+
+    mockAdcValue = 4000;
+    float expected = nonlinearAdcMicrovolts(4000) * 1.0e-6f;
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, expected, testSensor->readRawVoltage());
+
+    testSensor->setFixedPointEnabled(true);
+    testSensor->update();
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, expected, testSensor->getData().voltage);
+}
+
+// ============================================================================
+// ENERGY METERING TESTS
+// ============================================================================
+
+void test_energy_constant_load(void) {
+    EnergyMeter meter;
+    for (unsigned long t = 0; t <= 3600000; t += 100) {
+        meter.addSample(10.0f, 48.0f, t);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 10.0f, meter.getChargeAh());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 480.0f, meter.getEnergyWh());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 480.0f, meter.getPower());
+}
+
+void test_energy_trapezoid_is_exact_on_ramp(void) {
+    EnergyMeter meter;
+    meter.addSample(0.0f, NAN, 0);
+    meter.addSample(36.0f, NAN, 1000);     // 18 A mean over 1 s = 5 mAh
+    TEST_ASSERT_EQUAL_INT64(5, meter.getChargeAccumulator().whole);
+    TEST_ASSERT_EQUAL_INT64(0, meter.getChargeAccumulator().frac);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, meter.getEnergyWh());     // no voltage, charge only
+}
+
+void test_energy_does_not_drift(void) {
+    // 10 h of 1 ms samples at an awkward current: integer sums stay exact
+    EnergyMeter meter;
+    const float amps = 1.234567f;
+    const int64_t ua = (int64_t)lroundf(amps * 1.0e6f);
+    const int64_t steps = 36000000;
+    for (int64_t i = 0; i <= steps; i++) {
+        meter.addSample(amps, NAN, (unsigned long)i);
+    }
+    const int64_t expected = 2 * ua * steps;
+    const FixedAccumulator& acc = meter.getChargeAccumulator();
+    TEST_ASSERT_EQUAL_INT64(expected / EnergyMeter::CHARGE_UNIT, acc.whole);
+    TEST_ASSERT_EQUAL_INT64(expected % EnergyMeter::CHARGE_UNIT, acc.frac);
+}
+
+void test_energy_gap_is_not_bridged(void) {
+    EnergyMeter meter;
+    meter.setMaxGap(1000);
+    meter.addSample(3.6f, NAN, 0);
+    meter.addSample(3.6f, NAN, 1000);      // 1 mAh
+    meter.addSample(3.6f, NAN, 61000);     // 60 s gap: skipped
+    meter.addSample(3.6f, NAN, 62000);     // 1 mAh
+    meter.breakSegment();
+    meter.addSample(3.6f, NAN, 62500);     // new segment after an invalid sample
+    TEST_ASSERT_FLOAT_WITHIN(0.000001f, 0.002f, meter.getChargeAh());
+}
+
+void test_energy_windows_roll_over(void) {
+    EnergyMeter meter;
+    meter.setWindows({60});
+    for (unsigned long t = 0; t < 60000; t += 1000) meter.addSample(3.6f, 10.0f, t);
+    TEST_ASSERT_FALSE(meter.getWindow(0).complete);
+    TEST_ASSERT_FLOAT_WITHIN(0.00001f, 0.059f, meter.getWindowChargeAh(0));
+
+    meter.addSample(3.6f, 10.0f, 60000);
+    TEST_ASSERT_TRUE(meter.takeWindowRollover());
+    TEST_ASSERT_FALSE(meter.takeWindowRollover());
+    TEST_ASSERT_TRUE(meter.getWindow(0).complete);
+    TEST_ASSERT_FLOAT_WITHIN(0.00001f, 0.059f, meter.getWindow(0).last_ah);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.59f, meter.getWindow(0).last_wh);
+    TEST_ASSERT_FLOAT_WITHIN(0.00001f, 0.001f, meter.getWindowChargeAh(0));
+    TEST_ASSERT_FLOAT_WITHIN(0.00001f, 0.06f, meter.getChargeAh());
+}
+
+void test_energy_serialize_roundtrip(void) {
+    EnergyMeter meter;
+    for (unsigned long t = 0; t <= 5000; t += 7) meter.addSample(-12.5f, 24.0f, t);
+
+    EnergyMeter restored;
+    TEST_ASSERT_TRUE(restored.deserialize(meter.serialize().c_str()));
+    TEST_ASSERT_EQUAL_INT64(meter.getChargeAccumulator().whole, restored.getChargeAccumulator().whole);
+    TEST_ASSERT_EQUAL_INT64(meter.getChargeAccumulator().frac, restored.getChargeAccumulator().frac);
+    TEST_ASSERT_EQUAL_INT64(meter.getEnergyAccumulator().frac, restored.getEnergyAccumulator().frac);
+    TEST_ASSERT_TRUE(restored.getChargeAh() < 0.0f);
+
+    TEST_ASSERT_FALSE(restored.deserialize(""));
+    TEST_ASSERT_FALSE(restored.deserialize("1,2,3"));
+    TEST_ASSERT_FALSE(restored.deserialize("1,99999999999,0,0"));
+}
+
+void test_energy_persist_interval(void) {
+    EnergyMeter meter;
+    meter.setPersistInterval(300000);
+    TEST_ASSERT_FALSE(meter.isPersistDue(0));
+    meter.addSample(1.0f, NAN, 1000);
+    TEST_ASSERT_FALSE(meter.isPersistDue(300999));
+    TEST_ASSERT_TRUE(meter.isPersistDue(301000));
+    meter.markPersisted(301000);
+    TEST_ASSERT_FALSE(meter.isPersistDue(302000));
+    meter.setPersistInterval(0);
+    TEST_ASSERT_FALSE(meter.isPersistDue(10000000));
+}
+
+// Stands in for ads::MPLEX: anything with getChannelScaled(int)
+struct FakeVoltageMux {
+    float volts[4] = {0};
+    int reads = 0;
+    float getChannelScaled(int channel) { reads++; return volts[channel]; }
+};
+
+void test_bus_voltage_from_mux_channel(void) {
+    FakeVoltageMux mux;
+    mux.volts[2] = 12.6f;
+    testSensor->begin();
+    TEST_ASSERT_TRUE(isnan(testSensor->readBusVoltage()));
+
+    testSensor->setBusVoltageSource(mux, 2);
+    TEST_ASSERT_EQUAL_FLOAT(12.6f, testSensor->readBusVoltage());
+    mockAdcValue = 2048 + 82;        // ~1 A
+    testSensor->update();
+    TEST_ASSERT_EQUAL_FLOAT(12.6f, testSensor->getData().bus_voltage);
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 12.6f, testSensor->getData().power);
+
+    testSensor->setBusVoltage(5.0f);
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, testSensor->readBusVoltage());
+}
+
+void test_bus_voltage_source_read_at_cadence(void) {
+    FakeVoltageMux mux;
+    mux.volts[0] = 48.0f;
+    testSensor->begin();
+    testSensor->setBusVoltageSource(mux, 0, 1000);
+
+    // millis() is frozen natively: every update falls inside one interval
+    for (int i = 0; i < 20; i++) testSensor->update();
+    TEST_ASSERT_EQUAL(1, mux.reads);
+    TEST_ASSERT_EQUAL_FLOAT(48.0f, testSensor->getData().bus_voltage);
+    TEST_ASSERT_FALSE(testSensor->isEnergySavePending());
+    TEST_ASSERT_FALSE(testSensor->flushEnergy());
+}
+
+// ============================================================================
+// AC ANALYSIS TESTS
+// ============================================================================
+
+static ACResult analyzeWave(ACAnalyzer& ac, float (*wave)(float t), int samples) {
+    const float dt = 1.0f / ac.getConfig().sample_rate_hz;
+    for (int i = 0; i < samples; i++) ac.addSample(wave(i * dt));
+    return ac.endBlock();
+}
+
+static float sine50(float t) { return 10.0f * sinf(2.0f * (float)M_PI * 50.0f * t); }
+static float sine60Offset(float t) { return 2.0f + 10.0f * sinf(2.0f * (float)M_PI * 60.0f * t + 0.3f); }
+static float square50(float t) { return fmodf(t * 50.0f, 1.0f) < 0.5f ? 4.0f : -4.0f; }
+static float steadyDc(float t) { (void)t; return 3.0f; }
+
+void test_ac_sine_rms_peak_crest_frequency(void) {
+    ACAnalyzer ac;
+    ac.configure(ACConfig());
+    ACResult r = analyzeWave(ac, sine50, 400);
+
+    TEST_ASSERT_GREATER_OR_EQUAL(3, r.cycles);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 7.071f, r.rms);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 10.0f, r.peak);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 1.414f, r.crest_factor);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 50.0f, r.frequency);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 0.0f, r.dc);
+}
+
+void test_ac_fractional_period_with_dc_offset(void) {
+    // 4 kHz / 60 Hz = 66.67 samples per cycle; crossings track the DC line
+    ACAnalyzer ac;
+    ac.configure(ACConfig());
+    analyzeWave(ac, sine60Offset, 400);     // first block settles the DC reference
+    ACResult r = analyzeWave(ac, sine60Offset, 400);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 60.0f, r.frequency);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 2.0f, r.dc);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, sqrtf(50.0f + 4.0f), r.rms);
+}
+
+void test_ac_square_wave_crest_factor(void) {
+    ACAnalyzer ac;
+    ac.configure(ACConfig());
+    ACResult r = analyzeWave(ac, square50, 400);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 4.0f, r.rms);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 1.0f, r.crest_factor);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 50.0f, r.frequency);
+}
+
+void test_ac_dc_input_reports_no_cycles(void) {
+    ACAnalyzer ac;
+    ac.configure(ACConfig());
+    ACResult r = analyzeWave(ac, steadyDc, 400);
+    TEST_ASSERT_EQUAL(0, r.cycles);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, r.frequency);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 3.0f, r.rms);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, r.crest_factor);
+}
+
+void test_ac_cycles_span_short_blocks(void) {
+    // Blocks shorter than one cycle: cycles complete across block boundaries
+    ACAnalyzer ac;
+    ACConfig cfg;
+    cfg.block_samples = 50;
+    ac.configure(cfg);
+    const float dt = 1.0f / cfg.sample_rate_hz;
+    int total_cycles = 0;
+    for (int block = 0; block < 20; block++) {
+        for (int i = 0; i < 50; i++) ac.addSample(sine50((block * 50 + i) * dt));
+        ACResult r = ac.endBlock();
+        if (r.cycles > 0) TEST_ASSERT_FLOAT_WITHIN(0.1f, 50.0f, r.frequency);
+        total_cycles += r.cycles;
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL(10, total_cycles);
+}
+
+void test_ac_mode_publishes_to_wcsdata(void) {
+    testSensor->begin();
+    testSensor->setMeasurementMode(MeasurementMode::AC);
+
+    // 5 A peak, 50 Hz, as raw counts around the 1.65 V zero point
+    const ACConfig& cfg = testSensor->getACConfig();
+    std::vector<int> block(cfg.block_samples);
+    for (size_t i = 0; i < block.size(); i++) {
+        float amps = 5.0f * sinf(2.0f * (float)M_PI * 50.0f * i / cfg.sample_rate_hz);
+        block[i] = (int)lroundf((1.65f + amps * 0.066f) / 3.3f * 4095.0f);
+    }
+    block[10] = -1;     // one bad read is skipped, not fatal
+    testSensor->ingestACBlock(block.data(), block.size(), 100);
+
+    const WCSData& data = testSensor->getData();
+    TEST_ASSERT_TRUE(data.ac_mode);
+    TEST_ASSERT_TRUE(data.valid_reading);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 3.536f, data.ac_rms);
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 50.0f, data.ac_frequency);
+    TEST_ASSERT_EQUAL_FLOAT(data.ac_rms, data.current);
+    TEST_ASSERT_EQUAL_UINT64(1, data.bad_adc_read);
+}
+
+void test_ac_mode_steps_zero_calibration(void) {
+    testSensor->begin();
+    testSensor->setMeasurementMode(MeasurementMode::AC);
+    calibration::ZeroCalibrationConfig cfg;
+    cfg.sample_interval_ms = 0;
+    testSensor->setZeroCalibrationConfig(cfg);
+    testSensor->startZeroCalibration();
+
+    // micros() is frozen natively: update() takes the one due slot and returns
+    // instead of pacing out a whole block
+    mockAdcValue = 2100;
+    testSensor->update();
+
+    std::vector<int> block(40, 2100);
+    int blocks = 0;
+    while (testSensor->isCalibrating() && blocks < 100) {
+        testSensor->ingestACBlock(block.data(), block.size(), 100 + blocks);
+        blocks++;
+    }
+
+    TEST_ASSERT_TRUE(testSensor->getCalibrationState() == calibration::CalibrationState::DONE);
+    TEST_ASSERT_EQUAL(cfg.min_samples - 1, blocks);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, (2100 * 3.3f) / 4095.0f, testSensor->getZeroCurrentVoltage());
+}
+
+// ============================================================================
+// QUANTILE TESTS
+// ============================================================================
+
+void test_quantiles_publish_per_tier(void) {
+    testSensor->begin();
+    TEST_ASSERT_FALSE(testSensor->isQuantilesEnabled());
+    testSensor->enableQuantiles();
+    testSensor->setMeasurementMode(MeasurementMode::AC);
+
+    const ACConfig& cfg = testSensor->getACConfig();
+    std::vector<int> block(cfg.block_samples);
+    for (size_t i = 0; i < block.size(); i++) {
+        float amps = 5.0f * sinf(2.0f * (float)M_PI * 50.0f * i / cfg.sample_rate_hz);
+        block[i] = (int)lroundf((1.65f + amps * 0.066f) / 3.3f * 4095.0f);
+    }
+    testSensor->ingestACBlock(block.data(), block.size(), 100);
+
+    const WCSData& data = testSensor->getData();
+    TEST_ASSERT_EQUAL(3, data.current_quantiles.size());
+    TEST_ASSERT_EQUAL(1, data.current_quantiles.count("300s"));
+    const stats::QuantileSummary& q = data.current_quantiles.at("60s");
+    TEST_ASSERT_EQUAL_UINT32(1, q.count);
+    TEST_ASSERT_FLOAT_WITHIN(data.ac_rms * 0.0625f, data.ac_rms, q.p50);
+    TEST_ASSERT_FLOAT_WITHIN(data.ac_rms * 0.0625f, data.ac_rms, q.p99);
+}
+
+// ============================================================================
+// TRIGGER CAPTURE TESTS
+// ============================================================================
+
+void test_trigger_capture_freezes_ac_spike(void) {
+    testSensor->begin();
+    capture::TriggerConfig trigger;
+    trigger.type = capture::TriggerType::MAGNITUDE;
+    trigger.threshold = 2.0f;
+    TEST_ASSERT_TRUE(testSensor->enableCapture(trigger, 16, 16, 1));
+    testSensor->setMeasurementMode(MeasurementMode::AC);
+
+    const ACConfig& cfg = testSensor->getACConfig();
+    std::vector<int> block(cfg.block_samples, 2048);
+    block[200] = (int)lroundf((1.65f - 5.0f * 0.066f) / 3.3f * 4095.0f);     // -5 A spike
+    testSensor->ingestACBlock(block.data(), block.size(), 1000);
+
+    capture::TriggerCapture& cap = testSensor->getCapture();
+    TEST_ASSERT_EQUAL(1, cap.getCaptureCount());
+    bool drained = cap.drain([&](const capture::Capture& c) {
+        TEST_ASSERT_EQUAL(16, c.pre_count);
+        TEST_ASSERT_EQUAL(33, c.count);
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, -5.0f, c.trigger_value);
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, c.samples[0].value);
+        TEST_ASSERT_EQUAL(1000000UL / cfg.sample_rate_hz, c.samples[1].t_us - c.samples[0].t_us);
+    });
+    TEST_ASSERT_TRUE(drained);
+    TEST_ASSERT_FALSE(cap.drain([](const capture::Capture&) {}));
+}
+
+#ifndef ARDUINO
+#include <chrono>
+
+void test_fixed_point_benchmark(void) {
+    fixed::WCSFixedScale scale = defaultFixedScale();
+    const int iterations = 1000000;
+    const float vcc = 3.3f, zero = 1.65f, sens = 66.0f, alpha = 0.1f;
+    const int adcBits = 12;
+    volatile float floatSink = 0.0f;
+    volatile int32_t fixedSink = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    float smooth = 0.0f;
+    for (int i = 0; i < iterations; i++) {
+        int raw = i & 4095;
+        float voltage = (raw * vcc) / ((1 << adcBits) - 1);
+        float current = ((voltage - zero) * 1000.0f) / sens;
+        smooth = alpha * current + (1.0f - alpha) * smooth;
+    }
+    floatSink = smooth;
+    auto t1 = std::chrono::steady_clock::now();
+    fixed::q16_t smoothQ = 0;
+    for (int i = 0; i < iterations; i++) {
+        smoothQ = scale.smooth(smoothQ, scale.countsToCurrent(i & 4095));
+    }
+    fixedSink = smoothQ;
+    auto t2 = std::chrono::steady_clock::now();
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "float: %.2f ns/sample, Q16: %.2f ns/sample",
+             std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations,
+             std::chrono::duration<double, std::nano>(t2 - t1).count() / iterations);
+    TEST_MESSAGE(msg);
+    (void)floatSink;
+    (void)fixedSink;
+}
+
+void test_data_layout_benchmark(void) {
+    testSensor->begin();
+    testSensor->update();
+    const int iterations = 100000;
+    volatile float sink = 0.0f;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        WCSData copy = testSensor->getData();
+        sink = sink + copy.current;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        WCSSample copy = testSensor->getSample();
+        sink = sink + copy.current;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; i++) testSensor->update();
+    auto t3 = std::chrono::steady_clock::now();
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "sizeof WCSData %u / WCSSample %u; copy %.1f ns / %.1f ns; update %.1f ns",
+             (unsigned)sizeof(WCSData), (unsigned)sizeof(WCSSample),
+             std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations,
+             std::chrono::duration<double, std::nano>(t2 - t1).count() / iterations,
+             std::chrono::duration<double, std::nano>(t3 - t2).count() / 1000);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(t2 - t1 < t1 - t0);
+}
+#endif
+
 // ============================================================================
 // MAIN TEST RUNNER
 // ============================================================================
@@ -484,14 +1307,29 @@ void runAllTests(void) {
     // Validation tests
     RUN_TEST(test_valid_reading_within_range);
     RUN_TEST(test_invalid_reading_out_of_range);
+    RUN_TEST(test_valid_range_is_configurable);
+    RUN_TEST(test_alarm_raised_inline_on_update);
+    RUN_TEST(test_invalid_readings_skip_alarms);
     
     // Calibration tests
     RUN_TEST(test_zero_point_calibration);
+    RUN_TEST(test_zero_calibration_stops_early_on_clean_signal);
+    RUN_TEST(test_zero_calibration_rejects_noisy_signal);
+    RUN_TEST(test_zero_calibration_accepts_adc_noise_at_max_samples);
+    RUN_TEST(test_nonblocking_zero_calibration_via_update);
+    RUN_TEST(test_explicit_zero_point_survives_begin);
     RUN_TEST(test_sensitivity_configuration);
     
     // Data structure tests
     RUN_TEST(test_data_structure_initialization);
     RUN_TEST(test_data_injection);
+#ifndef ARDUINO
+    RUN_TEST(test_get_data_is_copy_free);
+    RUN_TEST(test_visit_data_is_copy_free);
+    RUN_TEST(test_set_data_moves_windows);
+    RUN_TEST(test_hot_sample_leads_the_struct);
+    RUN_TEST(test_steady_state_update_does_not_allocate);
+#endif
     
     // Update mechanism tests
     RUN_TEST(test_update_increments_sample_count);
@@ -505,6 +1343,7 @@ void runAllTests(void) {
     
     // Windowed maximum tests
     RUN_TEST(test_windowed_maximum_calculation);
+    RUN_TEST(test_window_set_is_configurable);
     
     // Integration tests
     RUN_TEST(test_full_sensor_lifecycle);
@@ -517,6 +1356,49 @@ void runAllTests(void) {
     // Performance tests
     RUN_TEST(test_update_performance);
     
+    // Fixed-point pipeline tests
+    RUN_TEST(test_fixed_point_conversion_equivalence);
+    RUN_TEST(test_fixed_point_update_matches_float);
+    RUN_TEST(test_fixed_point_rescales_on_config_change);
+#ifndef ARDUINO
+    RUN_TEST(test_fixed_point_benchmark);
+    RUN_TEST(test_data_layout_benchmark);
+#endif
+    
+    // ADC linearization tests
+    RUN_TEST(test_linearizer_identity_matches_linear_conversion);
+    RUN_TEST(test_linearizer_tracks_nonlinear_curve);
+    RUN_TEST(test_linearizer_serialize_roundtrip);
+    RUN_TEST(test_linearizer_rejects_malformed_table);
+    RUN_TEST(test_linearizer_width_must_match_adc);
+    RUN_TEST(test_update_applies_linearization);
+    
+    // Energy metering tests
+    RUN_TEST(test_energy_constant_load);
+    RUN_TEST(test_energy_trapezoid_is_exact_on_ramp);
+    RUN_TEST(test_energy_does_not_drift);
+    RUN_TEST(test_energy_gap_is_not_bridged);
+    RUN_TEST(test_energy_windows_roll_over);
+    RUN_TEST(test_energy_serialize_roundtrip);
+    RUN_TEST(test_energy_persist_interval);
+    RUN_TEST(test_bus_voltage_from_mux_channel);
+    RUN_TEST(test_bus_voltage_source_read_at_cadence);
+    
+    // AC analysis tests
+    RUN_TEST(test_ac_sine_rms_peak_crest_frequency);
+    RUN_TEST(test_ac_fractional_period_with_dc_offset);
+    RUN_TEST(test_ac_square_wave_crest_factor);
+    RUN_TEST(test_ac_dc_input_reports_no_cycles);
+    RUN_TEST(test_ac_cycles_span_short_blocks);
+    RUN_TEST(test_ac_mode_publishes_to_wcsdata);
+    RUN_TEST(test_ac_mode_steps_zero_calibration);
+
+    // Quantile tests
+    RUN_TEST(test_quantiles_publish_per_tier);
+
+    // Trigger capture tests
+    RUN_TEST(test_trigger_capture_freezes_ac_spike);
+    
     UNITY_END();
 }
 
@@ -0,0 +1,263 @@
+// test/test_WCS1800Group.cpp
+#include <unity.h>
+#include "device/energy/WCS1800/WCS1800Group.h"
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+using namespace overseer::device::energy;
+using namespace overseer::device::stats;
+
+// Global test objects
+WCS1800Group* testGroup = nullptr;
+
+// Mock ADC: one value per pin
+static int mockPinValue[64];
+static bool mockAdcFail = false;
+
+#ifndef ARDUINO
+int analogRead(uint8_t pin) {
+    if (mockAdcFail) return -1;
+    return mockPinValue[pin % 64];
+}
+#endif
+
+// Counts for a given current on a 66 mV/A sensor centred at 1.65 V, 12-bit / 3.3 V
+static int countsFor(float amps) {
+    return (int)((1.65f + amps * 0.066f) / 3.3f * 4095.0f + 0.5f);
+}
+
+static const uint8_t TEST_PINS[8] = {32, 33, 34, 35, 36, 39, 25, 26};
+
+void setUp(void) {
+    for (int i = 0; i < 64; i++) mockPinValue[i] = countsFor(0.0f);
+    mockAdcFail = false;
+    testGroup = new WCS1800Group(TEST_PINS, 8);
+}
+
+void tearDown(void) {
+    delete testGroup;
+    testGroup = nullptr;
+}
+
+// ============================================================================
+// SWEEP TESTS
+// ============================================================================
+
+void test_group_registers_channels(void) {
+    TEST_ASSERT_EQUAL(8, testGroup->getChannelCount());
+    TEST_ASSERT_EQUAL(35, testGroup->getPin(3));
+    TEST_ASSERT_TRUE(testGroup->begin());
+}
+
+void test_channel_limit(void) {
+    WCS1800Group group;
+    for (int i = 0; i < WCS1800Group::MAX_CHANNELS; i++) TEST_ASSERT_EQUAL(i, group.addChannel(i));
+    TEST_ASSERT_EQUAL(-1, group.addChannel(60));
+}
+
+void test_sweep_converts_each_channel(void) {
+    testGroup->begin();
+    for (uint8_t ch = 0; ch < 8; ch++) mockPinValue[TEST_PINS[ch]] = countsFor(ch * 2.0f - 7.0f);
+    testGroup->update();
+
+    for (uint8_t ch = 0; ch < 8; ch++) {
+        TEST_ASSERT_TRUE(testGroup->isReadingValid(ch));
+        TEST_ASSERT_FLOAT_WITHIN(0.02f, ch * 2.0f - 7.0f, testGroup->getCurrent(ch));
+    }
+}
+
+void test_per_channel_sensitivity_and_offset(void) {
+    testGroup->begin();
+    testGroup->setSensitivity(1, 33.0f);        // same counts, twice the current
+    testGroup->setCalibrationOffset(2, 0.5f);
+    mockPinValue[TEST_PINS[1]] = countsFor(5.0f);
+    mockPinValue[TEST_PINS[2]] = countsFor(5.0f);
+    testGroup->update();
+
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 10.0f, testGroup->getCurrent(1));
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 5.5f, testGroup->getCurrent(2));
+}
+
+void test_out_of_range_channel_is_invalid_and_not_smoothed(void) {
+    testGroup->begin();
+    testGroup->setValidRange(-10.0f, 10.0f);
+    mockPinValue[TEST_PINS[4]] = countsFor(20.0f);
+    testGroup->update();
+
+    TEST_ASSERT_FALSE(testGroup->isReadingValid(4));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, testGroup->getCurrentSmooth(4));
+    TEST_ASSERT_TRUE(testGroup->isReadingValid(5));
+}
+
+void test_smoothing_and_spike_rejection(void) {
+    testGroup->begin();
+    testGroup->setSmoothing(0.5f, 100.0f);
+    mockPinValue[TEST_PINS[0]] = countsFor(4.0f);
+    int now = 0;
+    int samples[8];
+    for (int i = 0; i < 8; i++) samples[i] = mockPinValue[TEST_PINS[i]];
+    testGroup->ingest(samples, now += 10);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 2.0f, testGroup->getCurrentSmooth(0));
+
+    testGroup->setSmoothing(0.5f, 0.5f);        // large step now counts as a spike
+    testGroup->ingest(samples, now += 10);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 4.0f, testGroup->getCurrentSmooth(0));
+}
+
+void test_zero_calibration_centres_all_channels(void) {
+    for (uint8_t ch = 0; ch < 8; ch++) mockPinValue[TEST_PINS[ch]] = 2000 + ch * 10;
+    testGroup->begin();
+    TEST_ASSERT_TRUE(testGroup->calibrateZeroPoints(10));
+    testGroup->update();
+    for (uint8_t ch = 0; ch < 8; ch++) {
+        TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, testGroup->getCurrent(ch));
+    }
+}
+
+// ============================================================================
+// WINDOW ENGINE TESTS
+// ============================================================================
+
+void test_window_max_tracks_and_expires(void) {
+    WindowMax engine;
+    engine.configure({1, 10}, 2);
+    TEST_ASSERT_EQUAL_UINT32(100, engine.getTickMs());
+
+    engine.add(0, -5.0f);
+    engine.advance(0);
+    engine.advance(100);
+    engine.add(1, 2.0f);
+    engine.advance(200);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 5.0f, engine.get(0, 0));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 2.0f, engine.get(1, 0));
+
+    // 1 s window forgets the spike, 10 s window still holds it
+    for (unsigned long t = 300; t <= 1500; t += 100) engine.advance(t);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, engine.get(0, 0));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 5.0f, engine.get(0, 1));
+
+    for (unsigned long t = 1600; t <= 12000; t += 100) engine.advance(t);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, engine.get(0, 1));
+}
+
+// The bucketed engine is approximate: a "1s" window holds a sample for 0.9-1.0 s
+void test_window_max_coverage_bounds(void) {
+    WindowMax engine;
+    engine.configure({1}, 1);
+    engine.advance(0);
+
+    // Spike at the start of a bucket: still reported 0.9 s later, gone after 1.0 s + one tick
+    engine.add(0, 5.0f);
+    for (unsigned long t = 100; t <= 900; t += 100) engine.advance(t);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 5.0f, engine.get(0, 0));
+    engine.advance(1000);
+    engine.advance(1100);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, engine.get(0, 0));
+
+    // Spike pending at a fold stays in the bucket it arrived in, not the next one:
+    // added at 1199, folded at 1200, dropped when that bucket comes round at 2100
+    engine.add(0, 3.0f);
+    for (unsigned long t = 1200; t <= 2000; t += 100) engine.advance(t);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 3.0f, engine.get(0, 0));
+    engine.advance(2100);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, engine.get(0, 0));
+}
+
+void test_window_max_survives_long_gaps(void) {
+    WindowMax engine;
+    engine.configure({1}, 1);
+    engine.advance(0);
+    engine.add(0, 3.0f);
+    engine.advance(100);
+    engine.advance(100000);         // far more than one ring of buckets
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, engine.get(0, 0));
+}
+
+void test_group_windows_fill_wcsdata(void) {
+    testGroup->begin();
+    mockPinValue[TEST_PINS[6]] = countsFor(3.0f);
+    int samples[8];
+    for (int i = 0; i < 8; i++) samples[i] = mockPinValue[TEST_PINS[i]];
+    testGroup->setSmoothing(1.0f, 100.0f);
+    for (int t = 0; t <= 500; t += 50) testGroup->ingest(samples, t);
+
+    WCSData data;
+    testGroup->fillData(6, data);
+    TEST_ASSERT_EQUAL(11, data.max_current_windows.size());
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 3.0f, data.max_current_windows[String("1s")]);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 3.0f, testGroup->getWindowMax(6, 10));
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.0f, testGroup->getWindowMax(5, 0));
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+#ifndef ARDUINO
+static double nsPerChannel(uint8_t channels) {
+    WCS1800Group group;
+    for (uint8_t ch = 0; ch < channels; ch++) group.addChannel(ch);
+    group.begin();
+
+    int samples[WCS1800Group::MAX_CHANNELS];
+    for (uint8_t ch = 0; ch < channels; ch++) samples[ch] = countsFor(ch * 0.5f);
+    const int sweeps = 200000;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < sweeps; i++) {
+        samples[0] = countsFor((i & 15) * 0.1f);
+        group.ingest(samples, (unsigned long)i);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / ((double)sweeps * channels);
+}
+
+void test_cost_per_channel_falls_with_channel_count(void) {
+    double one = nsPerChannel(1);
+    double eight = nsPerChannel(8);
+    double sixteen = nsPerChannel(16);
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "ns/channel/sweep: 1ch %.1f, 8ch %.1f, 16ch %.1f", one, eight, sixteen);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(sixteen < one);
+}
+#endif
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void runAllTests(void) {
+    UNITY_BEGIN();
+
+    // Sweep tests
+    RUN_TEST(test_group_registers_channels);
+    RUN_TEST(test_channel_limit);
+    RUN_TEST(test_sweep_converts_each_channel);
+    RUN_TEST(test_per_channel_sensitivity_and_offset);
+    RUN_TEST(test_out_of_range_channel_is_invalid_and_not_smoothed);
+    RUN_TEST(test_smoothing_and_spike_rejection);
+    RUN_TEST(test_zero_calibration_centres_all_channels);
+
+    // Window engine tests
+    RUN_TEST(test_window_max_tracks_and_expires);
+    RUN_TEST(test_window_max_coverage_bounds);
+    RUN_TEST(test_window_max_survives_long_gaps);
+    RUN_TEST(test_group_windows_fill_wcsdata);
+
+    // Performance tests
+#ifndef ARDUINO
+    RUN_TEST(test_cost_per_channel_falls_with_channel_count);
+#endif
+
+    UNITY_END();
+}
+
+#ifndef ARDUINO
+int main() {
+    runAllTests();
+    return 0;
+}
+#endif
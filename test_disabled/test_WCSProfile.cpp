@@ -0,0 +1,189 @@
+// test/test_WCSProfile.cpp
+#include <unity.h>
+#include "arduino_compat.h"
+#include "device/energy/WCS1800/WCS1800Static.h"
+
+#include <stdio.h>
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+using namespace overseer::device::energy;
+using namespace overseer::device::energy::profile;
+
+struct ShuntProfile : WCSDefaultProfile {
+    static constexpr uint8_t pin = 34;
+    static constexpr float sensitivity_mv_per_a = 33.0f;
+    static constexpr float zero_voltage = 1.6f;
+    static constexpr float calibration_offset = 0.05f;
+    static constexpr float valid_min_current = -20.0f;
+    static constexpr float valid_max_current = 20.0f;
+    static constexpr unsigned long windows[] = {1, 60, 900};
+};
+
+typedef WCSStaticScale<WCSDefaultProfile> DefaultScale;
+typedef WCSStaticScale<ShuntProfile> ShuntScale;
+
+// Folded at compile time, not just inlined
+static_assert(DefaultScale::toCurrent(2048) > 0.0f && DefaultScale::toCurrent(2048) < 0.02f, "mid-scale is ~0 A");
+static_assert(ShuntScale::window_count == 3, "shadowed window table");
+static_assert(overseer::device::stats::StaticWindowMax<ShuntProfile>::TICK_MS == 100, "tick folded from {1, 60, 900} s");
+
+static int mockAdcValue = 2048;
+
+#ifndef ARDUINO
+int analogRead(uint8_t pin) {
+    (void)pin;
+    return mockAdcValue;
+}
+#endif
+
+void setUp(void) {
+    mockAdcValue = 2048;
+}
+void tearDown(void) {}
+
+// ============================================================================
+// CONVERSION TESTS
+// ============================================================================
+
+void test_static_matches_reference_formula(void) {
+    // The unfolded WCS1800 float formula, every count of the 12-bit range
+    for (int raw = 0; raw <= 4095; raw++) {
+        float voltage = (raw * ShuntProfile::vcc_voltage) / 4095;
+        float expected = (voltage - ShuntProfile::zero_voltage) * 1000.0f / ShuntProfile::sensitivity_mv_per_a
+                         + ShuntProfile::calibration_offset;
+        TEST_ASSERT_FLOAT_WITHIN(1.0e-4f, expected, ShuntScale::toCurrent(raw));
+        TEST_ASSERT_FLOAT_WITHIN(1.0e-4f, expected, ShuntScale::voltageToCurrent(voltage));
+    }
+}
+
+void test_runtime_scale_matches_static(void) {
+    WCSRuntimeScale runtime;
+    runtime.configure<ShuntProfile>();
+    float static_smooth = 0.0f, runtime_smooth = 0.0f;
+    for (int raw = 0; raw <= 4095; raw += 7) {
+        TEST_ASSERT_FLOAT_WITHIN(1.0e-5f, ShuntScale::toCurrent(raw), runtime.toCurrent(raw));
+        static_smooth = ShuntScale::smooth(static_smooth, ShuntScale::toCurrent(raw));
+        runtime_smooth = runtime.smooth(runtime_smooth, runtime.toCurrent(raw));
+        TEST_ASSERT_FLOAT_WITHIN(1.0e-4f, static_smooth, runtime_smooth);
+    }
+}
+
+void test_default_zero_point_is_half_vcc(void) {
+    TEST_ASSERT_FLOAT_WITHIN(1.0e-6f, 1.65f, DefaultScale::zero_voltage);
+    TEST_ASSERT_FLOAT_WITHIN(1.0e-6f, 1.6f, ShuntScale::zero_voltage);
+}
+
+// ============================================================================
+// SENSOR TESTS
+// ============================================================================
+
+void test_static_sensor_update(void) {
+    WCS1800Static<ShuntProfile> sensor;
+    TEST_ASSERT_EQUAL(34, sensor.getPin());
+    TEST_ASSERT_TRUE(sensor.begin());
+
+    mockAdcValue = 2200;
+    for (int i = 0; i < 50; i++) sensor.update();
+    TEST_ASSERT_TRUE(sensor.isReadingValid());
+    TEST_ASSERT_FLOAT_WITHIN(1.0e-5f, ShuntScale::toCurrent(2200), sensor.getCurrent());
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, sensor.getCurrent(), sensor.getCurrentSmooth());
+    TEST_ASSERT_EQUAL(50, sensor.getTotalSamples());
+    TEST_ASSERT_EQUAL(900, sensor.getWindowSeconds(2));
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, sensor.getCurrent(), sensor.getWindowMax(0));
+}
+
+void test_static_sensor_rejects_invalid_samples(void) {
+    WCS1800Static<ShuntProfile> sensor;
+    sensor.ingest(2000, 0);
+    float smooth = sensor.getCurrentSmooth();
+
+    sensor.ingest(4095, 10);            // ~+29 A, outside +-20 A
+    TEST_ASSERT_FALSE(sensor.isReadingValid());
+    TEST_ASSERT_EQUAL_FLOAT(smooth, sensor.getCurrentSmooth());
+
+    sensor.ingest(-1, 20);
+    TEST_ASSERT_FALSE(sensor.isReadingValid());
+    TEST_ASSERT_EQUAL(1, sensor.getBadAdcReads());
+    TEST_ASSERT_EQUAL(3, sensor.getTotalSamples());
+}
+
+void test_static_windows_match_runtime_engine(void) {
+    overseer::device::stats::StaticWindowMax<ShuntProfile> fixed;
+    overseer::device::stats::WindowMax runtime;
+    runtime.configure({1, 60, 900}, 1);
+    TEST_ASSERT_EQUAL(runtime.getTickMs(), fixed.TICK_MS);
+
+    for (unsigned long t = 0; t < 120000; t += 37) {
+        float value = (float)((t * 7919) % 2000) / 100.0f - 10.0f;
+        fixed.add(value);
+        runtime.add(0, value);
+        TEST_ASSERT_EQUAL(runtime.advance(t), fixed.advance(t));
+        for (size_t w = 0; w < 3; w++) TEST_ASSERT_EQUAL_FLOAT(runtime.get(0, w), fixed.get(w));
+    }
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+#ifndef ARDUINO
+void test_static_vs_runtime_benchmark(void) {
+    const int iterations = 2000000;
+    volatile float vcc = 3.3f, sens = 66.0f, alpha = 0.1f, spike = 0.3f;   // opaque to the optimizer
+    WCSRuntimeScale runtime;
+    runtime.configure(vcc, 12, sens, vcc / 2.0f, 0.0f, alpha, spike);
+
+    float runtime_smooth = 0.0f, static_smooth = 0.0f;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        runtime_smooth = runtime.smooth(runtime_smooth, runtime.toCurrent(1900 + (i & 255)));
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        static_smooth = DefaultScale::smooth(static_smooth, DefaultScale::toCurrent(1900 + (i & 255)));
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double runtime_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+    double static_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / iterations;
+    char msg[96];
+    snprintf(msg, sizeof(msg), "convert+filter: runtime %.2f ns, constexpr profile %.2f ns", runtime_ns, static_ns);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_FLOAT_WITHIN(1.0e-3f, runtime_smooth, static_smooth);
+}
+#endif
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+void runAllTests(void) {
+    UNITY_BEGIN();
+
+    // Conversion tests
+    RUN_TEST(test_static_matches_reference_formula);
+    RUN_TEST(test_runtime_scale_matches_static);
+    RUN_TEST(test_default_zero_point_is_half_vcc);
+
+    // Sensor tests
+    RUN_TEST(test_static_sensor_update);
+    RUN_TEST(test_static_sensor_rejects_invalid_samples);
+    RUN_TEST(test_static_windows_match_runtime_engine);
+
+    // Performance tests
+#ifndef ARDUINO
+    RUN_TEST(test_static_vs_runtime_benchmark);
+#endif
+
+    UNITY_END();
+}
+
+#ifndef ARDUINO
+int main() {
+    runAllTests();
+    return 0;
+}
+#endif